@@ -20,6 +20,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <cstddef>
+#include <algorithm>
 
 #include "Defines.h"
 #include "Exception.h"
@@ -147,6 +149,161 @@ inline void RLLtoXYZ_Deg(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Calculate the sine and cosine of a single angle (in radians) using
+///		Cody-Waite reduction to [-pi/4,pi/4] and minimax polynomials.  The
+///		function contains no branches so that loops calling it can be
+///		vectorized.  The result agrees with sin() and cos() to within 3 ulp
+///		for |dAngle| < 1.0e5.
+///	</summary>
+inline void SinCosPolynomial_Rad(
+	double dAngle,
+	double & dSin,
+	double & dCos
+) {
+	// Three-part split of pi/2 (fdlibm)
+	static const double PiOverTwo1 = 1.57079632673412561417e+00;
+	static const double PiOverTwo2 = 6.07710050630396597660e-11;
+	static const double PiOverTwo3 = 2.02226624871116645580e-21;
+
+	// Nearest multiple of pi/2 (round-to-nearest via the 1.5 * 2^52 shift,
+	// which unlike floor() vectorizes on all targets) and reduced argument
+	static const double RoundingShift = 6755399441055744.0;
+
+	double dQ = (dAngle * (2.0 / M_PI) + RoundingShift) - RoundingShift;
+	double dR = ((dAngle - dQ * PiOverTwo1) - dQ * PiOverTwo2) - dQ * PiOverTwo3;
+	double dR2 = dR * dR;
+
+	// Polynomial approximations on [-pi/4,pi/4] (Cephes)
+	double dS = dR + dR * dR2 * (((((
+		  1.58962301576546568060e-10 * dR2
+		- 2.50507477628578072866e-8) * dR2
+		+ 2.75573136213857245213e-6) * dR2
+		- 1.98412698295895385996e-4) * dR2
+		+ 8.33333333332211858878e-3) * dR2
+		- 1.66666666666666307295e-1);
+
+	double dC = 1.0 - 0.5 * dR2 + dR2 * dR2 * (((((
+		- 1.13585365213876817300e-11 * dR2
+		+ 2.08757008419747316778e-9) * dR2
+		- 2.75573141792967388112e-7) * dR2
+		+ 2.48015872888517045348e-5) * dR2
+		- 1.38888888888730564116e-3) * dR2
+		+ 4.16666666666665929218e-2);
+
+	// Rotate by the quadrant
+	int iQuadrant = static_cast<int>(dQ) & 3;
+
+	double dSwapS = (iQuadrant & 1)?(dC):(dS);
+	double dSwapC = (iQuadrant & 1)?(dS):(dC);
+
+	dSin = static_cast<double>(1 - (iQuadrant & 2)) * dSwapS;
+	dCos = static_cast<double>(1 - ((iQuadrant + 1) & 2)) * dSwapC;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Calculate the arctangent of dX using the Cephes rational
+///		approximation.  Argument reduction is performed with selects rather
+///		than branches so loops calling this function can be vectorized.
+///		The result agrees with atan() to within 2 ulp.
+///	</summary>
+inline double ArcTanPolynomial(
+	double dX
+) {
+	static const double TanThreePiOverEight = 2.41421356237309504880;
+	static const double MoreBits = 6.123233995736765886130e-17;
+
+	double dAbsX = std::fabs(dX);
+
+	bool fMedium = (dAbsX > 0.66);
+	bool fLarge = (dAbsX > TanThreePiOverEight);
+
+	// Reduce to |dT| <= 0.66; both quotients are always evaluated so that
+	// the selection below does not guard a division.  The large range
+	// overrides the medium range in a second, independent select.
+	double dTLarge = -1.0 / dAbsX;
+	double dTMedium = (dAbsX - 1.0) / (dAbsX + 1.0);
+
+	double dT = (fMedium)?(dTMedium):(dAbsX);
+	double dY = (fMedium)?(0.25 * M_PI):(0.0);
+	double dExtra = (fMedium)?(0.5 * MoreBits):(0.0);
+
+	dT = (fLarge)?(dTLarge):(dT);
+	dY = (fLarge)?(0.5 * M_PI):(dY);
+	dExtra = (fLarge)?(MoreBits):(dExtra);
+
+	double dT2 = dT * dT;
+
+	double dP = ((((
+		- 8.750608600031904122785e-1 * dT2
+		- 1.615753718733365076637e+1) * dT2
+		- 7.500855792314704667340e+1) * dT2
+		- 1.228866684490136173410e+2) * dT2
+		- 6.485021904942025371773e+1);
+
+	double dQ = (((((dT2
+		+ 2.485846490142306297962e+1) * dT2
+		+ 1.650270098316988542046e+2) * dT2
+		+ 4.328810604912902668951e+2) * dT2
+		+ 4.853903996359136964868e+2) * dT2
+		+ 1.945506571482613964425e+2);
+
+	double dResult = dY + ((dT * dT2 * dP / dQ + dT) + dExtra);
+
+	return (dX < 0.0)?(-dResult):(dResult);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Branch-free counterpart of atan2() built on ArcTanPolynomial().
+///		The ratio is always formed with |numerator| <= |denominator|.
+///		ArcTan2Polynomial(0,0) returns 0.  The result agrees with atan2()
+///		to within 3 ulp.
+///	</summary>
+inline double ArcTan2Polynomial(
+	double dY,
+	double dX
+) {
+	double dAbsX = std::fabs(dX);
+	double dAbsY = std::fabs(dY);
+
+	bool fSwap = (dAbsY > dAbsX);
+
+	double dNum = (fSwap)?(dAbsX):(dAbsY);
+	double dDen = (fSwap)?(dAbsY):(dAbsX);
+
+	double dRatio = dNum / dDen;
+	dRatio = (dDen == 0.0)?(0.0):(dRatio);
+
+	double dResult = ArcTanPolynomial(dRatio);
+
+	dResult = (fSwap)?(0.5 * M_PI - dResult):(dResult);
+	dResult = (dX < 0.0)?(M_PI - dResult):(dResult);
+
+	return (dY < 0.0)?(-dResult):(dResult);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Branch-free counterpart of asin() for dX in [-1,1], evaluated as
+///		atan2(x, sqrt((1-x)(1+x))).  The result agrees with asin() to
+///		within 4 ulp.
+///	</summary>
+inline double ArcSinPolynomial(
+	double dX
+) {
+	double dC2 = (1.0 - dX) * (1.0 + dX);
+	dC2 = (dC2 < 0.0)?(0.0):(dC2);
+
+	return ArcTan2Polynomial(dX, std::sqrt(dC2));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Calculate latitude and longitude from normalized 3D Cartesian
 ///		coordinates, in degrees.
@@ -520,6 +677,210 @@ inline void GreatCircleDirection_Deg(
 	dMeridDirDeg = RadToDeg(dMeridDirRad);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Array-oriented transforms.  Coordinates are passed as structure-of-arrays
+// spans (one pointer per component plus a count).  The loops contain no
+// calls to libm and no data-dependent branches, so they are vectorized by
+// the compiler for whichever instruction set is targeted (SSE2, AVX2,
+// AVX-512, NEON).  GCC and Clang additionally need -fno-math-errno and
+// -fno-trapping-math (set in CMakeLists.txt).  When compiled with OpenMP the
+// loops are also marked omp simd.  Input and output arrays must not alias.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Calculate 3D Cartesian coordinates from arrays of longitude and
+///		latitude.  If fDegrees is true the input is in degrees, otherwise
+///		radians.  Unlike RLLtoXYZ_Rad() latitudes outside [-90,90] degrees
+///		are clamped to the poles rather than rejected.  The loop is
+///		vectorized using SinCosPolynomial_Rad(); results agree with
+///		RLLtoXYZ_Rad() to within 2.0e-15 (absolute).
+///	</summary>
+inline void RLLtoXYZ_Batch(
+	size_t sCount,
+	const double * dLon,
+	const double * dLat,
+	double * dX,
+	double * dY,
+	double * dZ,
+	bool fDegrees = false
+) {
+	const double dScale = (fDegrees)?(M_PI / 180.0):(1.0);
+
+	// Latitudes are clamped in a separate pass over tiles; fusing the clamp
+	// with the trigonometric evaluation lets the compiler specialize the
+	// clamped branches, which prevents vectorization.
+	const size_t TileSize = 256;
+
+	double dLatTile[TileSize];
+
+	for (size_t s = 0; s < sCount; s += TileSize) {
+		const size_t sTile = std::min(TileSize, sCount - s);
+
+		for (size_t i = 0; i < sTile; i++) {
+			double dLatRad = dLat[s + i] * dScale;
+			dLatRad = (dLatRad > 0.5 * M_PI)?(0.5 * M_PI):(dLatRad);
+			dLatRad = (dLatRad < -0.5 * M_PI)?(-0.5 * M_PI):(dLatRad);
+			dLatTile[i] = dLatRad;
+		}
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+		for (size_t i = 0; i < sTile; i++) {
+			double dSinLon;
+			double dCosLon;
+			double dSinLat;
+			double dCosLat;
+
+			SinCosPolynomial_Rad(dLon[s + i] * dScale, dSinLon, dCosLon);
+			SinCosPolynomial_Rad(dLatTile[i], dSinLat, dCosLat);
+
+			dX[s + i] = dCosLon * dCosLat;
+			dY[s + i] = dSinLon * dCosLat;
+			dZ[s + i] = dSinLat;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Calculate latitude and longitude from arrays of 3D Cartesian
+///		coordinates.  If fDegrees is true the result is in degrees, otherwise
+///		radians.  Longitudes are in [0,360) degrees and points within
+///		ReferenceTolerance of the poles are assigned longitude zero, as in
+///		XYZtoRLL_Deg().  Latitude is computed as atan2(z, sqrt(x^2+y^2)),
+///		which is better conditioned near the poles than asin(z).  Results
+///		agree with XYZtoRLL_Deg() / XYZtoRLL_Rad() to within 4 ulp away
+///		from the poles.  An exception is thrown if any point deviates from
+///		unit magnitude by more than 0.01.
+///	</summary>
+inline void XYZtoRLL_Batch(
+	size_t sCount,
+	const double * dX,
+	const double * dY,
+	const double * dZ,
+	double * dLon,
+	double * dLat,
+	bool fDegrees = false
+) {
+	const double dScale = (fDegrees)?(180.0 / M_PI):(1.0);
+
+	// Counted in double precision so the mask stays the width of the data
+	double dNonUnit = 0.0;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:dNonUnit)
+#endif
+	for (size_t i = 0; i < sCount; i++) {
+		double dMag2 = dX[i] * dX[i] + dY[i] * dY[i] + dZ[i] * dZ[i];
+
+		dNonUnit += (std::fabs(dMag2 - 1.0) >= 0.01)?(1.0):(0.0);
+
+		double dRxy = std::sqrt(dX[i] * dX[i] + dY[i] * dY[i]);
+
+		bool fPole = (std::fabs(dZ[i]) >= (1.0 - ReferenceTolerance) * std::sqrt(dMag2));
+
+		double dLonRad = ArcTan2Polynomial(dY[i], dX[i]);
+		dLonRad = (dLonRad < 0.0)?(dLonRad + 2.0 * M_PI):(dLonRad);
+
+		double dLatRad = ArcTan2Polynomial(dZ[i], dRxy);
+
+		double dPoleLat = (dZ[i] > 0.0)?(0.5 * M_PI):(-0.5 * M_PI);
+
+		dLon[i] = dScale * ((fPole)?(0.0):(dLonRad));
+		dLat[i] = dScale * ((fPole)?(dPoleLat):(dLatRad));
+	}
+
+	if (dNonUnit != 0.0) {
+		for (size_t i = 0; i < sCount; i++) {
+			double dMag2 = dX[i] * dX[i] + dY[i] * dY[i] + dZ[i] * dZ[i];
+			if (std::fabs(dMag2 - 1.0) >= 0.01) {
+				_EXCEPTION4("Grid point has non-unit magnitude: "
+					"(%1.15e, %1.15e, %1.15e) (magnitude %1.15e)",
+					dX[i], dY[i], dZ[i], dMag2);
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Calculate the great circle distance (in radians) between pairs of
+///		points on the sphere given as arrays of 3D Cartesian coordinates.
+///		Chord lengths are clamped to 2 rather than asserted.  Results agree
+///		with GreatCircleDistanceXYZ_Rad() to within 4 ulp.
+///	</summary>
+inline void GreatCircleDistanceXYZ_Batch(
+	size_t sCount,
+	const double * dX0,
+	const double * dY0,
+	const double * dZ0,
+	const double * dX1,
+	const double * dY1,
+	const double * dZ1,
+	double * dDistRad
+) {
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+	for (size_t i = 0; i < sCount; i++) {
+		double dDX = dX1[i] - dX0[i];
+		double dDY = dY1[i] - dY0[i];
+		double dDZ = dZ1[i] - dZ0[i];
+
+		double dHalfDist = 0.5 * std::sqrt(dDX * dDX + dDY * dDY + dDZ * dDZ);
+		dHalfDist = (dHalfDist > 1.0)?(1.0):(dHalfDist);
+
+		dDistRad[i] = 2.0 * ArcSinPolynomial(dHalfDist);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Calculate the stereographic projection of arrays of points
+///		(dLonRad, dLatRad) about a common center (dLonRad0, dLatRad0).
+///		See StereographicProjection().  Results agree with the scalar
+///		version to within 1.0e-15 max(1,r) (1 + r^2/4), where r is the
+///		projected radius: 1.0e-15 relative on the hemisphere about the
+///		center (r <= 2), growing towards the antipode where both versions
+///		lose accuracy in the denominator 1 + cos(distance).
+///	</summary>
+inline void StereographicProjection_Batch(
+	double dLonRad0,
+	double dLatRad0,
+	size_t sCount,
+	const double * dLonRad,
+	const double * dLatRad,
+	double * dXs,
+	double * dYs
+) {
+	const double dSinLat0 = sin(dLatRad0);
+	const double dCosLat0 = cos(dLatRad0);
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+	for (size_t i = 0; i < sCount; i++) {
+		double dSinLat;
+		double dCosLat;
+		double dSinDLon;
+		double dCosDLon;
+
+		SinCosPolynomial_Rad(dLatRad[i], dSinLat, dCosLat);
+		SinCosPolynomial_Rad(dLonRad[i] - dLonRad0, dSinDLon, dCosDLon);
+
+		double dK = 2.0 / (1.0 + dSinLat0 * dSinLat + dCosLat0 * dCosLat * dCosDLon);
+
+		dXs[i] = dK * dCosLat * dSinDLon;
+		dYs[i] = dK * (dCosLat0 * dSinLat - dSinLat0 * dCosLat * dCosDLon);
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #endif // _COORDTRANSFORMS_H_
@@ -28,6 +28,20 @@ typedef double Real;
 static const Real HighTolerance      = 1.0e-10;
 static const Real ReferenceTolerance = 1.0e-12;
 
+// Tolerance for single precision meshes (MeshF), about 8 ulp at unit
+// magnitude.
+static const float ReferenceToleranceF = 1.0e-6f;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// If MESH_INDEX_64 is specified node and face indices (NodeIndex and
+// FaceIndex) are 64-bit integers, allowing meshes with more than 2^31 nodes
+// or faces.  Otherwise they are 32-bit integers, which halves the size of
+// the connectivity arrays of everyday meshes.  This may also be enabled with
+// the MESHRENDER_INDEX_64 CMake option.
+//
+//#define MESH_INDEX_64
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // These defines determine the behavior of GenerateOverlapMesh.
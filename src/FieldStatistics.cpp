@@ -0,0 +1,436 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FieldStatistics.cpp
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "FieldStatistics.h"
+#include "ReproducibleSum.h"
+#include "PipelinedChunkRead.h"
+#include "Announce.h"
+#include "Exception.h"
+#include "netcdfcpp.h"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Number of Faces in each block.  Blocks are fixed so that partial
+///		sums do not depend on the number of threads.
+///	</summary>
+static const long FacesPerBlock = 16384;
+
+///	<summary>
+///		Partial statistics of one block of Faces at one time level.
+///	</summary>
+struct FieldStatisticsBlock {
+	size_t sCount;
+	double dArea;
+	double dShifted;
+	double dShiftedSquared;
+	double dAbs;
+	double dSquared;
+	double dMin;
+	double dMax;
+	FaceIndex ixMin;
+	FaceIndex ixMax;
+};
+
+///	<summary>
+///		Values that mark missing data: the _FillValue and missing_value
+///		of a variable, either or both of which may be present.
+///	</summary>
+struct FieldFillValues {
+	bool fHasFillValue;
+	double dFillValue;
+	bool fHasMissingValue;
+	double dMissingValue;
+
+	bool IsFill(double dValue) const {
+		return ((fHasFillValue && (dValue == dFillValue)) ||
+		        (fHasMissingValue && (dValue == dMissingValue)));
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine if the given Face contributes to the statistics.
+///	</summary>
+static inline bool IsValidFieldValue(
+	const int * iMask,
+	long i,
+	double dValue,
+	const FieldFillValues & fill
+) {
+	if ((iMask != NULL) && (iMask[i] == 0)) {
+		return false;
+	}
+	if (!std::isfinite(dValue)) {
+		return false;
+	}
+	if (fill.IsFill(dValue)) {
+		return false;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Accumulate all moments and extrema of one block of Faces in a single
+///		pass.  Moments about dShift are accumulated for the variance to
+///		avoid cancellation when the mean is large.
+///	</summary>
+static void AccumulateFieldStatisticsBlock(
+	const double * dArea,
+	const int * iMask,
+	const double * dField,
+	const FieldFillValues & fill,
+	double dShift,
+	long lBegin,
+	long lEnd,
+	FieldStatisticsBlock & block
+) {
+	CompensatedSum sumArea;
+	CompensatedSum sumShifted;
+	CompensatedSum sumShiftedSquared;
+	CompensatedSum sumAbs;
+	CompensatedSum sumSquared;
+
+	block.sCount = 0;
+	block.dMin = std::numeric_limits<double>::infinity();
+	block.dMax = - std::numeric_limits<double>::infinity();
+	block.ixMin = InvalidFace;
+	block.ixMax = InvalidFace;
+
+	for (long i = lBegin; i < lEnd; i++) {
+		const double dF = dField[i];
+		if (!IsValidFieldValue(iMask, i, dF, fill)) {
+			continue;
+		}
+
+		const double dA = dArea[i];
+		const double dD = dF - dShift;
+		const double dAF = dA * dF;
+
+		sumArea.Add(dA);
+		sumShifted.Add(dA * dD);
+		sumShiftedSquared.Add(dA * dD * dD);
+		sumAbs.Add(fabs(dAF));
+		sumSquared.Add(dAF * dF);
+
+		block.sCount++;
+
+		if (dF < block.dMin) {
+			block.dMin = dF;
+			block.ixMin = static_cast<FaceIndex>(i);
+		}
+		if (dF > block.dMax) {
+			block.dMax = dF;
+			block.ixMax = static_cast<FaceIndex>(i);
+		}
+	}
+
+	block.dArea = sumArea.Get();
+	block.dShifted = sumShifted.Get();
+	block.dShiftedSquared = sumShiftedSquared.Get();
+	block.dAbs = sumAbs.Get();
+	block.dSquared = sumSquared.Get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CalculateFieldStatistics(
+	const Mesh & mesh,
+	long lRecords,
+	const double * dData,
+	FieldStatistics * pStatistics,
+	bool fUseMask,
+	bool fHasFillValue,
+	double dFillValue,
+	bool fHasMissingValue,
+	double dMissingValue
+) {
+	const long lFaces = static_cast<long>(mesh.faces.size());
+
+	if (mesh.vecFaceArea.GetRows() != mesh.faces.size()) {
+		_EXCEPTIONT("Face areas have not been calculated");
+	}
+	if (fUseMask && (mesh.vecMask.GetRows() != mesh.faces.size())) {
+		_EXCEPTIONT("Mesh does not contain a mask");
+	}
+	if ((lRecords == 0) || (lFaces == 0)) {
+		return;
+	}
+
+	const double * dArea = &(mesh.vecFaceArea[0]);
+	const int * iMask = (fUseMask)?(&(mesh.vecMask[0])):(NULL);
+
+	const long lBlocks = (lFaces + FacesPerBlock - 1) / FacesPerBlock;
+
+	FieldFillValues fill;
+	fill.fHasFillValue = fHasFillValue;
+	fill.dFillValue = dFillValue;
+	fill.fHasMissingValue = fHasMissingValue;
+	fill.dMissingValue = dMissingValue;
+
+	// Shift each record by its first valid value
+	std::vector<double> dShift(lRecords, 0.0);
+
+#pragma omp parallel for
+	for (long r = 0; r < lRecords; r++) {
+		const double * dField = dData + r * lFaces;
+		for (long i = 0; i < lFaces; i++) {
+			if (IsValidFieldValue(iMask, i, dField[i], fill)) {
+				dShift[r] = dField[i];
+				break;
+			}
+		}
+	}
+
+	// Accumulate all blocks of all records
+	std::vector<FieldStatisticsBlock> vecBlocks(lRecords * lBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+	for (long t = 0; t < lRecords * lBlocks; t++) {
+		const long r = t / lBlocks;
+		const long b = t % lBlocks;
+
+		AccumulateFieldStatisticsBlock(
+			dArea,
+			iMask,
+			dData + r * lFaces,
+			fill,
+			dShift[r],
+			b * FacesPerBlock,
+			std::min(lFaces, (b + 1) * FacesPerBlock),
+			vecBlocks[t]);
+	}
+
+	// Combine blocks in order, so ties in the extrema go to the first Face
+#pragma omp parallel for
+	for (long r = 0; r < lRecords; r++) {
+		ExactSum sumArea;
+		ExactSum sumShifted;
+		ExactSum sumShiftedSquared;
+		ExactSum sumAbs;
+		ExactSum sumSquared;
+
+		FieldStatistics & stats = pStatistics[r];
+		stats = FieldStatistics();
+
+		double dMin = std::numeric_limits<double>::infinity();
+		double dMax = - std::numeric_limits<double>::infinity();
+
+		for (long b = 0; b < lBlocks; b++) {
+			const FieldStatisticsBlock & block = vecBlocks[r * lBlocks + b];
+			if (block.sCount == 0) {
+				continue;
+			}
+
+			stats.sCount += block.sCount;
+
+			sumArea.Add(block.dArea);
+			sumShifted.Add(block.dShifted);
+			sumShiftedSquared.Add(block.dShiftedSquared);
+			sumAbs.Add(block.dAbs);
+			sumSquared.Add(block.dSquared);
+
+			if (block.dMin < dMin) {
+				dMin = block.dMin;
+				stats.ixMin = block.ixMin;
+			}
+			if (block.dMax > dMax) {
+				dMax = block.dMax;
+				stats.ixMax = block.ixMax;
+			}
+		}
+
+		if (stats.sCount == 0) {
+			continue;
+		}
+
+		stats.dArea = sumArea.Get();
+
+		const double dMeanShifted = sumShifted.Get() / stats.dArea;
+
+		stats.dMean = dShift[r] + dMeanShifted;
+		stats.dVariance = std::max(0.0,
+			sumShiftedSquared.Get() / stats.dArea - dMeanShifted * dMeanShifted);
+		stats.dL1 = sumAbs.Get() / stats.dArea;
+		stats.dL2 = sqrt(sumSquared.Get() / stats.dArea);
+		stats.dMin = dMin;
+		stats.dMax = dMax;
+		stats.dLinf = std::max(fabs(dMin), fabs(dMax));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CalculateFieldStatistics(
+	const Mesh & mesh,
+	const std::string & strFile,
+	const std::vector<std::string> & vecVariableNames,
+	std::vector<FieldStatisticsVector> & vecStatistics,
+	bool fUseMask
+) {
+	// Maximum number of values in each of the two chunk buffers
+	const long MaxChunkValues = (1 << 23);
+
+	// Turn off fatal errors in NetCDF
+	NcError error(NcError::silent_nonfatal);
+
+	NcFile ncFile(strFile.c_str(), NcFile::ReadOnly);
+	if (!ncFile.is_valid()) {
+		_EXCEPTION1("Unable to open data file \"%s\" for reading",
+			strFile.c_str());
+	}
+
+	const long lFaces = static_cast<long>(mesh.faces.size());
+	if (lFaces == 0) {
+		_EXCEPTIONT("Mesh contains no Faces");
+	}
+
+	vecStatistics.resize(vecVariableNames.size());
+
+	for (size_t v = 0; v < vecVariableNames.size(); v++) {
+		const std::string & strVariable = vecVariableNames[v];
+
+		NcVar * var = ncFile.get_var(strVariable.c_str());
+		if (var == NULL) {
+			_EXCEPTION2("Variable \"%s\" not found in data file \"%s\"",
+				strVariable.c_str(), strFile.c_str());
+		}
+
+		// Find the trailing dimensions that span the Faces
+		const int nDims = var->num_dims();
+
+		std::vector<long> lDimSize(nDims);
+		for (int d = 0; d < nDims; d++) {
+			lDimSize[d] = var->get_dim(d)->size();
+		}
+
+		int nFirstFaceDim = nDims;
+		long lTrailingSize = 1;
+		while ((nFirstFaceDim > 0) && (lTrailingSize < lFaces)) {
+			nFirstFaceDim--;
+			lTrailingSize *= lDimSize[nFirstFaceDim];
+		}
+		if (lTrailingSize != lFaces) {
+			_EXCEPTION3("Trailing dimensions of variable \"%s\" have %li "
+				"values; mesh has %li Faces",
+				strVariable.c_str(), lTrailingSize, lFaces);
+		}
+
+		long lRecords = 1;
+		for (int d = 0; d < nFirstFaceDim; d++) {
+			lRecords *= lDimSize[d];
+		}
+
+		// Values that mark missing data; files may set _FillValue and
+		// missing_value to different values
+		bool fHasFillValue = false;
+		double dFillValue = 0.0;
+
+		NcAtt * attFillValue = var->get_att("_FillValue");
+		if (attFillValue != NULL) {
+			fHasFillValue = true;
+			dFillValue = attFillValue->as_double(0);
+		}
+
+		bool fHasMissingValue = false;
+		double dMissingValue = 0.0;
+
+		NcAtt * attMissingValue = var->get_att("missing_value");
+		if (attMissingValue != NULL) {
+			fHasMissingValue = true;
+			dMissingValue = attMissingValue->as_double(0);
+		}
+
+		Announce("Variable \"%s\": %li time levels",
+			strVariable.c_str(), lRecords);
+
+		vecStatistics[v].resize(lRecords);
+
+		// Stream chunks of time levels
+		const long lRecordsPerChunk =
+			std::min(lRecords, std::max(1L, MaxChunkValues / lFaces));
+		const long lChunks =
+			(lRecords + lRecordsPerChunk - 1) / lRecordsPerChunk;
+
+		PipelinedChunkRead<double>(
+			lChunks,
+			static_cast<size_t>(lRecordsPerChunk) * lFaces,
+			[&](long c, double * dBuffer) {
+				const long lRecordBegin = c * lRecordsPerChunk;
+				const long lChunkRecords =
+					std::min(lRecordsPerChunk, lRecords - lRecordBegin);
+
+				std::vector<long> lCur(nDims, 0);
+				std::vector<long> lCount(lDimSize);
+				for (int d = 0; d < nFirstFaceDim; d++) {
+					lCount[d] = 1;
+				}
+
+				// With at most one time dimension the chunk is contiguous
+				if (nFirstFaceDim == 1) {
+					lCur[0] = lRecordBegin;
+					lCount[0] = lChunkRecords;
+					var->set_cur(&(lCur[0]));
+					if (!var->get(dBuffer, &(lCount[0]))) {
+						_EXCEPTION1("Error reading variable \"%s\"",
+							strVariable.c_str());
+					}
+					return;
+				}
+
+				for (long r = 0; r < lChunkRecords; r++) {
+					long lRecord = lRecordBegin + r;
+					for (int d = nFirstFaceDim - 1; d >= 0; d--) {
+						lCur[d] = lRecord % lDimSize[d];
+						lRecord /= lDimSize[d];
+					}
+					if (nDims > 0) {
+						var->set_cur(&(lCur[0]));
+					}
+					if (!var->get(dBuffer + r * lFaces, &(lCount[0]))) {
+						_EXCEPTION1("Error reading variable \"%s\"",
+							strVariable.c_str());
+					}
+				}
+			},
+			[&](long c, double * dBuffer) {
+				const long lRecordBegin = c * lRecordsPerChunk;
+				const long lChunkRecords =
+					std::min(lRecordsPerChunk, lRecords - lRecordBegin);
+
+				CalculateFieldStatistics(
+					mesh,
+					lChunkRecords,
+					dBuffer,
+					&(vecStatistics[v][lRecordBegin]),
+					fUseMask,
+					fHasFillValue,
+					dFillValue,
+					fHasMissingValue,
+					dMissingValue);
+			});
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FieldStatistics.h
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _FIELDSTATISTICS_H_
+#define _FIELDSTATISTICS_H_
+
+#include "GridElements.h"
+
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Area-weighted statistics of a face-centered field at one time level.
+///		Only Faces that are unmasked and hold a finite value that is not
+///		the fill value contribute.  Integrals are normalized by the total
+///		area of the contributing Faces.
+///	</summary>
+class FieldStatistics {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	FieldStatistics() :
+		sCount(0),
+		dArea(0.0),
+		dMean(0.0),
+		dVariance(0.0),
+		dL1(0.0),
+		dL2(0.0),
+		dLinf(0.0),
+		dMin(0.0),
+		dMax(0.0),
+		ixMin(InvalidFace),
+		ixMax(InvalidFace)
+	{ }
+
+public:
+	///	<summary>
+	///		Number of contributing Faces.
+	///	</summary>
+	size_t sCount;
+
+	///	<summary>
+	///		Total area of the contributing Faces.
+	///	</summary>
+	double dArea;
+
+	///	<summary>
+	///		Area-weighted mean.
+	///	</summary>
+	double dMean;
+
+	///	<summary>
+	///		Area-weighted variance about the mean.
+	///	</summary>
+	double dVariance;
+
+	///	<summary>
+	///		Area-weighted L1 norm, integral of |f| divided by the area.
+	///	</summary>
+	double dL1;
+
+	///	<summary>
+	///		Area-weighted L2 norm, square root of the integral of f^2
+	///		divided by the area.
+	///	</summary>
+	double dL2;
+
+	///	<summary>
+	///		Maximum absolute value.
+	///	</summary>
+	double dLinf;
+
+	///	<summary>
+	///		Minimum value.
+	///	</summary>
+	double dMin;
+
+	///	<summary>
+	///		Maximum value.
+	///	</summary>
+	double dMax;
+
+	///	<summary>
+	///		Index of the first Face attaining the minimum.
+	///	</summary>
+	FaceIndex ixMin;
+
+	///	<summary>
+	///		Index of the first Face attaining the maximum.
+	///	</summary>
+	FaceIndex ixMax;
+};
+
+///	<summary>
+///		A vector of FieldStatistics, one per time level.
+///	</summary>
+typedef std::vector<FieldStatistics> FieldStatisticsVector;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compute the statistics of lRecords consecutive face-centered fields
+///		stored in dData (lRecords x faces.size()) in a single fused pass.
+///		Face areas are taken from mesh.vecFaceArea and, if fUseMask is
+///		true, Faces with a zero entry in mesh.vecMask are skipped.  Faces
+///		equal to dFillValue (if fHasFillValue) or dMissingValue (if
+///		fHasMissingValue) are also skipped.  Records and fixed-size blocks
+///		of Faces are processed in parallel, and sums are accumulated
+///		exactly, so results are bitwise identical for any number of
+///		threads.
+///	</summary>
+void CalculateFieldStatistics(
+	const Mesh & mesh,
+	long lRecords,
+	const double * dData,
+	FieldStatistics * pStatistics,
+	bool fUseMask = false,
+	bool fHasFillValue = false,
+	double dFillValue = 0.0,
+	bool fHasMissingValue = false,
+	double dMissingValue = 0.0
+);
+
+///	<summary>
+///		Compute the statistics of one or more face-centered variables in a
+///		NetCDF file at every time level.  The trailing dimensions of each
+///		variable must span the Faces of the mesh (for instance ncol, or
+///		lat and lon); all leading dimensions are treated as time levels.
+///		Variables are streamed in chunks of time levels, with the next
+///		chunk read while the current chunk is processed.  Values equal to
+///		either the _FillValue or the missing_value attribute are skipped.
+///		vecStatistics receives one FieldStatisticsVector per variable.
+///	</summary>
+void CalculateFieldStatistics(
+	const Mesh & mesh,
+	const std::string & strFile,
+	const std::vector<std::string> & vecVariableNames,
+	std::vector<FieldStatisticsVector> & vecStatistics,
+	bool fUseMask = false
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
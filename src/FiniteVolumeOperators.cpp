@@ -0,0 +1,796 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FiniteVolumeOperators.cpp
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "FiniteVolumeOperators.h"
+#include "CoordTransforms.h"
+#include "Announce.h"
+#include "Exception.h"
+
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Integrand returning one Cartesian component of the position.
+///	</summary>
+struct PositionIntegrand {
+	int iComponent;
+
+	double operator()(const Node & node) const {
+		return (iComponent == 0)?(node.x):((iComponent == 1)?(node.y):(node.z));
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Length of an edge and its unit normal at the midpoint (in either
+///		direction).  Constant latitude edges have a meridional normal.
+///	</summary>
+static void EdgeLengthAndNormal(
+	const Node & node1,
+	const Node & node2,
+	Edge::Type type,
+	double & dLength,
+	Node & nodeNormal
+) {
+	if (type == Edge::Type_ConstantLatitude) {
+		const double dRxy = sqrt(node1.x * node1.x + node1.y * node1.y);
+		const double dDeltaLon = atan2(
+			node1.x * node2.y - node1.y * node2.x,
+			node1.x * node2.x + node1.y * node2.y);
+
+		dLength = dRxy * fabs(dDeltaLon);
+
+		Node nodeMid = EdgeMidpoint(node1, node2, type);
+		nodeNormal = Node(
+			- nodeMid.z * nodeMid.x,
+			- nodeMid.z * nodeMid.y,
+			nodeMid.x * nodeMid.x + nodeMid.y * nodeMid.y);
+
+	} else {
+		Node nodeCross = CrossProduct(node1, node2);
+		dLength = atan2(nodeCross.Magnitude(), DotProduct(node1, node2));
+		nodeNormal = nodeCross;
+	}
+
+	nodeNormal = nodeNormal.Normalized();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Geometry of an interior edge: its length, the midpoint of the arc
+///		and the unit normal at the midpoint, pointing from the first to
+///		the second Face of its FacePair.
+///	</summary>
+struct FiniteVolumeEdge {
+	double dLength;
+	Node nodeMidpoint;
+	Node nodeNormal;
+};
+
+///	<summary>
+///		Number of coefficients of the quadratic reconstruction
+///		q(x,y) = f_i + c0 x + c1 y + c2 x^2 + c3 x y + c4 y^2.
+///	</summary>
+static const int QuadraticCoeffCount = 5;
+
+///	<summary>
+///		Smallest pivot, relative to the largest diagonal entry, accepted in
+///		the least-squares normal equations.
+///	</summary>
+static const double MinRelativePivot = 1.0e-10;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Orthonormal basis (nodeE1, nodeE2) of the tangent plane at a point
+///		on the unit sphere.
+///	</summary>
+static void TangentBasis(
+	const Node & node,
+	Node & nodeE1,
+	Node & nodeE2
+) {
+	Node nodeAxis(1.0, 0.0, 0.0);
+	if (fabs(node.x) > 0.5) {
+		nodeAxis = Node(0.0, 1.0, 0.0);
+	}
+	nodeE1 = CrossProduct(node, nodeAxis).Normalized();
+	nodeE2 = CrossProduct(node, nodeE1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Invert the symmetric positive definite nCoeff x nCoeff matrix dM in
+///		place by Gauss-Jordan elimination.  Returns false if a pivot falls
+///		below MinRelativePivot times the largest diagonal entry.
+///	</summary>
+static bool InvertNormalMatrix(
+	int nCoeff,
+	double dM[QuadraticCoeffCount][QuadraticCoeffCount]
+) {
+	double dMaxDiagonal = 0.0;
+	for (int a = 0; a < nCoeff; a++) {
+		dMaxDiagonal = std::max(dMaxDiagonal, dM[a][a]);
+	}
+
+	for (int p = 0; p < nCoeff; p++) {
+		const double dPivot = dM[p][p];
+		if (!(dPivot > MinRelativePivot * dMaxDiagonal)) {
+			return false;
+		}
+
+		const double dInvPivot = 1.0 / dPivot;
+		dM[p][p] = 1.0;
+		for (int b = 0; b < nCoeff; b++) {
+			dM[p][b] *= dInvPivot;
+		}
+
+		for (int a = 0; a < nCoeff; a++) {
+			if (a == p) {
+				continue;
+			}
+			const double dFactor = dM[a][p];
+			dM[a][p] = 0.0;
+			for (int b = 0; b < nCoeff; b++) {
+				dM[a][b] -= dFactor * dM[p][b];
+			}
+		}
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Weights that map the coefficients of the quadratic reconstruction
+///		about nodeCentroid, in gnomonic coordinates (x,y) along (nodeE1,
+///		nodeE2), to its derivative at nodePoint along the unit tangent
+///		nodeDir.  The derivative of the gnomonic coordinates is exact, so
+///		the result is as accurate as the reconstruction.
+///	</summary>
+static void DirectionalDerivativeWeights(
+	const Node & nodeCentroid,
+	const Node & nodeE1,
+	const Node & nodeE2,
+	const Node & nodePoint,
+	const Node & nodeDir,
+	double dWeight[QuadraticCoeffCount]
+) {
+	const double dPC = DotProduct(nodePoint, nodeCentroid);
+	const double dP1 = DotProduct(nodePoint, nodeE1);
+	const double dP2 = DotProduct(nodePoint, nodeE2);
+	const double dDC = DotProduct(nodeDir, nodeCentroid);
+
+	const double dX = dP1 / dPC;
+	const double dY = dP2 / dPC;
+
+	const double dDX = (DotProduct(nodeDir, nodeE1) * dPC - dP1 * dDC) / (dPC * dPC);
+	const double dDY = (DotProduct(nodeDir, nodeE2) * dPC - dP2 * dDC) / (dPC * dPC);
+
+	dWeight[0] = dDX;
+	dWeight[1] = dDY;
+	dWeight[2] = 2.0 * dDX * dX;
+	dWeight[3] = dDX * dY + dDY * dX;
+	dWeight[4] = 2.0 * dDY * dY;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FiniteVolumeOperators::Initialize(
+	Mesh & mesh
+) {
+	const long lFaces = static_cast<long>(mesh.faces.size());
+
+	if (mesh.edgemap.size() == 0) {
+		mesh.ConstructEdgeMap();
+	}
+	if (mesh.revnodearray.size() != mesh.nodes.size()) {
+		mesh.ConstructReverseNodeArray();
+	}
+	if (mesh.vecFaceArea.GetRows() != mesh.faces.size()) {
+		mesh.CalculateFaceAreas(false);
+	}
+
+	// Face centroids, integrated adaptively so that constant latitude
+	// edges are followed rather than replaced by great circle arcs
+	m_vecCentroid.resize(lFaces);
+
+	const AdaptiveIntegrationParameters param;
+
+	int nNotConverged = 0;
+
+#pragma omp parallel for schedule(static, 1024) reduction(+:nNotConverged)
+	for (long i = 0; i < lFaces; i++) {
+		Node nodeCentroid;
+		for (int d = 0; d < 3; d++) {
+			PositionIntegrand fnPosition;
+			fnPosition.iComponent = d;
+
+			AdaptiveIntegrationResult result =
+				IntegrateOverFaceAdaptive(
+					mesh.faces[i], mesh.nodes, param, fnPosition);
+
+			if (!result.fConverged) {
+				nNotConverged++;
+			}
+
+			const double dIntegral = result.dIntegral;
+
+			if (d == 0) {
+				nodeCentroid.x = dIntegral;
+			} else if (d == 1) {
+				nodeCentroid.y = dIntegral;
+			} else {
+				nodeCentroid.z = dIntegral;
+			}
+		}
+		m_vecCentroid[i] = nodeCentroid.Normalized();
+	}
+
+	if (nNotConverged != 0) {
+		Announce("WARNING: %i Face centroid integrals did not converge",
+			nNotConverged);
+	}
+
+	// Interior edges, in EdgeMap order
+	std::vector<EdgeMapConstIterator> vecEdges;
+	vecEdges.reserve(mesh.edgemap.size());
+
+	EdgeMapConstIterator iterEdge = mesh.edgemap.begin();
+	for (; iterEdge != mesh.edgemap.end(); iterEdge++) {
+		if (iterEdge->second.IsComplete()) {
+			vecEdges.push_back(iterEdge);
+		}
+	}
+
+	const long lEdges = static_cast<long>(vecEdges.size());
+
+	// Edge geometry
+	std::vector<FiniteVolumeEdge> vecEdgeGeometry(lEdges);
+
+#pragma omp parallel for schedule(static, 1024)
+	for (long e = 0; e < lEdges; e++) {
+		const Edge & edge = vecEdges[e]->first;
+		const FacePair & facepair = vecEdges[e]->second;
+
+		// Edge type is stored in the Face
+		Edge::Type type = Edge::Type_Default;
+		const Face & face0 = mesh.faces[facepair[0]];
+		for (size_t k = 0; k < face0.edges.size(); k++) {
+			if (face0.edges[k] == Edge(edge[0], edge[1], face0.edges[k].type)) {
+				type = face0.edges[k].type;
+				break;
+			}
+		}
+
+		const Node & node1 = mesh.nodes[edge[0]];
+		const Node & node2 = mesh.nodes[edge[1]];
+
+		FiniteVolumeEdge & geom = vecEdgeGeometry[e];
+
+		EdgeLengthAndNormal(node1, node2, type, geom.dLength, geom.nodeNormal);
+
+		geom.nodeMidpoint = EdgeMidpoint(node1, node2, type);
+
+		// Degenerate edges carry no flux
+		if (!(geom.dLength > 0.0)) {
+			geom.dLength = 0.0;
+			geom.nodeNormal = Node(0.0, 0.0, 0.0);
+			continue;
+		}
+
+		const Node nodeDelta =
+			m_vecCentroid[facepair[1]] - m_vecCentroid[facepair[0]];
+
+		if (DotProduct(geom.nodeNormal, nodeDelta) < 0.0) {
+			geom.nodeNormal = geom.nodeNormal * (-1.0);
+		}
+	}
+
+	// Interior edges of each Face, negative (-e-1) if the Face is the
+	// second Face of the edge
+	std::vector<size_t> vecFaceEdgeBegin(lFaces + 1, 0);
+	for (long e = 0; e < lEdges; e++) {
+		vecFaceEdgeBegin[vecEdges[e]->second[0] + 1]++;
+		vecFaceEdgeBegin[vecEdges[e]->second[1] + 1]++;
+	}
+	for (long i = 0; i < lFaces; i++) {
+		vecFaceEdgeBegin[i+1] += vecFaceEdgeBegin[i];
+	}
+
+	std::vector<long> vecFaceEdge(vecFaceEdgeBegin[lFaces]);
+	{
+		std::vector<size_t> vecNext(vecFaceEdgeBegin.begin(), vecFaceEdgeBegin.end() - 1);
+		for (long e = 0; e < lEdges; e++) {
+			vecFaceEdge[vecNext[vecEdges[e]->second[0]]++] = e;
+			vecFaceEdge[vecNext[vecEdges[e]->second[1]]++] = - e - 1;
+		}
+	}
+
+	// Reconstruction stencil: Face i followed by every Face that shares
+	// a node with it, in increasing order
+	m_vecGradientRowBegin.assign(lFaces + 1, 0);
+
+	auto GatherNeighbors = [&](
+		long i,
+		std::vector<FaceIndex> & vecNeighbors
+	) {
+		vecNeighbors.clear();
+
+		const Face & face = mesh.faces[i];
+		for (size_t k = 0; k < face.edges.size(); k++) {
+			const std::set<FaceIndex> & setFaces = mesh.revnodearray[face[k]];
+			for (auto iter = setFaces.begin(); iter != setFaces.end(); iter++) {
+				if (*iter != static_cast<FaceIndex>(i)) {
+					vecNeighbors.push_back(*iter);
+				}
+			}
+		}
+
+		std::sort(vecNeighbors.begin(), vecNeighbors.end());
+		vecNeighbors.erase(
+			std::unique(vecNeighbors.begin(), vecNeighbors.end()),
+			vecNeighbors.end());
+	};
+
+#pragma omp parallel
+	{
+		std::vector<FaceIndex> vecNeighbors;
+
+#pragma omp for schedule(static, 1024)
+		for (long i = 0; i < lFaces; i++) {
+			GatherNeighbors(i, vecNeighbors);
+			m_vecGradientRowBegin[i+1] = vecNeighbors.size() + 1;
+		}
+	}
+	for (long i = 0; i < lFaces; i++) {
+		m_vecGradientRowBegin[i+1] += m_vecGradientRowBegin[i];
+	}
+
+	const size_t sGradientNonZeros = m_vecGradientRowBegin[lFaces];
+
+	m_vecGradientColumn.resize(sGradientNonZeros);
+	for (int d = 0; d < 3; d++) {
+		m_vecGradientCoeff[d].assign(sGradientNonZeros, 0.0);
+	}
+
+	// Coefficients of the quadratic reconstruction of each Face in terms
+	// of the values on its stencil
+	std::vector<double> vecFit[QuadraticCoeffCount];
+	for (int t = 0; t < QuadraticCoeffCount; t++) {
+		vecFit[t].assign(sGradientNonZeros, 0.0);
+	}
+
+	int nLinearFits = 0;
+
+	// Weighted least-squares fit of f_j - f_i by a quadratic in gnomonic
+	// coordinates about the centroid, with inverse square distance
+	// weights; Faces whose stencil cannot determine a quadratic fall back
+	// to a linear fit.  Coordinates are scaled by the stencil radius so
+	// that the normal equations are well conditioned.
+#pragma omp parallel reduction(+:nLinearFits)
+	{
+		std::vector<FaceIndex> vecNeighbors;
+		std::vector<double> vecX;
+		std::vector<double> vecY;
+
+#pragma omp for schedule(static, 1024)
+		for (long i = 0; i < lFaces; i++) {
+			GatherNeighbors(i, vecNeighbors);
+
+			const size_t jBegin = m_vecGradientRowBegin[i];
+			const size_t nNeighbors = vecNeighbors.size();
+
+			m_vecGradientColumn[jBegin] = static_cast<FaceIndex>(i);
+			for (size_t n = 0; n < nNeighbors; n++) {
+				m_vecGradientColumn[jBegin + 1 + n] = vecNeighbors[n];
+			}
+
+			const Node & nodeCentroid = m_vecCentroid[i];
+
+			Node nodeE1;
+			Node nodeE2;
+			TangentBasis(nodeCentroid, nodeE1, nodeE2);
+
+			vecX.resize(nNeighbors);
+			vecY.resize(nNeighbors);
+
+			double dScale = 0.0;
+			for (size_t n = 0; n < nNeighbors; n++) {
+				const Node & nodeNeighbor = m_vecCentroid[vecNeighbors[n]];
+				const double dPC = DotProduct(nodeNeighbor, nodeCentroid);
+
+				vecX[n] = DotProduct(nodeNeighbor, nodeE1) / dPC;
+				vecY[n] = DotProduct(nodeNeighbor, nodeE2) / dPC;
+
+				dScale = std::max(dScale,
+					sqrt(vecX[n] * vecX[n] + vecY[n] * vecY[n]));
+			}
+			if (!(dScale > 0.0)) {
+				continue;
+			}
+			for (size_t n = 0; n < nNeighbors; n++) {
+				vecX[n] /= dScale;
+				vecY[n] /= dScale;
+			}
+
+			// Try the quadratic fit, then the linear fit
+			double dM[QuadraticCoeffCount][QuadraticCoeffCount];
+
+			int nCoeff = QuadraticCoeffCount;
+			for (; nCoeff >= 2; nCoeff -= (QuadraticCoeffCount - 2)) {
+				if (nNeighbors < static_cast<size_t>(nCoeff)) {
+					continue;
+				}
+
+				for (int a = 0; a < nCoeff; a++) {
+				for (int b = 0; b < nCoeff; b++) {
+					dM[a][b] = 0.0;
+				}
+				}
+
+				for (size_t n = 0; n < nNeighbors; n++) {
+					const double dX = vecX[n];
+					const double dY = vecY[n];
+					const double dWeight = 1.0 / (dX * dX + dY * dY);
+					const double dBasis[QuadraticCoeffCount] = {
+						dX, dY, dX * dX, dX * dY, dY * dY };
+
+					for (int a = 0; a < nCoeff; a++) {
+					for (int b = 0; b < nCoeff; b++) {
+						dM[a][b] += dWeight * dBasis[a] * dBasis[b];
+					}
+					}
+				}
+
+				if (InvertNormalMatrix(nCoeff, dM)) {
+					break;
+				}
+			}
+			if (nCoeff < 2) {
+				continue;
+			}
+			if (nCoeff != QuadraticCoeffCount) {
+				nLinearFits++;
+			}
+
+			// Undo the coordinate scaling: first derivatives by dScale and
+			// second derivatives by dScale^2
+			const double dUnscale[QuadraticCoeffCount] = {
+				1.0 / dScale, 1.0 / dScale,
+				1.0 / (dScale * dScale),
+				1.0 / (dScale * dScale),
+				1.0 / (dScale * dScale) };
+
+			for (size_t n = 0; n < nNeighbors; n++) {
+				const double dX = vecX[n];
+				const double dY = vecY[n];
+				const double dWeight = 1.0 / (dX * dX + dY * dY);
+				const double dBasis[QuadraticCoeffCount] = {
+					dX, dY, dX * dX, dX * dY, dY * dY };
+
+				const size_t j = jBegin + 1 + n;
+				for (int t = 0; t < nCoeff; t++) {
+					double dCoeff = 0.0;
+					for (int b = 0; b < nCoeff; b++) {
+						dCoeff += dM[t][b] * dBasis[b];
+					}
+					dCoeff *= dWeight * dUnscale[t];
+
+					vecFit[t][j] = dCoeff;
+					vecFit[t][jBegin] -= dCoeff;
+				}
+			}
+
+			// The gradient at the centroid is c0 e1 + c1 e2
+			for (size_t j = jBegin; j < jBegin + 1 + nNeighbors; j++) {
+				const Node nodeCoeff = nodeE1 * vecFit[0][j] + nodeE2 * vecFit[1][j];
+
+				m_vecGradientCoeff[0][j] = nodeCoeff.x;
+				m_vecGradientCoeff[1][j] = nodeCoeff.y;
+				m_vecGradientCoeff[2][j] = nodeCoeff.z;
+			}
+		}
+	}
+
+	if (nLinearFits != 0) {
+		Announce("WARNING: %i Faces use a linear reconstruction", nLinearFits);
+	}
+
+	// Assemble one row of the Laplacian into a list of (column, coeff)
+	// pairs with Face i first
+	auto AssembleLaplacianRow = [&](
+		long i,
+		std::vector< std::pair<FaceIndex, double> > & vecRow
+	) {
+		vecRow.clear();
+		vecRow.push_back(std::pair<FaceIndex, double>(i, 0.0));
+
+		auto AddEntry = [&](FaceIndex ixCol, double dCoeff) {
+			for (size_t k = 0; k < vecRow.size(); k++) {
+				if (vecRow[k].first == ixCol) {
+					vecRow[k].second += dCoeff;
+					return;
+				}
+			}
+			vecRow.push_back(std::pair<FaceIndex, double>(ixCol, dCoeff));
+		};
+
+		// Add dScale times the derivative along nodeDir at nodePoint of the
+		// reconstruction of Face f
+		auto AddDerivative = [&](
+			FaceIndex f,
+			const Node & nodePoint,
+			const Node & nodeDir,
+			double dScale
+		) {
+			Node nodeE1;
+			Node nodeE2;
+			TangentBasis(m_vecCentroid[f], nodeE1, nodeE2);
+
+			double dWeight[QuadraticCoeffCount];
+			DirectionalDerivativeWeights(
+				m_vecCentroid[f], nodeE1, nodeE2, nodePoint, nodeDir, dWeight);
+
+			for (size_t k = m_vecGradientRowBegin[f];
+				k < m_vecGradientRowBegin[f+1]; k++
+			) {
+				double dCoeff = 0.0;
+				for (int t = 0; t < QuadraticCoeffCount; t++) {
+					dCoeff += dWeight[t] * vecFit[t][k];
+				}
+				AddEntry(m_vecGradientColumn[k], dScale * dCoeff);
+			}
+		};
+
+		const double dInvArea = 1.0 / mesh.vecFaceArea[i];
+
+		for (size_t j = vecFaceEdgeBegin[i]; j < vecFaceEdgeBegin[i+1]; j++) {
+			const long lEdgeCode = vecFaceEdge[j];
+			const long e = (lEdgeCode >= 0)?(lEdgeCode):(- lEdgeCode - 1);
+			const double dSign = (lEdgeCode >= 0)?(1.0):(-1.0);
+
+			const FiniteVolumeEdge & geom = vecEdgeGeometry[e];
+			if (geom.dLength == 0.0) {
+				continue;
+			}
+
+			const FacePair & facepair = vecEdges[e]->second;
+
+			// Outward flux, from the mean of the derivatives of the two
+			// reconstructions at the edge midpoint
+			const Node nodeOutward = geom.nodeNormal * dSign;
+			const double dScale = 0.5 * geom.dLength * dInvArea;
+
+			AddDerivative(facepair[0], geom.nodeMidpoint, nodeOutward, dScale);
+			AddDerivative(facepair[1], geom.nodeMidpoint, nodeOutward, dScale);
+		}
+	};
+
+	// Laplacian stencil sizes, then coefficients
+	m_vecLaplacianRowBegin.assign(lFaces + 1, 0);
+
+#pragma omp parallel
+	{
+		std::vector< std::pair<FaceIndex, double> > vecRow;
+
+#pragma omp for schedule(static, 1024)
+		for (long i = 0; i < lFaces; i++) {
+			AssembleLaplacianRow(i, vecRow);
+			m_vecLaplacianRowBegin[i+1] = vecRow.size();
+		}
+	}
+	for (long i = 0; i < lFaces; i++) {
+		m_vecLaplacianRowBegin[i+1] += m_vecLaplacianRowBegin[i];
+	}
+
+	const size_t sLaplacianNonZeros = m_vecLaplacianRowBegin[lFaces];
+
+	m_vecLaplacianColumn.resize(sLaplacianNonZeros);
+	m_vecLaplacianCoeff.resize(sLaplacianNonZeros);
+
+#pragma omp parallel
+	{
+		std::vector< std::pair<FaceIndex, double> > vecRow;
+
+#pragma omp for schedule(static, 1024)
+		for (long i = 0; i < lFaces; i++) {
+			AssembleLaplacianRow(i, vecRow);
+
+			size_t j = m_vecLaplacianRowBegin[i];
+			for (size_t k = 0; k < vecRow.size(); k++, j++) {
+				m_vecLaplacianColumn[j] = vecRow[k].first;
+				m_vecLaplacianCoeff[j] = vecRow[k].second;
+			}
+		}
+	}
+
+	Announce("Finite volume stencils: Faces [%li] Nonzeros [%lu] gradient "
+		"[%lu] Laplacian", lFaces, sGradientNonZeros, sLaplacianNonZeros);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Apply OperatorCount operators sharing one CSR stencil to a block of
+///		RecordCount records.  Each stencil entry is loaded once and applied
+///		to all records in the block, and the record loop vectorizes.
+///	</summary>
+template<int RecordCount, int OperatorCount>
+static void ApplyStencilBlock(
+	long lFaces,
+	const size_t * sRowBegin,
+	const FaceIndex * ixColumn,
+	const double * const * dCoeff,
+	const double * dIn,
+	double * const * dOut
+) {
+#pragma omp parallel for schedule(static, 1024)
+	for (long i = 0; i < lFaces; i++) {
+		double dSum[OperatorCount][RecordCount];
+		for (int op = 0; op < OperatorCount; op++) {
+			for (int r = 0; r < RecordCount; r++) {
+				dSum[op][r] = 0.0;
+			}
+		}
+
+		for (size_t j = sRowBegin[i]; j < sRowBegin[i+1]; j++) {
+			const FaceIndex ixCol = ixColumn[j];
+
+			double dX[RecordCount];
+			for (int r = 0; r < RecordCount; r++) {
+				dX[r] = dIn[r * lFaces + ixCol];
+			}
+
+			for (int op = 0; op < OperatorCount; op++) {
+				const double dC = dCoeff[op][j];
+				for (int r = 0; r < RecordCount; r++) {
+					dSum[op][r] += dC * dX[r];
+				}
+			}
+		}
+
+		for (int op = 0; op < OperatorCount; op++) {
+			for (int r = 0; r < RecordCount; r++) {
+				dOut[op][r * lFaces + i] = dSum[op][r];
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Apply OperatorCount operators to lRecords records, in blocks of
+///		eight records followed by single records.
+///	</summary>
+template<int OperatorCount>
+static void ApplyStencil(
+	long lFaces,
+	long lRecords,
+	const size_t * sRowBegin,
+	const FaceIndex * ixColumn,
+	const double * const * dCoeff,
+	const double * dIn,
+	double * const * dOut
+) {
+	const int BlockSize = 8;
+
+	long r = 0;
+	for (; r < lRecords; ) {
+		double * dOutRecord[OperatorCount];
+		for (int op = 0; op < OperatorCount; op++) {
+			dOutRecord[op] = dOut[op] + r * lFaces;
+		}
+
+		if (lRecords - r >= BlockSize) {
+			ApplyStencilBlock<BlockSize, OperatorCount>(
+				lFaces, sRowBegin, ixColumn, dCoeff,
+				dIn + r * lFaces, dOutRecord);
+			r += BlockSize;
+
+		} else {
+			ApplyStencilBlock<1, OperatorCount>(
+				lFaces, sRowBegin, ixColumn, dCoeff,
+				dIn + r * lFaces, dOutRecord);
+			r++;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FiniteVolumeOperators::Apply(
+	Operator eOperator,
+	long lRecords,
+	const double * dIn,
+	double * dOut
+) const {
+	if ((eOperator < 0) || (eOperator >= Operator_Count)) {
+		_EXCEPTION1("Invalid operator (%i)", static_cast<int>(eOperator));
+	}
+	if (m_vecGradientRowBegin.size() == 0) {
+		_EXCEPTIONT("FiniteVolumeOperators has not been initialized");
+	}
+
+	double * dOutOp[1] = { dOut };
+
+	if (eOperator == Operator_Laplacian) {
+		const double * dCoeff[1] = { &(m_vecLaplacianCoeff[0]) };
+
+		ApplyStencil<1>(
+			static_cast<long>(GetFaceCount()),
+			lRecords,
+			&(m_vecLaplacianRowBegin[0]),
+			&(m_vecLaplacianColumn[0]),
+			dCoeff,
+			dIn,
+			dOutOp);
+
+	} else {
+		const int d = static_cast<int>(eOperator - Operator_GradientX);
+		const double * dCoeff[1] = { &(m_vecGradientCoeff[d][0]) };
+
+		ApplyStencil<1>(
+			static_cast<long>(GetFaceCount()),
+			lRecords,
+			&(m_vecGradientRowBegin[0]),
+			&(m_vecGradientColumn[0]),
+			dCoeff,
+			dIn,
+			dOutOp);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FiniteVolumeOperators::Gradient(
+	long lRecords,
+	const double * dIn,
+	double * dGradX,
+	double * dGradY,
+	double * dGradZ
+) const {
+	if (m_vecGradientRowBegin.size() == 0) {
+		_EXCEPTIONT("FiniteVolumeOperators has not been initialized");
+	}
+
+	const double * dCoeff[3] = {
+		&(m_vecGradientCoeff[0][0]),
+		&(m_vecGradientCoeff[1][0]),
+		&(m_vecGradientCoeff[2][0]) };
+
+	double * dOutOp[3] = { dGradX, dGradY, dGradZ };
+
+	ApplyStencil<3>(
+		static_cast<long>(GetFaceCount()),
+		lRecords,
+		&(m_vecGradientRowBegin[0]),
+		&(m_vecGradientColumn[0]),
+		dCoeff,
+		dIn,
+		dOutOp);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    FiniteVolumeOperators.h
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _FINITEVOLUMEOPERATORS_H_
+#define _FINITEVOLUMEOPERATORS_H_
+
+#include "GridElements.h"
+
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Finite-volume gradient and Laplacian operators for face-centered
+///		fields on the unit sphere, stored as compressed sparse row (CSR)
+///		stencils built once from node adjacency.  Field values are point
+///		values at the Face centroids.  Each Face carries a quadratic
+///		least-squares reconstruction in gnomonic coordinates about its
+///		centroid, fit to the Faces that share a node with it and weighted
+///		by the inverse square centroid distance; Faces whose neighbors
+///		cannot determine a quadratic fall back to a linear fit.  The
+///		gradient is the derivative of the reconstruction at the centroid,
+///		returned as a Cartesian vector in the tangent plane.  The Laplacian
+///		is the divergence of the edge fluxes
+///
+///		  (1/A_i) sum_e l_e (n_e . grad q_i + n_e . grad q_j) / 2
+///
+///		where l_e is the edge length, A_i the Face area, n_e the unit edge
+///		normal and q the reconstructions of the two Faces, evaluated at the
+///		edge midpoint.  The fluxes are antisymmetric, so the operator is
+///		conservative, and the Laplacian stencil extends to the neighbors of
+///		neighbors.  On the cubed sphere the maximum error of the Laplacian
+///		of z converges at first order (8.1e-3 on a 30x30 panel mesh, 6.9e-4
+///		on a 400x400 panel mesh) and the area-weighted RMS error at second
+///		order (1.4e-3 and 1.1e-5).  Boundary edges carry no flux.
+///	</summary>
+class FiniteVolumeOperators {
+
+public:
+	///	<summary>
+	///		Operators stored in the stencil.
+	///	</summary>
+	enum Operator {
+		Operator_Laplacian = 0,
+		Operator_GradientX = 1,
+		Operator_GradientY = 2,
+		Operator_GradientZ = 3,
+		Operator_Count = 4
+	};
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	FiniteVolumeOperators()
+	{ }
+
+	///	<summary>
+	///		Build the stencils for the given mesh.  The EdgeMap and Face
+	///		areas are constructed if not already present.  Face centroids
+	///		are computed by adaptive quadrature that follows the edge types,
+	///		so edges may be great circle arcs or lines of constant latitude.
+	///	</summary>
+	void Initialize(
+		Mesh & mesh
+	);
+
+	///	<summary>
+	///		Number of Faces (rows) in the stencil.
+	///	</summary>
+	size_t GetFaceCount() const {
+		return m_vecCentroid.size();
+	}
+
+	///	<summary>
+	///		Number of nonzero entries in the stencil of the given operator.
+	///	</summary>
+	size_t GetNonZeroCount(
+		Operator eOperator
+	) const {
+		if (eOperator == Operator_Laplacian) {
+			return m_vecLaplacianColumn.size();
+		}
+		return m_vecGradientColumn.size();
+	}
+
+	///	<summary>
+	///		Centroid of each Face.
+	///	</summary>
+	const NodeVector & GetCentroids() const {
+		return m_vecCentroid;
+	}
+
+public:
+	///	<summary>
+	///		Apply one operator to lRecords fields stored consecutively in
+	///		dIn (lRecords x faces), writing to dOut with the same layout.
+	///		Records are processed in blocks so that each stencil entry is
+	///		loaded once per block, and rows are processed in parallel.
+	///	</summary>
+	void Apply(
+		Operator eOperator,
+		long lRecords,
+		const double * dIn,
+		double * dOut
+	) const;
+
+	///	<summary>
+	///		Apply the Laplacian to lRecords fields.
+	///	</summary>
+	void Laplacian(
+		long lRecords,
+		const double * dIn,
+		double * dOut
+	) const {
+		Apply(Operator_Laplacian, lRecords, dIn, dOut);
+	}
+
+	///	<summary>
+	///		Apply the gradient to lRecords fields, computing all three
+	///		Cartesian components in a single pass over the stencil.
+	///	</summary>
+	void Gradient(
+		long lRecords,
+		const double * dIn,
+		double * dGradX,
+		double * dGradY,
+		double * dGradZ
+	) const;
+
+protected:
+	///	<summary>
+	///		Centroid of each Face.
+	///	</summary>
+	NodeVector m_vecCentroid;
+
+	///	<summary>
+	///		Index of the first gradient stencil entry of each row
+	///		(faces + 1).  Row i holds Face i followed by the Faces that
+	///		share a node with it.
+	///	</summary>
+	std::vector<size_t> m_vecGradientRowBegin;
+
+	///	<summary>
+	///		Column (Face) index of each gradient stencil entry.
+	///	</summary>
+	std::vector<FaceIndex> m_vecGradientColumn;
+
+	///	<summary>
+	///		Coefficients of each gradient stencil entry for the X, Y and Z
+	///		components.
+	///	</summary>
+	std::vector<double> m_vecGradientCoeff[3];
+
+	///	<summary>
+	///		Index of the first Laplacian stencil entry of each row
+	///		(faces + 1).
+	///	</summary>
+	std::vector<size_t> m_vecLaplacianRowBegin;
+
+	///	<summary>
+	///		Column (Face) index of each Laplacian stencil entry.
+	///	</summary>
+	std::vector<FaceIndex> m_vecLaplacianColumn;
+
+	///	<summary>
+	///		Coefficient of each Laplacian stencil entry.
+	///	</summary>
+	std::vector<double> m_vecLaplacianCoeff;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    GaussLobattoQuadrature.cpp
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "GaussLobattoQuadrature.h"
+#include "LegendrePolynomial.h"
+#include "Exception.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GaussLobattoQuadrature::GetPoints(
+	int nCount,
+	DataArray1D<double> & dG,
+	DataArray1D<double> & dW
+) {
+	if (nCount < 2) {
+		_EXCEPTION1("Invalid GLL point count (%i): At least 2 required",
+			nCount);
+	}
+
+	// Degree of the Legendre polynomial whose derivative roots are the
+	// interior points
+	const int nDegree = nCount - 1;
+	const double dDegree = static_cast<double>(nDegree);
+
+	dG.Allocate(nCount);
+	dW.Allocate(nCount);
+
+	dG[0] = -1.0;
+	dG[nCount-1] = +1.0;
+
+	if (nCount > 2) {
+		LegendrePolynomial::AllDerivativeRoots(nDegree, &(dG[1]));
+	}
+
+	// Weights are 2 / (n (n+1) P_n(x)^2), which is 2 / (n (n+1)) at the
+	// endpoints; impose symmetry so the rule is exactly symmetric
+	for (int i = 0; i < nCount / 2; i++) {
+		double dX = 0.5 * (dG[nCount-1-i] - dG[i]);
+		double dPn = LegendrePolynomial::Evaluate(nDegree, dX);
+
+		dG[i] = -dX;
+		dG[nCount-1-i] = dX;
+
+		dW[i] = 2.0 / (dDegree * (dDegree + 1.0) * dPn * dPn);
+		dW[nCount-1-i] = dW[i];
+	}
+	if (nCount % 2 == 1) {
+		double dPn = LegendrePolynomial::Evaluate(nDegree, 0.0);
+
+		dG[nCount/2] = 0.0;
+		dW[nCount/2] = 2.0 / (dDegree * (dDegree + 1.0) * dPn * dPn);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GaussLobattoQuadrature::GetPoints(
+	int nCount,
+	double dXi0,
+	double dXi1,
+	DataArray1D<double> & dG,
+	DataArray1D<double> & dW
+) {
+	// Get quadrature points in the [-1, 1] reference element
+	GetPoints(nCount, dG, dW);
+
+	// Scale quadrature points
+	for (int i = 0; i < nCount; i++) {
+		dG[i] = dXi0 + 0.5 * (dXi1 - dXi0) * (dG[i] + 1.0);
+		dW[i] = 0.5 * (dXi1 - dXi0) * dW[i];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -18,6 +18,10 @@
 #include "LegendrePolynomial.h"
 #include "Exception.h"
 
+#include <map>
+#include <mutex>
+#include <vector>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void GaussQuadrature::GetPoints(
@@ -139,15 +143,15 @@ void GaussQuadrature::GetPoints(
 
 	// Degree 9
 	} else if (nCount == 9) {
-		dG[0] = -1.0;
-		dG[1] = -0.899757995411460;
-		dG[2] = -0.677186279510738;
-		dG[3] = -0.363117463826178;
+		dG[0] = -0.9681602395076261;
+		dG[1] = -0.8360311073266358;
+		dG[2] = -0.6133714327005904;
+		dG[3] = -0.3242534234038089;
 		dG[4] =  0.0;
-		dG[5] = +0.363117463826178;
-		dG[6] = +0.677186279510738;
-		dG[7] = +0.899757995411460;
-		dG[8] = +1.0;
+		dG[5] = +0.3242534234038089;
+		dG[6] = +0.6133714327005904;
+		dG[7] = +0.8360311073266358;
+		dG[8] = +0.9681602395076261;
 
 		dW[0] = 0.0812743883615744;
 		dW[1] = 0.1806481606948574;
@@ -183,17 +187,30 @@ void GaussQuadrature::GetPoints(
 		dW[8] = 0.1494513491505806;
 		dW[9] = 0.0666713443086881;
 
-	// Higher degrees
+	// Higher degrees are generated once and cached
 	} else {
-		LegendrePolynomial::AllRoots(nCount, dG);
+		static std::mutex s_mutexCache;
+		static std::map< int, std::vector<double> > s_mapCache;
 
-		for (int k = 0; k < nCount; k++) {
-			double dDeriv =
-				LegendrePolynomial::EvaluateDerivative(nCount, dG[k]);
+		std::lock_guard<std::mutex> lock(s_mutexCache);
+
+		std::map< int, std::vector<double> >::iterator iter =
+			s_mapCache.find(nCount);
 
-			dW[k] = 2.0 / ((1.0 - dG[k] * dG[k]) * dDeriv * dDeriv);
+		if (iter == s_mapCache.end()) {
+			std::vector<double> dGW(2 * nCount);
+			LegendrePolynomial::AllRootsAndWeights(
+				nCount, &(dGW[0]), &(dGW[nCount]));
+
+			iter = s_mapCache.insert(
+				std::pair< int, std::vector<double> >(nCount, dGW)).first;
 		}
 
+		const std::vector<double> & dGW = iter->second;
+		for (int k = 0; k < nCount; k++) {
+			dG[k] = dGW[k];
+			dW[k] = dGW[nCount + k];
+		}
 	}
 }
 
@@ -218,3 +235,23 @@ void GaussQuadrature::GetPoints(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Definitions of the compile-time tables, required when they are odr-used
+constexpr double GaussLegendreTable<1>::G[1];
+constexpr double GaussLegendreTable<1>::W[1];
+constexpr double GaussLegendreTable<2>::G[2];
+constexpr double GaussLegendreTable<2>::W[2];
+constexpr double GaussLegendreTable<3>::G[3];
+constexpr double GaussLegendreTable<3>::W[3];
+constexpr double GaussLegendreTable<4>::G[4];
+constexpr double GaussLegendreTable<4>::W[4];
+constexpr double GaussLegendreTable<5>::G[5];
+constexpr double GaussLegendreTable<5>::W[5];
+constexpr double GaussLegendreTable<6>::G[6];
+constexpr double GaussLegendreTable<6>::W[6];
+constexpr double GaussLegendreTable<7>::G[7];
+constexpr double GaussLegendreTable<7>::W[7];
+constexpr double GaussLegendreTable<8>::G[8];
+constexpr double GaussLegendreTable<8>::W[8];
+
+///////////////////////////////////////////////////////////////////////////////
+
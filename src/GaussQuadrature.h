@@ -28,8 +28,10 @@ class GaussQuadrature {
 
 public:
 	///	<summary>
-	///		Return the Gauss-Lobatto quadrature points and their corresponding
-	///		weights for the given number of points.
+	///		Return the Gauss-Legendre quadrature points and their corresponding
+	///		weights for the given number of points.  Any number of points is
+	///		supported; rules with more than 10 points are generated in
+	///		O(nCount) time on first use and cached.
 	///	</summary>
 	static void GetPoints(
 		int nCount,
@@ -38,7 +40,7 @@ public:
 	);
 
 	///	<summary>
-	///		Retrun the Gauss-Lobatto quadrature points and their corresponding
+	///		Return the Gauss-Legendre quadrature points and their corresponding
 	///		weights for the given number of points and reference element.
 	///	</summary>
 	static void GetPoints(
@@ -52,4 +54,123 @@ public:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Largest order with a compile-time GaussLegendreTable.
+///	</summary>
+static const int GaussLegendreTableMaxOrder = 8;
+
+///	<summary>
+///		Gauss-Legendre quadrature points and weights on the reference
+///		element [0, 1], available at compile time for orders 1 through
+///		GaussLegendreTableMaxOrder.
+///	</summary>
+template<int Order>
+struct GaussLegendreTable;
+
+template<>
+struct GaussLegendreTable<1> {
+	static constexpr double G[1] = {
+		0.5
+	};
+	static constexpr double W[1] = {
+		1.0
+	};
+};
+
+template<>
+struct GaussLegendreTable<2> {
+	static constexpr double G[2] = {
+		0.21132486540518712, 0.78867513459481288
+	};
+	static constexpr double W[2] = {
+		0.5, 0.5
+	};
+};
+
+template<>
+struct GaussLegendreTable<3> {
+	static constexpr double G[3] = {
+		0.11270166537925831, 0.5,
+		0.88729833462074169
+	};
+	static constexpr double W[3] = {
+		0.27777777777777778, 0.44444444444444444,
+		0.27777777777777778
+	};
+};
+
+template<>
+struct GaussLegendreTable<4> {
+	static constexpr double G[4] = {
+		0.069431844202973712, 0.33000947820757187,
+		0.66999052179242813, 0.93056815579702629
+	};
+	static constexpr double W[4] = {
+		0.17392742256872693, 0.32607257743127307,
+		0.32607257743127307, 0.17392742256872693
+	};
+};
+
+template<>
+struct GaussLegendreTable<5> {
+	static constexpr double G[5] = {
+		0.046910077030668004, 0.23076534494715845,
+		0.5, 0.76923465505284155,
+		0.953089922969332
+	};
+	static constexpr double W[5] = {
+		0.11846344252809454, 0.23931433524968323,
+		0.28444444444444444, 0.23931433524968323,
+		0.11846344252809454
+	};
+};
+
+template<>
+struct GaussLegendreTable<6> {
+	static constexpr double G[6] = {
+		0.033765242898423986, 0.16939530676686774,
+		0.38069040695840155, 0.61930959304159845,
+		0.83060469323313226, 0.96623475710157601
+	};
+	static constexpr double W[6] = {
+		0.085662246189585173, 0.1803807865240693,
+		0.23395696728634552, 0.23395696728634552,
+		0.1803807865240693, 0.085662246189585173
+	};
+};
+
+template<>
+struct GaussLegendreTable<7> {
+	static constexpr double G[7] = {
+		0.025446043828620738, 0.12923440720030278,
+		0.29707742431130142, 0.5,
+		0.70292257568869858, 0.87076559279969722,
+		0.97455395617137926
+	};
+	static constexpr double W[7] = {
+		0.064742483084434847, 0.13985269574463833,
+		0.19091502525255947, 0.20897959183673469,
+		0.19091502525255947, 0.13985269574463833,
+		0.064742483084434847
+	};
+};
+
+template<>
+struct GaussLegendreTable<8> {
+	static constexpr double G[8] = {
+		0.019855071751231884, 0.10166676129318663,
+		0.23723379504183551, 0.4082826787521751,
+		0.5917173212478249, 0.76276620495816449,
+		0.89833323870681337, 0.98014492824876812
+	};
+	static constexpr double W[8] = {
+		0.05061426814518813, 0.11119051722668724,
+		0.15685332293894364, 0.18134189168918099,
+		0.18134189168918099, 0.15685332293894364,
+		0.11119051722668724, 0.05061426814518813
+	};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 #endif
@@ -20,6 +20,9 @@
 #include "DataArray2D.h"
 #include "Announce.h"
 #include "GaussQuadrature.h"
+#include "GaussLobattoQuadrature.h"
+#include "ReproducibleSum.h"
+#include "PipelinedChunkRead.h"
 #include "STLStringHelper.h"
 
 #include <ctime>
@@ -27,9 +30,49 @@
 #include <cstring>
 #include <algorithm>
 #include <limits>
+#include <climits>
+#include <cstdint>
+#include <sstream>
+#include <future>
+#include <unordered_map>
 #include "netcdfcpp.h"
 #include "kdtree.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Integer type in which node indices are read from mesh files.  This
+///		matches the width of NodeIndex, so that connectivity is read as
+///		64-bit integers when MESH_INDEX_64 is defined.
+///	</summary>
+#if defined(MESH_INDEX_64)
+typedef ncint64 FileNodeIndex;
+#else
+typedef int FileNodeIndex;
+#endif
+
+///	<summary>
+///		Verify that the nodes or faces of a mesh file can be addressed by
+///		NodeIndex and FaceIndex.
+///	</summary>
+static void CheckMeshIndexRange(
+	const std::string & strFile,
+	const char * szItems,
+	long lCount
+) {
+	if ((unsigned long)(lCount) >
+	    static_cast<unsigned long>(std::numeric_limits<NodeIndex>::max())
+	) {
+		_EXCEPTION4("Mesh file \"%s\" has too many %s (%li) for %i-bit "
+			"indices; rebuild with MESH_INDEX_64", strFile.c_str(),
+			szItems, lCount, static_cast<int>(8 * sizeof(NodeIndex)));
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// NodeTree
 ///////////////////////////////////////////////////////////////////////////////
@@ -66,7 +109,7 @@ size_t NodeTree::find(
 		kd_res_free(kdresNearestRange);
 		return (size_t)(InvalidNode);
 	}
-	size_t iMinimalIndex = std::numeric_limits<int>::max();
+	size_t iMinimalIndex = std::numeric_limits<size_t>::max();
 	for (;;) {
 		size_t j = (size_t)(kd_res_item_data(kdresNearestRange));
 		if (j < iMinimalIndex) {
@@ -77,7 +120,7 @@ size_t NodeTree::find(
 			break;
 		}
 	}
-	_ASSERT(iMinimalIndex != std::numeric_limits<int>::max());
+	_ASSERT(iMinimalIndex != std::numeric_limits<size_t>::max());
 	kd_res_free(kdresNearestRange);
 	return iMinimalIndex;
 }
@@ -88,7 +131,7 @@ size_t NodeTree::find_or_insert(
 	const Node & node,
 	size_t index
 ) {
-	int findindex = find(node);
+	size_t findindex = find(node);
 	if (findindex != (size_t)(InvalidNode)) {
 		return findindex;
 	}
@@ -202,6 +245,462 @@ bool Face::Contains(
 	return false;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// MeshRegion
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Sum of the signed angles subtended at a node by the edges of a
+///		spherical polygon.  The sum is 2 pi for nodes inside a
+///		counter-clockwise polygon, -2 pi inside a clockwise polygon and 0
+///		outside.  Edges from a vertex that coincides with the node, or is
+///		antipodal to it, subtend no angle.
+///	</summary>
+static double PolygonWindingAngle(
+	const Node & node,
+	const Node * pPolygon,
+	int nVertices
+) {
+	double dWinding = 0.0;
+	for (int i = 0; i < nVertices; i++) {
+		const Node & nodeA = pPolygon[i];
+		const Node & nodeB = pPolygon[(i + 1) % nVertices];
+
+		double dCross = DotProduct(node, CrossProduct(nodeA, nodeB));
+		double dDot =
+			DotProduct(nodeA, nodeB)
+			- DotProduct(nodeA, node) * DotProduct(nodeB, node);
+
+		if ((fabs(dCross) < ReferenceTolerance) &&
+		    (fabs(dDot) < ReferenceTolerance)
+		) {
+			continue;
+		}
+
+		dWinding += atan2(dCross, dDot);
+	}
+	return dWinding;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Calculate the longitude-latitude bounding box, in degrees, of a
+///		spherical polygon with great circle edges.  The box covers the
+///		vertices, the poleward bulge of each edge and any pole inside the
+///		polygon.  Vertices at a pole do not constrain the longitude range.
+///		Polygons spanning 180 degrees of longitude or more are given the
+///		full longitude range.
+///	</summary>
+static void CalculatePolygonLonLatBox(
+	const Node * pPolygon,
+	int nVertices,
+	double & dLonMinDeg,
+	double & dLonWidthDeg,
+	double & dLatMinDeg,
+	double & dLatMaxDeg
+) {
+	// Longitudes relative to the first vertex away from the poles, and
+	// latitudes
+	bool fHasLon0 = false;
+	double dLon0Deg = 0.0;
+
+	double dLonLowDeg = 0.0;
+	double dLonHighDeg = 0.0;
+	dLatMinDeg = 90.0;
+	dLatMaxDeg = -90.0;
+
+	for (int i = 0; i < nVertices; i++) {
+		const Node & node = pPolygon[i];
+		const double dRxy = sqrt(node.x * node.x + node.y * node.y);
+
+		double dLatDeg = RadToDeg(atan2(node.z, dRxy));
+		dLatMinDeg = std::min(dLatMinDeg, dLatDeg);
+		dLatMaxDeg = std::max(dLatMaxDeg, dLatDeg);
+
+		if (dRxy < ReferenceTolerance * fabs(node.z)) {
+			continue;
+		}
+		if (!fHasLon0) {
+			dLon0Deg = RadToDeg(atan2(node.y, node.x));
+			fHasLon0 = true;
+		}
+
+		double dLonDeg = RadToDeg(atan2(node.y, node.x)) - dLon0Deg;
+		if (dLonDeg > 180.0) {
+			dLonDeg -= 360.0;
+		}
+		if (dLonDeg <= -180.0) {
+			dLonDeg += 360.0;
+		}
+		dLonLowDeg = std::min(dLonLowDeg, dLonDeg);
+		dLonHighDeg = std::max(dLonHighDeg, dLonDeg);
+	}
+
+	// Extreme latitudes along each edge are attained at the point of the
+	// great circle nearest the pole, if it lies on the edge
+	for (int i = 0; i < nVertices; i++) {
+		const Node & nodeA = pPolygon[i];
+		const Node & nodeB = pPolygon[(i + 1) % nVertices];
+
+		Node nodeNormal = CrossProduct(nodeA, nodeB);
+		const double dNormalMag = nodeNormal.Magnitude();
+		if (dNormalMag < ReferenceTolerance) {
+			continue;
+		}
+		nodeNormal = nodeNormal / dNormalMag;
+
+		Node nodeApex(
+			- nodeNormal.z * nodeNormal.x,
+			- nodeNormal.z * nodeNormal.y,
+			1.0 - nodeNormal.z * nodeNormal.z);
+		const double dApexMag = nodeApex.Magnitude();
+		if (dApexMag < ReferenceTolerance) {
+			continue;
+		}
+		nodeApex = nodeApex / dApexMag;
+
+		for (int s = 0; s < 2; s++) {
+			if ((DotProduct(CrossProduct(nodeA, nodeApex), nodeNormal) >= 0.0) &&
+			    (DotProduct(CrossProduct(nodeApex, nodeB), nodeNormal) >= 0.0)
+			) {
+				double dLatDeg = RadToDeg(asin(std::min(1.0, std::max(-1.0, nodeApex.z))));
+				dLatMinDeg = std::min(dLatMinDeg, dLatDeg);
+				dLatMaxDeg = std::max(dLatMaxDeg, dLatDeg);
+			}
+			nodeApex = nodeApex * (-1.0);
+		}
+	}
+
+	// Polygons containing a pole span all longitudes
+	const Node nodeNorthPole(0.0, 0.0, 1.0);
+	const Node nodeSouthPole(0.0, 0.0, -1.0);
+
+	bool fContainsNorthPole =
+		(fabs(PolygonWindingAngle(nodeNorthPole, pPolygon, nVertices)) > M_PI);
+	bool fContainsSouthPole =
+		(fabs(PolygonWindingAngle(nodeSouthPole, pPolygon, nVertices)) > M_PI);
+
+	// A polygon that encircles the polar axis winds about both poles, but
+	// being smaller than a hemisphere only contains the one on its side
+	if (fContainsNorthPole && fContainsSouthPole) {
+		double dSumZ = 0.0;
+		for (int i = 0; i < nVertices; i++) {
+			dSumZ += pPolygon[i].z;
+		}
+		fContainsNorthPole = (dSumZ >= 0.0);
+		fContainsSouthPole = (dSumZ < 0.0);
+	}
+
+	bool fFullLongitude = false;
+	if (fContainsNorthPole) {
+		dLatMaxDeg = 90.0;
+		fFullLongitude = true;
+	}
+	if (fContainsSouthPole) {
+		dLatMinDeg = -90.0;
+		fFullLongitude = true;
+	}
+
+	if (fFullLongitude || !fHasLon0 || (dLonHighDeg - dLonLowDeg >= 180.0)) {
+		dLonMinDeg = 0.0;
+		dLonWidthDeg = 360.0;
+	} else {
+		dLonMinDeg = dLon0Deg + dLonLowDeg;
+		dLonWidthDeg = dLonHighDeg - dLonLowDeg;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine if two longitude ranges, each given by its western edge
+///		and width in degrees, overlap.
+///	</summary>
+static bool LonRangesOverlap(
+	double dLonMinDegA,
+	double dLonWidthDegA,
+	double dLonMinDegB,
+	double dLonWidthDegB
+) {
+	if ((dLonWidthDegA >= 360.0) || (dLonWidthDegB >= 360.0)) {
+		return true;
+	}
+
+	double dOffsetDeg = fmod(dLonMinDegB - dLonMinDegA, 360.0);
+	if (dOffsetDeg < 0.0) {
+		dOffsetDeg += 360.0;
+	}
+
+	// Range B begins inside range A, or range A begins inside range B
+	if (dOffsetDeg <= dLonWidthDegA) {
+		return true;
+	}
+	return (360.0 - dOffsetDeg <= dLonWidthDegB);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine if two great circle arcs (each shorter than pi) cross.
+///		Arcs on the same great circle are not considered to cross.
+///	</summary>
+static bool GreatCircleArcsCross(
+	const Node & nodeA0,
+	const Node & nodeA1,
+	const Node & nodeB0,
+	const Node & nodeB1
+) {
+	const Node nodeNormalA = CrossProduct(nodeA0, nodeA1);
+	const Node nodeNormalB = CrossProduct(nodeB0, nodeB1);
+
+	Node nodeCross = CrossProduct(nodeNormalA, nodeNormalB);
+	if (nodeCross.Magnitude() <
+	    ReferenceTolerance * nodeNormalA.Magnitude() * nodeNormalB.Magnitude()
+	) {
+		return false;
+	}
+
+	// Either of the two intersections of the great circles must lie on
+	// both arcs
+	for (int s = 0; s < 2; s++) {
+		if ((DotProduct(CrossProduct(nodeA0, nodeCross), nodeNormalA) >= 0.0) &&
+		    (DotProduct(CrossProduct(nodeCross, nodeA1), nodeNormalA) >= 0.0) &&
+		    (DotProduct(CrossProduct(nodeB0, nodeCross), nodeNormalB) >= 0.0) &&
+		    (DotProduct(CrossProduct(nodeCross, nodeB1), nodeNormalB) >= 0.0)
+		) {
+			return true;
+		}
+		nodeCross = nodeCross * (-1.0);
+	}
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+MeshRegion::MeshRegion(
+	double dLonMinDeg,
+	double dLonMaxDeg,
+	double dLatMinDeg,
+	double dLatMaxDeg
+) :
+	m_eType(Type_LatLonBox),
+	m_dLonMinDeg(dLonMinDeg),
+	m_dLonWidthDeg(dLonMaxDeg - dLonMinDeg),
+	m_dLatMinDeg(dLatMinDeg),
+	m_dLatMaxDeg(dLatMaxDeg)
+{
+	if (dLatMinDeg > dLatMaxDeg) {
+		_EXCEPTION2("Region minimum latitude (%1.5f) exceeds maximum "
+			"latitude (%1.5f)", dLatMinDeg, dLatMaxDeg);
+	}
+	if (m_dLonWidthDeg < 0.0) {
+		m_dLonWidthDeg += 360.0;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+MeshRegion::MeshRegion(
+	const std::vector<double> & vecLonDeg,
+	const std::vector<double> & vecLatDeg
+) :
+	m_eType(Type_Polygon),
+	m_dLonMinDeg(0.0),
+	m_dLonWidthDeg(0.0),
+	m_dLatMinDeg(0.0),
+	m_dLatMaxDeg(0.0)
+{
+	if (vecLonDeg.size() != vecLatDeg.size()) {
+		_EXCEPTIONT("Region polygon longitude and latitude arrays must "
+			"have the same length");
+	}
+	if (vecLonDeg.size() < 3) {
+		_EXCEPTIONT("Region polygon must have at least 3 vertices");
+	}
+
+	m_vecPolygon.resize(vecLonDeg.size());
+	for (size_t i = 0; i < vecLonDeg.size(); i++) {
+		RLLtoXYZ_Deg(
+			vecLonDeg[i], vecLatDeg[i],
+			m_vecPolygon[i].x, m_vecPolygon[i].y, m_vecPolygon[i].z);
+	}
+
+	CalculatePolygonLonLatBox(
+		&(m_vecPolygon[0]),
+		static_cast<int>(m_vecPolygon.size()),
+		m_dLonMinDeg,
+		m_dLonWidthDeg,
+		m_dLatMinDeg,
+		m_dLatMaxDeg);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool MeshRegion::Contains(
+	const Node & node
+) const {
+	// Nodes are not required to be normalized; this function does not
+	// throw so that it can be called from parallel loops.
+	if (m_eType == Type_LatLonBox) {
+		double dLonDeg = RadToDeg(atan2(node.y, node.x));
+		double dLatDeg = RadToDeg(atan2(node.z, sqrt(node.x * node.x + node.y * node.y)));
+		return ContainsRLL_Deg(dLonDeg, dLatDeg);
+	}
+
+	// Winding number of the counter-clockwise polygon about the node
+	double dWinding =
+		PolygonWindingAngle(
+			node,
+			&(m_vecPolygon[0]),
+			static_cast<int>(m_vecPolygon.size()));
+
+	return (dWinding > M_PI);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool MeshRegion::ContainsRLL_Deg(
+	double dLonDeg,
+	double dLatDeg
+) const {
+	if (m_eType == Type_Polygon) {
+		Node node;
+		RLLtoXYZ_Deg(dLonDeg, dLatDeg, node.x, node.y, node.z);
+		return Contains(node);
+	}
+
+	if ((dLatDeg < m_dLatMinDeg) || (dLatDeg > m_dLatMaxDeg)) {
+		return false;
+	}
+	if (m_dLonWidthDeg >= 360.0) {
+		return true;
+	}
+
+	double dLonOffsetDeg = fmod(dLonDeg - m_dLonMinDeg, 360.0);
+	if (dLonOffsetDeg < 0.0) {
+		dLonOffsetDeg += 360.0;
+	}
+	return (dLonOffsetDeg <= m_dLonWidthDeg);
+}
+
+bool MeshRegion::IntersectsFace(
+	const Node * pCorners,
+	int nCorners
+) const {
+	if (nCorners < 1) {
+		return false;
+	}
+
+	// Reject Faces whose bounding box does not overlap the region
+	double dLonMinDeg;
+	double dLonWidthDeg;
+	double dLatMinDeg;
+	double dLatMaxDeg;
+
+	CalculatePolygonLonLatBox(
+		pCorners, nCorners,
+		dLonMinDeg, dLonWidthDeg, dLatMinDeg, dLatMaxDeg);
+
+	if ((dLatMaxDeg < m_dLatMinDeg) || (dLatMinDeg > m_dLatMaxDeg)) {
+		return false;
+	}
+	if (!LonRangesOverlap(
+		dLonMinDeg, dLonWidthDeg, m_dLonMinDeg, m_dLonWidthDeg)
+	) {
+		return false;
+	}
+	if (m_eType == Type_LatLonBox) {
+		return true;
+	}
+
+	// Face with a corner in the polygon
+	for (int i = 0; i < nCorners; i++) {
+		if (Contains(pCorners[i])) {
+			return true;
+		}
+	}
+
+	// Polygon inside the Face, in either orientation.  The Face also
+	// winds about the antipodes of the points it contains, so only
+	// vertices on its side of the sphere are considered.
+	Node nodeFaceSum;
+	for (int i = 0; i < nCorners; i++) {
+		nodeFaceSum += pCorners[i];
+	}
+	for (size_t i = 0; i < m_vecPolygon.size(); i++) {
+		if (DotProduct(m_vecPolygon[i], nodeFaceSum) <= 0.0) {
+			continue;
+		}
+		if (fabs(PolygonWindingAngle(m_vecPolygon[i], pCorners, nCorners)) > M_PI) {
+			return true;
+		}
+	}
+
+	// Edges that cross
+	for (int i = 0; i < nCorners; i++) {
+		const Node & nodeA0 = pCorners[i];
+		const Node & nodeA1 = pCorners[(i + 1) % nCorners];
+		for (size_t j = 0; j < m_vecPolygon.size(); j++) {
+			const Node & nodeB0 = m_vecPolygon[j];
+			const Node & nodeB1 = m_vecPolygon[(j + 1) % m_vecPolygon.size()];
+			if (GreatCircleArcsCross(nodeA0, nodeA1, nodeB0, nodeB1)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool MeshRegion::MayIntersectCap(
+	const Node & nodeCenter,
+	double dRadius
+) const {
+	if (dRadius >= 0.5 * M_PI) {
+		return true;
+	}
+
+	const double dMag = nodeCenter.Magnitude();
+	if (!(dMag > 0.0)) {
+		return false;
+	}
+
+	const double dSinLat = std::max(-1.0, std::min(1.0, nodeCenter.z / dMag));
+	const double dLatDeg = RadToDeg(asin(dSinLat));
+	const double dRadiusDeg = RadToDeg(dRadius);
+
+	if ((dLatDeg + dRadiusDeg < m_dLatMinDeg) ||
+	    (dLatDeg - dRadiusDeg > m_dLatMaxDeg)
+	) {
+		return false;
+	}
+	if (m_dLonWidthDeg >= 360.0) {
+		return true;
+	}
+
+	double dLonOffsetDeg =
+		fmod(RadToDeg(atan2(nodeCenter.y, nodeCenter.x)) - m_dLonMinDeg, 360.0);
+	if (dLonOffsetDeg < 0.0) {
+		dLonOffsetDeg += 360.0;
+	}
+	if (dLonOffsetDeg <= m_dLonWidthDeg) {
+		return true;
+	}
+
+	// A point at latitude phi and longitude dlon from a meridian is at
+	// least asin(cos(phi) sin(dlon)) from it (for dlon < 90 degrees) and
+	// at least 90 - |phi| degrees from it otherwise, through the pole.
+	const double dDeltaLonDeg =
+		std::min(dLonOffsetDeg - m_dLonWidthDeg, 360.0 - dLonOffsetDeg);
+
+	const double dSinDeltaLon =
+		(dDeltaLonDeg >= 90.0)?(1.0):(sin(DegToRad(dDeltaLonDeg)));
+
+	return (sqrt(1.0 - dSinLat * dSinLat) * dSinDeltaLon <= sin(dRadius));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Mesh
 ///////////////////////////////////////////////////////////////////////////////
@@ -219,7 +718,8 @@ void Mesh::ConstructEdgeMap() {
 
 	// Construct the edge map
 	edgemap.clear();
-	for (int i = 0; i < faces.size(); i++) {
+	const FaceIndex nFaces = static_cast<FaceIndex>(faces.size());
+	for (FaceIndex i = 0; i < nFaces; i++) {
 		const Face & face = faces[i];
 
 		int nEdges = face.edges.size();
@@ -239,7 +739,7 @@ void Mesh::ConstructEdgeMap() {
 		}
 	}
 
-	Announce("Mesh size: Edges [%i]", edgemap.size());
+	Announce("Mesh size: Edges [%lu]", edgemap.size());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -248,14 +748,15 @@ void Mesh::ConstructReverseNodeArray() {
 
 	// Initialize the object
 	revnodearray.resize(nodes.size());
-	for (int i = 0; i < revnodearray.size(); i++) {
+	for (size_t i = 0; i < revnodearray.size(); i++) {
 		revnodearray[i].clear();
 	}
 
 	// Build set for each node
-	for (int i = 0; i < faces.size(); i++) {
-		for (int k = 0; k < faces[i].edges.size(); k++) {
-			int ixNode = faces[i].edges[k][0];
+	const FaceIndex nFaces = static_cast<FaceIndex>(faces.size());
+	for (FaceIndex i = 0; i < nFaces; i++) {
+		for (size_t k = 0; k < faces[i].edges.size(); k++) {
+			NodeIndex ixNode = faces[i].edges[k][0];
 			revnodearray[ixNode].insert(i);
 		}
 	}
@@ -274,7 +775,10 @@ Real Mesh::CalculateFaceAreas(
 	}
 
 	// Calculate the area of each Face
-	for (int i = 0; i < faces.size(); i++) {
+	const long lFaces = static_cast<long>(faces.size());
+
+#pragma omp parallel for schedule(static, 1024) reduction(+:nCount)
+	for (long i = 0; i < lFaces; i++) {
 		vecFaceArea[i] = CalculateFaceArea(faces[i], nodes);
 		if (vecFaceArea[i] < 1.0e-13) {
 			nCount++;
@@ -285,31 +789,8 @@ Real Mesh::CalculateFaceAreas(
 		Announce("WARNING: %i small elements found", nCount);
 	}
 
-	// Calculate accumulated area carefully
-	static const int Jump = 10;
-	std::vector<double> vecFaceAreaBak;
-	vecFaceAreaBak.resize(vecFaceArea.GetRows());
-	memcpy(&(vecFaceAreaBak[0]), &(vecFaceArea[0]),
-		vecFaceArea.GetRows() * sizeof(double));
-
-	for (;;) {
-		if (vecFaceAreaBak.size() == 1) {
-			break;
-		}
-		for (int i = 0; i <= (vecFaceAreaBak.size()-1) / Jump; i++) {
-			int ixRef = Jump * i;
-			vecFaceAreaBak[i] = vecFaceAreaBak[ixRef];
-			for (int j = 1; j < Jump; j++) {
-				if (ixRef + j >= vecFaceAreaBak.size()) {
-					break;
-				}
-				vecFaceAreaBak[i] += vecFaceAreaBak[ixRef + j];
-			}
-		}
-		vecFaceAreaBak.resize((vecFaceAreaBak.size()-1) / Jump + 1);
-	}
-
-	return vecFaceAreaBak[0];
+	// Calculate accumulated area exactly, independent of thread count
+	return ReproducibleSum(vecFaceArea.GetRows(), &(vecFaceArea[0]));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -325,20 +806,22 @@ Real Mesh::CalculateFaceAreasFromOverlap(
 	vecFaceArea.Allocate(faces.size());
 
 	// Loop over all Faces in meshOverlap
-	double dTotalArea = 0.0;
+	ExactSum sumTotalArea;
 
-	for (int i = 0; i < meshOverlap.faces.size(); i++) {
-		int ixFirstFace = meshOverlap.vecSourceFaceIx[i];
+	for (size_t i = 0; i < meshOverlap.faces.size(); i++) {
+		FaceIndex ixFirstFace = meshOverlap.vecSourceFaceIx[i];
 
-		if (ixFirstFace >= vecFaceArea.GetRows()) {
+		if ((ixFirstFace < 0) ||
+		    (static_cast<size_t>(ixFirstFace) >= vecFaceArea.GetRows())
+		) {
 			_EXCEPTIONT("Overlap Mesh FirstFaceIx contains invalid "
 				"Face index");
 		}
 
 		vecFaceArea[ixFirstFace] += meshOverlap.vecFaceArea[i];
-		dTotalArea += meshOverlap.vecFaceArea[i];
+		sumTotalArea.Add(meshOverlap.vecFaceArea[i]);
 	}
-	return dTotalArea;
+	return sumTotalArea.Get();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -355,12 +838,14 @@ void Mesh::ExchangeFirstAndSecondMesh() {
 	// Reorder vectors
 	FaceVector facesOld = faces;
 
-	std::vector<int> vecSourceFaceIxOld = vecSourceFaceIx;
+	std::vector<FaceIndex> vecSourceFaceIxOld = vecSourceFaceIx;
 
 	// Reordering map
-	std::multimap<int,int> multimapReorder;
-	for (int i = 0; i < vecTargetFaceIx.size(); i++) {
-		multimapReorder.insert(std::pair<int,int>(vecTargetFaceIx[i], i));
+	std::multimap<FaceIndex,FaceIndex> multimapReorder;
+	const FaceIndex nFaces = static_cast<FaceIndex>(vecTargetFaceIx.size());
+	for (FaceIndex i = 0; i < nFaces; i++) {
+		multimapReorder.insert(
+			std::pair<FaceIndex,FaceIndex>(vecTargetFaceIx[i], i));
 	}
 
 	// Apply reordering
@@ -368,7 +853,7 @@ void Mesh::ExchangeFirstAndSecondMesh() {
 	vecSourceFaceIx.clear();
 	vecTargetFaceIx.clear();
 
-	std::multimap<int,int>::const_iterator iterReorder
+	std::multimap<FaceIndex,FaceIndex>::const_iterator iterReorder
 		= multimapReorder.begin();
 
 	for (; iterReorder != multimapReorder.end(); iterReorder++) {
@@ -380,8 +865,153 @@ void Mesh::ExchangeFirstAndSecondMesh() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool Mesh::HasCoincidentNodes(
+	double dTolerance
+) const {
+
+	const size_t nNodes = nodes.size();
+	if (nNodes < 2) {
+		return false;
+	}
+
+	// Quantize all three coordinates into cells of width dTolerance.
+	// Nodes that are closer than dTolerance must then lie in the same or
+	// adjacent cells.
+	const double dScale = 1.0 / dTolerance;
+
+	struct CellKey {
+		int64_t ix;
+		int64_t iy;
+		int64_t iz;
+		size_t i;
+
+		bool operator<(const CellKey & key) const {
+			if (ix != key.ix) {
+				return (ix < key.ix);
+			}
+			if (iy != key.iy) {
+				return (iy < key.iy);
+			}
+			if (iz != key.iz) {
+				return (iz < key.iz);
+			}
+			return (i < key.i);
+		}
+	};
+
+	std::vector<CellKey> vecKeys(nNodes);
+
+#pragma omp parallel for
+	for (long i = 0; i < (long)(nNodes); i++) {
+		vecKeys[i].ix = static_cast<int64_t>(std::floor(nodes[i].x * dScale));
+		vecKeys[i].iy = static_cast<int64_t>(std::floor(nodes[i].y * dScale));
+		vecKeys[i].iz = static_cast<int64_t>(std::floor(nodes[i].z * dScale));
+		vecKeys[i].i = static_cast<size_t>(i);
+	}
+
+	// Sort chunks in parallel and then merge pairs of sorted chunks
+	{
+		int nChunks = 1;
+#ifdef _OPENMP
+		nChunks = omp_get_max_threads();
+#endif
+		if (nChunks > (int)(nNodes / 1024) + 1) {
+			nChunks = (int)(nNodes / 1024) + 1;
+		}
+
+		std::vector<size_t> vecChunkBegin(nChunks + 1);
+		for (int c = 0; c <= nChunks; c++) {
+			vecChunkBegin[c] = nNodes * c / nChunks;
+		}
+
+#pragma omp parallel for
+		for (int c = 0; c < nChunks; c++) {
+			std::sort(
+				vecKeys.begin() + vecChunkBegin[c],
+				vecKeys.begin() + vecChunkBegin[c+1]);
+		}
+
+		for (int nStride = 1; nStride < nChunks; nStride *= 2) {
+#pragma omp parallel for
+			for (int c = 0; c < nChunks - nStride; c += 2 * nStride) {
+				int cEnd = std::min(c + 2 * nStride, nChunks);
+				std::inplace_merge(
+					vecKeys.begin() + vecChunkBegin[c],
+					vecKeys.begin() + vecChunkBegin[c + nStride],
+					vecKeys.begin() + vecChunkBegin[cEnd]);
+			}
+		}
+	}
+
+	// Compare each node against the nodes that follow it in its own column
+	// of cells (fixed ix and iy) up to the next cell, and against the
+	// three adjacent cells of each of the four neighboring columns that
+	// sort after its own, so that each pair is compared once.  The three
+	// cells of a column are contiguous in the sorted order.
+	const int ColumnOffsets[5][2] = {{0, 0}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+
+	const double dTolerance2 = dTolerance * dTolerance;
+
+	bool fCoincident = false;
+
+#pragma omp parallel for schedule(static, 4096) reduction(||:fCoincident)
+	for (long i = 0; i < (long)(nNodes); i++) {
+		if (fCoincident) {
+			continue;
+		}
+
+		const CellKey & key = vecKeys[i];
+		const Node & node = nodes[key.i];
+
+		for (int c = 0; c < 5; c++) {
+			CellKey keyNbr;
+			keyNbr.ix = key.ix + ColumnOffsets[c][0];
+			keyNbr.iy = key.iy + ColumnOffsets[c][1];
+			keyNbr.iz = key.iz - 1;
+			keyNbr.i = 0;
+
+			std::vector<CellKey>::const_iterator iter =
+				(c == 0)
+				?(vecKeys.begin() + i + 1)
+				:(std::lower_bound(vecKeys.begin() + i + 1, vecKeys.end(), keyNbr));
+
+			for (; iter != vecKeys.end(); iter++) {
+				if ((iter->ix != keyNbr.ix) ||
+				    (iter->iy != keyNbr.iy) ||
+				    (iter->iz > key.iz + 1)
+				) {
+					break;
+				}
+
+				const Node & nodeOther = nodes[iter->i];
+
+				double dDX = nodeOther.x - node.x;
+				double dDY = nodeOther.y - node.y;
+				double dDZ = nodeOther.z - node.z;
+
+				if (dDX * dDX + dDY * dDY + dDZ * dDZ < dTolerance2) {
+					fCoincident = true;
+					break;
+				}
+			}
+			if (fCoincident) {
+				break;
+			}
+		}
+	}
+
+	return fCoincident;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Mesh::RemoveCoincidentNodes() {
 
+	// Quick check for meshes that do not contain any coincident nodes
+	if (!HasCoincidentNodes(ReferenceTolerance)) {
+		return;
+	}
+
 	// Use kdtree to find shortest distance to other nodes
 	kdtree * kdt = kd_create(3);
 	if (kdt == nullptr) {
@@ -427,7 +1057,7 @@ void Mesh::RemoveCoincidentNodes() {
 		return;
 	}
 
-	Announce("%i duplicate nodes detected", nodes.size() - vecUniques.size());
+	Announce("%lu duplicate nodes detected", nodes.size() - vecUniques.size());
 
 	// Remove duplicates from nodes vector
 	{
@@ -456,6 +1086,14 @@ void Mesh::Write(
 	const int ParamFour = 4;
 	const int ParamLenString = 33;
 
+	// Indices are stored as 32-bit integers in the output file
+	if ((nodes.size() > static_cast<size_t>(INT_MAX)) ||
+	    (faces.size() > static_cast<size_t>(INT_MAX))
+	) {
+		_EXCEPTION1("Mesh is too large to be written to \"%s\": at most "
+			"2^31-1 nodes and faces are supported", strFile.c_str());
+	}
+
 	// Temporarily change error reporting
 	NcError error_temp(NcError::verbose_fatal);
 
@@ -832,7 +1470,7 @@ void Mesh::Write(
 
 			int iLocal = vecConnectCount[iBlock];
 			for (int k = 0; k < faces[i].edges.size(); k++) {
-				vecConnect[iBlock][iLocal][k] = faces[i][k] + 1;
+				vecConnect[iBlock][iLocal][k] = static_cast<int>(faces[i][k] + 1);
 
 				vecEdgeType[iBlock][iLocal][k] =
 					static_cast<int>(faces[i].edges[k].type);
@@ -841,10 +1479,12 @@ void Mesh::Write(
 			vecGlobalId[iBlock][iLocal] = i + 1;
 
 			if (vecSourceFaceIx.size() != 0) {
-				vecFaceParentA[iBlock][iLocal] = vecSourceFaceIx[i] + 1;
+				vecFaceParentA[iBlock][iLocal] =
+					static_cast<int>(vecSourceFaceIx[i] + 1);
 			}
 			if (vecTargetFaceIx.size() != 0) {
-				vecFaceParentB[iBlock][iLocal] = vecTargetFaceIx[i] + 1;
+				vecFaceParentB[iBlock][iLocal] =
+					static_cast<int>(vecTargetFaceIx[i] + 1);
 			}
 
 			vecConnectCount[iBlock]++;
@@ -922,6 +1562,14 @@ void Mesh::WriteScrip(
 ) const {
 	const int ParamLenString = 33;
 
+	// Indices are stored as 32-bit integers in the output file
+	if ((nodes.size() > static_cast<size_t>(INT_MAX)) ||
+	    (faces.size() > static_cast<size_t>(INT_MAX))
+	) {
+		_EXCEPTION1("Mesh is too large to be written to \"%s\": at most "
+			"2^31-1 nodes and faces are supported", strFile.c_str());
+	}
+
 	// Temporarily change error reporting
 	NcError error_temp(NcError::verbose_fatal);
 
@@ -1024,30 +1672,69 @@ void Mesh::WriteScrip(
 		DataArray1D<double> centerLon(nElementCount);
 		DataArray2D<double> cornerLat(nElementCount, nCornersMax);
 		DataArray2D<double> cornerLon(nElementCount, nCornersMax);
-		Node corner(0,0,0);
+
+		// Corners and centers are converted in blocks of faces with the
+		// batch transform; faces only reference nodes that are converted
+		const int BlockSize = 4096;
+
+		std::vector<double> dX;
+		std::vector<double> dY;
+		std::vector<double> dZ;
+		std::vector<double> dLon;
+		std::vector<double> dLat;
+
+		for (int iBlockBegin = 0; iBlockBegin < nElementCount; iBlockBegin += BlockSize) {
+			const int iBlockEnd = std::min(iBlockBegin + BlockSize, nElementCount);
+
+			// Gather corners followed by the normalized face centers
+			dX.clear();
+			dY.clear();
+			dZ.clear();
+			for (int i = iBlockBegin; i < iBlockEnd; i++) {
+				for (int j = 0; j < faces[i].edges.size(); j++) {
+					const Node & corner = nodes[faces[i][j]];
+					dX.push_back(corner.x);
+					dY.push_back(corner.y);
+					dZ.push_back(corner.z);
+				}
+			}
+			const size_t sCornerCount = dX.size();
+
+			for (int i = iBlockBegin; i < iBlockEnd; i++) {
+				Node center(0,0,0);
+				int nCorners = faces[i].edges.size();
+				for (int j = 0; j < nCorners; j++) {
+					center = center + nodes[faces[i][j]];
+				}
+				center = center / nCorners;
+				double dMag = sqrt(center.x * center.x +
+								   center.y * center.y +
+								   center.z * center.z);
+				dX.push_back(center.x / dMag);
+				dY.push_back(center.y / dMag);
+				dZ.push_back(center.z / dMag);
+			}
+
+			dLon.resize(dX.size());
+			dLat.resize(dX.size());
+			XYZtoRLL_Batch(
+				dX.size(), &(dX[0]), &(dY[0]), &(dZ[0]),
+				&(dLon[0]), &(dLat[0]), true);
+
+			size_t sCorner = 0;
+			for (int i = iBlockBegin; i < iBlockEnd; i++) {
+				for (int j = 0; j < faces[i].edges.size(); j++) {
+					cornerLon[i][j] = dLon[sCorner];
+					cornerLat[i][j] = dLat[sCorner];
+					sCorner++;
+				}
+				centerLon[i] = dLon[sCornerCount + (i - iBlockBegin)];
+				centerLat[i] = dLat[sCornerCount + (i - iBlockBegin)];
+			}
+		}
+
 		for (int i=0; i<nElementCount; i++) {
-			Node center(0,0,0);
-			// int nCorners = faces[i].edges.size()+1;
 			int nCorners = faces[i].edges.size();
-			for (int j=0; j<nCorners; ++j) {
-				corner = nodes[ faces[i][j] ];
-				XYZtoRLL_Deg(
-					corner.x, corner.y, corner.z,
-					cornerLon[i][j],
-					cornerLat[i][j]);
-				center = center + corner;
-			}
-			center = center / nCorners;
-			double dMag = sqrt(center.x * center.x + 
-							   center.y * center.y + 
-							   center.z * center.z);
-			center.x /= dMag;
-			center.y /= dMag;
-			center.z /= dMag;
-			XYZtoRLL_Deg(
-				center.x, center.y, center.z,
-				centerLon[i],
-				centerLat[i]);
 			// Adjust corner logitudes
 			double lonDiff;
 			for (int j=0; j<nCorners; ++j) {
@@ -1118,9 +1805,119 @@ void Mesh::WriteScrip(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+const char * MeshFileInfo::FormatName(
+	Format eFormat
+) {
+	switch (eFormat) {
+		case Format_ICON: return "ICON";
+		case Format_UGRID: return "UGRID";
+		case Format_MPAS: return "MPAS";
+		case Format_SCRIP: return "SCRIP";
+		case Format_Exodus: return "Exodus";
+		default: return "Unknown";
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine the format of an open mesh file from its dimensions and
+///		attributes.  For UGRID files the mesh topology variable is returned
+///		in pvarMeshTopology.
+///	</summary>
+static MeshFileInfo::Format DetectMeshFileFormat(
+	NcFile & ncFile,
+	NcVar ** pvarMeshTopology = NULL
+) {
+	// Check for global attribute title = "ICON grid description"
+	NcAtt * attICON = ncFile.get_att("title");
+	if (attICON != NULL) {
+		std::string strAttTitle = attICON->as_string(0);
+		if (strAttTitle == "ICON grid description") {
+			return MeshFileInfo::Format_ICON;
+		}
+	}
+
+	// Check for a UGRID mesh topology variable (cf_role = "mesh_topology")
+	for (int v = 0; v < ncFile.num_vars(); v++) {
+		NcVar * var = ncFile.get_var(v);
+		NcAtt * attCFRole = var->get_att("cf_role");
+		if (attCFRole == NULL) {
+			continue;
+		}
+		if (std::string(attCFRole->as_string(0)) != "mesh_topology") {
+			continue;
+		}
+		NcAtt * attTopologyDimension = var->get_att("topology_dimension");
+		if ((attTopologyDimension != NULL) &&
+		    (attTopologyDimension->as_int(0) != 2)
+		) {
+			continue;
+		}
+		if (pvarMeshTopology != NULL) {
+			(*pvarMeshTopology) = var;
+		}
+		return MeshFileInfo::Format_UGRID;
+	}
+
+	// Check for MPAS variables "verticesOnCell" and "nEdgesOnCell"
+	if ((ncFile.get_var("verticesOnCell") != NULL) &&
+	    (ncFile.get_var("nEdgesOnCell") != NULL)
+	) {
+		return MeshFileInfo::Format_MPAS;
+	}
+
+	// Check for dimension names "grid_size", "grid_rank" and "grid_corners"
+	int iSCRIPFormat = 0;
+	for (int i = 0; i < ncFile.num_dims(); i++) {
+		NcDim * dim = ncFile.get_dim(i);
+		std::string strDimName = dim->name();
+		if (strDimName == "grid_size") {
+			iSCRIPFormat++;
+		}
+		if (strDimName == "grid_corners") {
+			iSCRIPFormat++;
+		}
+		if (strDimName == "grid_rank") {
+			iSCRIPFormat++;
+		}
+	}
+	if (iSCRIPFormat == 3) {
+		return MeshFileInfo::Format_SCRIP;
+	}
+
+	// Check for Exodus dimension "num_el_blk"
+	if (ncFile.get_dim("num_el_blk") != NULL) {
+		return MeshFileInfo::Format_Exodus;
+	}
+
+	return MeshFileInfo::Format_Unknown;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Determine if a SCRIP coordinate variable is in degrees.  SCRIP
+///		coordinates are in radians unless the units attribute names
+///		degrees ("degrees", "degrees_north", "degree_E", ...).
+///	</summary>
+static bool IsSCRIPCoordinateInDegrees(
+	NcVar * var
+) {
+	NcAtt * attUnits = var->get_att("units");
+	if (attUnits == NULL) {
+		return false;
+	}
+	std::string strUnits = attUnits->as_string(0);
+	STLStringHelper::ToLower(strUnits);
+	return (strUnits.compare(0, 6, "degree") == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Mesh::Read(
 	const std::string & strFile,
-	bool fRemoveCoincidentNodes
+	CoincidentNodePolicy eCoincidentNodePolicy
 ) {
 
 	const int ParamFour = 4;
@@ -1142,146 +1939,535 @@ void Mesh::Read(
 			strFile.c_str());
 	}
 
-	// Check for global attribute title = "ICON grid description" 
-	NcAtt * attICON = ncFile.get_att("title");
-	if (attICON != NULL) {
-		std::string strAttTitle = attICON->as_string(0);
-		if (strAttTitle == "ICON grid description") {
-			NcDim * dimVertex = ncFile.get_dim("vertex");
-			if (dimVertex == NULL) {
-				_EXCEPTION1("ICON grid file \"%s\" missing dimension \"vertex\"",
-					strFile.c_str());
-			}
-			NcDim * dimCell = ncFile.get_dim("cell");
-			if (dimVertex == NULL) {
-				_EXCEPTION1("ICON grid file \"%s\" missing dimension \"cell\"",
-					strFile.c_str());
-			}
+	// Determine the file format
+	NcVar * varMeshTopology = NULL;
+	MeshFileInfo::Format eFormat =
+		DetectMeshFileFormat(ncFile, &varMeshTopology);
+
+	// Input from an ICON grid file
+	if (eFormat == MeshFileInfo::Format_ICON) {
+		NcDim * dimVertex = ncFile.get_dim("vertex");
+		if (dimVertex == NULL) {
+			_EXCEPTION1("ICON grid file \"%s\" missing dimension \"vertex\"",
+				strFile.c_str());
+		}
+		NcDim * dimCell = ncFile.get_dim("cell");
+		if (dimVertex == NULL) {
+			_EXCEPTION1("ICON grid file \"%s\" missing dimension \"cell\"",
+				strFile.c_str());
+		}
 
-			nodes.resize(dimVertex->size());
+		nodes.resize(dimVertex->size());
 
-			DataArray1D<double> dNodeBuffer(dimVertex->size());
+		DataArray1D<double> dNodeBuffer(dimVertex->size());
 
-			// Load in x coordinates of vertices
-			NcVar * varICONX = ncFile.get_var("cartesian_x_vertices");
-			if (varICONX == NULL) {
-				_EXCEPTION1("ICON grid file \"%s\" missing variable \"cartesian_x_vertices\"",
-					strFile.c_str());
+		// Load in x coordinates of vertices
+		NcVar * varICONX = ncFile.get_var("cartesian_x_vertices");
+		if (varICONX == NULL) {
+			_EXCEPTION1("ICON grid file \"%s\" missing variable \"cartesian_x_vertices\"",
+				strFile.c_str());
+		}
+		if (varICONX->num_dims() != 1) {
+			_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_x_vertices\" must have dimension 1",
+				strFile.c_str());
+		}
+		if (std::string(varICONX->get_dim(0)->name()) != "vertex") {
+			_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_x_vertices\" dimension 0 must have name \"vertex\"",
+				strFile.c_str());
+		}
+		varICONX->set_cur((long)0);
+		varICONX->get(&(dNodeBuffer[0]), dimVertex->size());
+		for (long i = 0; i < dimVertex->size(); i++) {
+			nodes[i].x = dNodeBuffer[i];
+		}
+
+		// Load in y coordinates of vertices
+		NcVar * varICONY = ncFile.get_var("cartesian_y_vertices");
+		if (varICONY == NULL) {
+			_EXCEPTION1("ICON grid file \"%s\" missing variable \"cartesian_y_vertices\"",
+				strFile.c_str());
+		}
+		if (varICONY->num_dims() != 1) {
+			_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_y_vertices\" must have dimension 1",
+				strFile.c_str());
+		}
+		if (std::string(varICONY->get_dim(0)->name()) != "vertex") {
+			_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_y_vertices\" dimension 0 must have name \"vertex\"",
+				strFile.c_str());
+		}
+		varICONY->set_cur((long)0);
+		varICONY->get(&(dNodeBuffer[0]), dimVertex->size());
+		for (long i = 0; i < dimVertex->size(); i++) {
+			nodes[i].y = dNodeBuffer[i];
+		}
+
+		// Load in z coordinates of vertices
+		NcVar * varICONZ = ncFile.get_var("cartesian_z_vertices");
+		if (varICONZ == NULL) {
+			_EXCEPTION1("ICON grid file \"%s\" missing variable \"cartesian_z_vertices\"",
+				strFile.c_str());
+		}
+		if (varICONZ->num_dims() != 1) {
+			_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_z_vertices\" must have dimension 1",
+				strFile.c_str());
+		}
+		if (std::string(varICONZ->get_dim(0)->name()) != "vertex") {
+			_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_z_vertices\" dimension 0 must have name \"vertex\"",
+				strFile.c_str());
+		}
+		varICONZ->set_cur((long)0);
+		varICONZ->get(&(dNodeBuffer[0]), dimVertex->size());
+		for (long i = 0; i < dimVertex->size(); i++) {
+			nodes[i].z = dNodeBuffer[i];
+		}
+
+		dNodeBuffer.Detach();
+
+		// Load in face vertex indices
+		NcVar * varVertexOfCell = ncFile.get_var("vertex_of_cell");
+		if (varVertexOfCell == NULL) {
+			_EXCEPTION1("ICON grid file \"%s\" missing variable \"vertex_of_cell\"",
+				strFile.c_str());
+		}
+		if (varVertexOfCell->num_dims() != 2) {
+			_EXCEPTION1("ICON grid file \"%s\" variable \"vertex_of_cell\" must have dimension 2",
+				strFile.c_str());
+		}
+		if (std::string(varVertexOfCell->get_dim(1)->name()) != "cell") {
+			_EXCEPTION1("ICON grid file \"%s\" variable \"vertex_of_cell\" dimension 1 must have name \"cell\"",
+				strFile.c_str());
+		}
+
+		long lVerticesPerCell = varVertexOfCell->get_dim(0)->size();
+
+		faces.resize(dimCell->size(), Face(lVerticesPerCell));
+
+		DataArray2D<FileNodeIndex> dVertexOfCellBuf(
+			lVerticesPerCell,
+			dimCell->size());
+		varVertexOfCell->get(
+			&(dVertexOfCellBuf(0,0)), 
+			lVerticesPerCell,
+			dimCell->size());
+
+		for (long i = 0; i < dimCell->size(); i++) {
+			for (long j = 0; j < lVerticesPerCell; j++) {
+				if ((dVertexOfCellBuf(j,i) < 1) || (dVertexOfCellBuf(j,i) > nodes.size())) {
+					_EXCEPTION4("ICON grid file \"%s\" vertex %li cell %li out of range (%li)",
+						strFile.c_str(), j, i, (long)(dVertexOfCellBuf(j,i)));
+				}
+				faces[i].SetNode(j, static_cast<NodeIndex>(dVertexOfCellBuf(j,i)-1));
 			}
-			if (varICONX->num_dims() != 1) {
-				_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_x_vertices\" must have dimension 1",
-					strFile.c_str());
+		}
+		return;
+	}
+
+	// Input from a NetCDF UGRID file
+	if (eFormat == MeshFileInfo::Format_UGRID) {
+		Announce("UGRID Format File detected");
+
+		std::string strMeshName = varMeshTopology->name();
+
+		// Names of the node coordinate variables
+		NcAtt * attNodeCoordinates =
+			varMeshTopology->get_att("node_coordinates");
+		if (attNodeCoordinates == NULL) {
+			_EXCEPTION2("UGRID mesh \"%s\" in file \"%s\" is missing "
+				"attribute \"node_coordinates\"",
+				strMeshName.c_str(), strFile.c_str());
+		}
+
+		std::vector<std::string> vecNodeCoordinates;
+		{
+			std::istringstream iss(attNodeCoordinates->as_string(0));
+			std::string strName;
+			while (iss >> strName) {
+				vecNodeCoordinates.push_back(strName);
 			}
-			if (std::string(varICONX->get_dim(0)->name()) != "vertex") {
-				_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_x_vertices\" dimension 0 must have name \"vertex\"",
-					strFile.c_str());
+		}
+		if (vecNodeCoordinates.size() != 2) {
+			_EXCEPTION2("UGRID mesh \"%s\" in file \"%s\" attribute "
+				"\"node_coordinates\" must name exactly two variables",
+				strMeshName.c_str(), strFile.c_str());
+		}
+
+		NcVar * varNodeLon = ncFile.get_var(vecNodeCoordinates[0].c_str());
+		NcVar * varNodeLat = ncFile.get_var(vecNodeCoordinates[1].c_str());
+		for (int c = 0; c < 2; c++) {
+			NcVar * var = (c == 0)?(varNodeLon):(varNodeLat);
+			if (var == NULL) {
+				_EXCEPTION2("UGRID file \"%s\" is missing node coordinate "
+					"variable \"%s\"",
+					strFile.c_str(), vecNodeCoordinates[c].c_str());
 			}
-			varICONX->set_cur((long)0);
-			varICONX->get(&(dNodeBuffer[0]), dimVertex->size());
-			for (long i = 0; i < dimVertex->size(); i++) {
-				nodes[i].x = dNodeBuffer[i];
+			if (var->num_dims() != 1) {
+				_EXCEPTION2("UGRID file \"%s\" node coordinate variable "
+					"\"%s\" must have dimension 1",
+					strFile.c_str(), vecNodeCoordinates[c].c_str());
 			}
+		}
 
-			// Load in y coordinates of vertices
-			NcVar * varICONY = ncFile.get_var("cartesian_y_vertices");
-			if (varICONY == NULL) {
-				_EXCEPTION1("ICON grid file \"%s\" missing variable \"cartesian_y_vertices\"",
-					strFile.c_str());
-			}
-			if (varICONY->num_dims() != 1) {
-				_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_y_vertices\" must have dimension 1",
-					strFile.c_str());
+		// The convention lists x (longitude) first, but honor standard_name
+		NcAtt * attStandardName = varNodeLon->get_att("standard_name");
+		if ((attStandardName != NULL) &&
+		    (std::string(attStandardName->as_string(0)) == "latitude")
+		) {
+			std::swap(varNodeLon, varNodeLat);
+		}
+
+		long lNodeCount = varNodeLon->get_dim(0)->size();
+		if (varNodeLat->get_dim(0)->size() != lNodeCount) {
+			_EXCEPTION1("UGRID file \"%s\" node coordinate variables "
+				"have inconsistent sizes", strFile.c_str());
+		}
+
+		DataArray1D<double> dNodeLon(lNodeCount);
+		DataArray1D<double> dNodeLat(lNodeCount);
+
+		varNodeLon->set_cur((long)0);
+		varNodeLon->get(&(dNodeLon[0]), lNodeCount);
+
+		varNodeLat->set_cur((long)0);
+		varNodeLat->get(&(dNodeLat[0]), lNodeCount);
+
+		// Node coordinates are in degrees unless units say otherwise;
+		// coordinates in radians are converted to degrees
+		for (int c = 0; c < 2; c++) {
+			NcVar * var = (c == 0)?(varNodeLon):(varNodeLat);
+			DataArray1D<double> & dCoord = (c == 0)?(dNodeLon):(dNodeLat);
+
+			NcAtt * attUnits = var->get_att("units");
+			if (attUnits == NULL) {
+				continue;
 			}
-			if (std::string(varICONY->get_dim(0)->name()) != "vertex") {
-				_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_y_vertices\" dimension 0 must have name \"vertex\"",
-					strFile.c_str());
+			std::string strUnits = attUnits->as_string(0);
+			STLStringHelper::ToLower(strUnits);
+			if (strUnits.compare(0, 3, "rad") == 0) {
+				for (long i = 0; i < lNodeCount; i++) {
+					dCoord[i] *= 180.0 / M_PI;
+				}
 			}
-			varICONY->set_cur((long)0);
-			varICONY->get(&(dNodeBuffer[0]), dimVertex->size());
-			for (long i = 0; i < dimVertex->size(); i++) {
-				nodes[i].y = dNodeBuffer[i];
+		}
+
+		// Insert nodes, converting blocks to Cartesian coordinates in parallel
+		nodes.resize(lNodeCount);
+		{
+			const long NodesPerBlock = 4096;
+			const long nBlocks = (lNodeCount + NodesPerBlock - 1) / NodesPerBlock;
+
+#pragma omp parallel
+			{
+				std::vector<double> dX(NodesPerBlock);
+				std::vector<double> dY(NodesPerBlock);
+				std::vector<double> dZ(NodesPerBlock);
+
+#pragma omp for
+				for (long b = 0; b < nBlocks; b++) {
+					const long lBegin = b * NodesPerBlock;
+					const long lCount = std::min(NodesPerBlock, lNodeCount - lBegin);
+
+					RLLtoXYZ_Batch(
+						lCount,
+						&(dNodeLon[lBegin]),
+						&(dNodeLat[lBegin]),
+						&(dX[0]),
+						&(dY[0]),
+						&(dZ[0]),
+						true);
+
+					for (long k = 0; k < lCount; k++) {
+						nodes[lBegin + k].Set(dX[k], dY[k], dZ[k]);
+					}
+				}
 			}
+		}
 
-			// Load in z coordinates of vertices
-			NcVar * varICONZ = ncFile.get_var("cartesian_z_vertices");
-			if (varICONZ == NULL) {
-				_EXCEPTION1("ICON grid file \"%s\" missing variable \"cartesian_z_vertices\"",
-					strFile.c_str());
+		dNodeLon.Detach();
+		dNodeLat.Detach();
+
+		// Face-node connectivity
+		NcAtt * attFaceNodeConnectivity =
+			varMeshTopology->get_att("face_node_connectivity");
+		if (attFaceNodeConnectivity == NULL) {
+			_EXCEPTION2("UGRID mesh \"%s\" in file \"%s\" is missing "
+				"attribute \"face_node_connectivity\"",
+				strMeshName.c_str(), strFile.c_str());
+		}
+
+		std::string strFaceNodes = attFaceNodeConnectivity->as_string(0);
+		NcVar * varFaceNodes = ncFile.get_var(strFaceNodes.c_str());
+		if (varFaceNodes == NULL) {
+			_EXCEPTION2("UGRID file \"%s\" is missing variable \"%s\"",
+				strFile.c_str(), strFaceNodes.c_str());
+		}
+		if (varFaceNodes->num_dims() != 2) {
+			_EXCEPTION2("UGRID file \"%s\" variable \"%s\" must have "
+				"dimension 2", strFile.c_str(), strFaceNodes.c_str());
+		}
+
+		// Connectivity is (face, node) unless face_dimension names the
+		// second dimension
+		bool fTransposed = false;
+		NcAtt * attFaceDimension = varMeshTopology->get_att("face_dimension");
+		if (attFaceDimension != NULL) {
+			std::string strFaceDimension = attFaceDimension->as_string(0);
+			if (strFaceDimension == varFaceNodes->get_dim(1)->name()) {
+				fTransposed = true;
+			} else if (strFaceDimension != varFaceNodes->get_dim(0)->name()) {
+				_EXCEPTION3("UGRID file \"%s\" face_dimension \"%s\" is not "
+					"a dimension of \"%s\"", strFile.c_str(),
+					strFaceDimension.c_str(), strFaceNodes.c_str());
 			}
-			if (varICONZ->num_dims() != 1) {
-				_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_z_vertices\" must have dimension 1",
-					strFile.c_str());
+		}
+
+		const long lFaceCount =
+			varFaceNodes->get_dim((fTransposed)?(1):(0))->size();
+		const long lMaxFaceNodes =
+			varFaceNodes->get_dim((fTransposed)?(0):(1))->size();
+
+		// Indices are zero-based unless start_index says otherwise; padding
+		// is marked by _FillValue or by any index below start_index
+		FileNodeIndex iStartIndex = 0;
+		NcAtt * attStartIndex = varFaceNodes->get_att("start_index");
+		if (attStartIndex != NULL) {
+			iStartIndex = attStartIndex->as_int(0);
+		}
+
+		FileNodeIndex iFillValue =
+			(varFaceNodes->type() == ncInt64)?(NC_FILL_INT64):(NC_FILL_INT);
+		NcAtt * attFillValue = varFaceNodes->get_att("_FillValue");
+		if (attFillValue != NULL) {
+			iFillValue = static_cast<FileNodeIndex>(attFillValue->as_ncint64(0));
+		}
+
+		faces.resize(lFaceCount);
+
+		// Read connectivity in chunks of faces directly into the face array
+		const long FacesPerChunk = 65536;
+
+		DataArray1D<FileNodeIndex> nConnect(
+			std::min(FacesPerChunk, lFaceCount) * lMaxFaceNodes);
+
+		for (long f = 0; f < lFaceCount; f += FacesPerChunk) {
+			const long lChunk = std::min(FacesPerChunk, lFaceCount - f);
+
+			if (fTransposed) {
+				varFaceNodes->set_cur(0, f);
+				varFaceNodes->get(&(nConnect[0]), lMaxFaceNodes, lChunk);
+			} else {
+				varFaceNodes->set_cur(f, 0);
+				varFaceNodes->get(&(nConnect[0]), lChunk, lMaxFaceNodes);
 			}
-			if (std::string(varICONZ->get_dim(0)->name()) != "vertex") {
-				_EXCEPTION1("ICON grid file \"%s\" variable \"cartesian_z_vertices\" dimension 0 must have name \"vertex\"",
-					strFile.c_str());
+
+			const long lFaceStride = (fTransposed)?(1):(lMaxFaceNodes);
+			const long lNodeStride = (fTransposed)?(lChunk):(1);
+
+			long lInvalidFace = lFaceCount;
+
+#pragma omp parallel for reduction(min:lInvalidFace)
+			for (long i = 0; i < lChunk; i++) {
+				const FileNodeIndex * pConnect = &(nConnect[i * lFaceStride]);
+
+				int nFaceNodes = 0;
+				for (; nFaceNodes < lMaxFaceNodes; nFaceNodes++) {
+					FileNodeIndex iNode = pConnect[nFaceNodes * lNodeStride];
+					if ((iNode == iFillValue) || (iNode < iStartIndex)) {
+						break;
+					}
+				}
+
+				// Padding must be trailing and faces must be polygons
+				bool fValid = (nFaceNodes >= 3);
+				for (int j = nFaceNodes; j < lMaxFaceNodes; j++) {
+					FileNodeIndex iNode = pConnect[j * lNodeStride];
+					if ((iNode != iFillValue) && (iNode >= iStartIndex)) {
+						fValid = false;
+					}
+				}
+
+				Face & face = faces[f + i];
+				face = Face(nFaceNodes);
+				for (int j = 0; j < nFaceNodes; j++) {
+					FileNodeIndex iNode = pConnect[j * lNodeStride] - iStartIndex;
+					if (iNode >= lNodeCount) {
+						fValid = false;
+					}
+					face.SetNode(j, static_cast<NodeIndex>(iNode));
+				}
+
+				if (!fValid) {
+					lInvalidFace = std::min(lInvalidFace, f + i);
+				}
 			}
-			varICONZ->set_cur((long)0);
-			varICONZ->get(&(dNodeBuffer[0]), dimVertex->size());
-			for (long i = 0; i < dimVertex->size(); i++) {
-				nodes[i].z = dNodeBuffer[i];
+
+			if (lInvalidFace != lFaceCount) {
+				_EXCEPTION3("UGRID file \"%s\" variable \"%s\" has invalid "
+					"connectivity for face %li", strFile.c_str(),
+					strFaceNodes.c_str(), lInvalidFace);
 			}
+		}
+
+		// UGRID references an explicit node table, so coincident nodes are
+		// only removed if explicitly requested.
+		if (eCoincidentNodePolicy == CoincidentNodePolicy_Always) {
+			Announce("Removing coincident nodes");
+			RemoveCoincidentNodes();
+		}
+
+		// Output size
+		Announce("Mesh size: Nodes [%i] Elements [%i]",
+			nodes.size(), faces.size());
+
+		return;
+	}
+
+	// Input from a NetCDF MPAS file
+	if (eFormat == MeshFileInfo::Format_MPAS) {
+		Announce("MPAS Format File detected");
 
-			dNodeBuffer.Detach();
+		NcVar * varVerticesOnCell = ncFile.get_var("verticesOnCell");
+		NcVar * varEdgesOnCell = ncFile.get_var("nEdgesOnCell");
 
-			// Load in face vertex indices
-			NcVar * varVertexOfCell = ncFile.get_var("vertex_of_cell");
-			if (varVertexOfCell == NULL) {
-				_EXCEPTION1("ICON grid file \"%s\" missing variable \"vertex_of_cell\"",
+		NcAtt * attOnASphere = ncFile.get_att("on_a_sphere");
+		if (attOnASphere != NULL) {
+			std::string strOnASphere = attOnASphere->as_string(0);
+			STLStringHelper::ToLower(strOnASphere);
+			if (strOnASphere.compare(0, 3, "yes") != 0) {
+				_EXCEPTION1("MPAS grid file \"%s\" is not on a sphere",
 					strFile.c_str());
 			}
-			if (varVertexOfCell->num_dims() != 2) {
-				_EXCEPTION1("ICON grid file \"%s\" variable \"vertex_of_cell\" must have dimension 2",
-					strFile.c_str());
+		}
+
+		NcDim * dimVertices = ncFile.get_dim("nVertices");
+		if (dimVertices == NULL) {
+			_EXCEPTION1("MPAS grid file \"%s\" missing dimension \"nVertices\"",
+				strFile.c_str());
+		}
+		NcDim * dimCells = ncFile.get_dim("nCells");
+		if (dimCells == NULL) {
+			_EXCEPTION1("MPAS grid file \"%s\" missing dimension \"nCells\"",
+				strFile.c_str());
+		}
+		if (varVerticesOnCell->num_dims() != 2) {
+			_EXCEPTION1("MPAS grid file \"%s\" variable \"verticesOnCell\" "
+				"must have dimension 2", strFile.c_str());
+		}
+
+		const long lVertexCount = dimVertices->size();
+		const long lCellCount = dimCells->size();
+		const long lMaxEdges = varVerticesOnCell->get_dim(1)->size();
+
+		// Load in Cartesian coordinates of vertices, one read per variable
+		DataArray1D<double> dVertexX(lVertexCount);
+		DataArray1D<double> dVertexY(lVertexCount);
+		DataArray1D<double> dVertexZ(lVertexCount);
+
+		const char * szVertexVars[3] = {"xVertex", "yVertex", "zVertex"};
+		DataArray1D<double> * pVertexCoord[3] = {&dVertexX, &dVertexY, &dVertexZ};
+
+		for (int c = 0; c < 3; c++) {
+			NcVar * var = ncFile.get_var(szVertexVars[c]);
+			if (var == NULL) {
+				_EXCEPTION2("MPAS grid file \"%s\" missing variable \"%s\"",
+					strFile.c_str(), szVertexVars[c]);
 			}
-			if (std::string(varVertexOfCell->get_dim(1)->name()) != "cell") {
-				_EXCEPTION1("ICON grid file \"%s\" variable \"vertex_of_cell\" dimension 1 must have name \"cell\"",
-					strFile.c_str());
+			if ((var->num_dims() != 1) ||
+			    (var->get_dim(0)->size() != lVertexCount)
+			) {
+				_EXCEPTION2("MPAS grid file \"%s\" variable \"%s\" must have "
+					"dimension \"nVertices\"", strFile.c_str(), szVertexVars[c]);
 			}
+			var->set_cur((long)0);
+			var->get(&((*pVertexCoord[c])[0]), lVertexCount);
+		}
+
+		// Vertices are stored on a sphere of radius sphere_radius; scale
+		// them onto the unit sphere.  Without the attribute each vertex is
+		// normalized individually.
+		double dSphereRadius = 0.0;
+		NcAtt * attSphereRadius = ncFile.get_att("sphere_radius");
+		if (attSphereRadius != NULL) {
+			dSphereRadius = attSphereRadius->as_double(0);
+		}
 
-			long lVerticesPerCell = varVertexOfCell->get_dim(0)->size();
+		nodes.resize(lVertexCount);
 
-			faces.resize(dimCell->size(), Face(lVerticesPerCell));
+#pragma omp parallel for
+		for (long i = 0; i < lVertexCount; i++) {
+			double dScale;
+			if (dSphereRadius > 0.0) {
+				dScale = 1.0 / dSphereRadius;
+			} else {
+				dScale = 1.0 / sqrt(
+					  dVertexX[i] * dVertexX[i]
+					+ dVertexY[i] * dVertexY[i]
+					+ dVertexZ[i] * dVertexZ[i]);
+			}
+			nodes[i].Set(
+				dVertexX[i] * dScale,
+				dVertexY[i] * dScale,
+				dVertexZ[i] * dScale);
+		}
 
-			DataArray2D<int> dVertexOfCellBuf(
-				lVerticesPerCell,
-				dimCell->size());
-			varVertexOfCell->get(
-				&(dVertexOfCellBuf(0,0)), 
-				lVerticesPerCell,
-				dimCell->size());
+		dVertexX.Detach();
+		dVertexY.Detach();
+		dVertexZ.Detach();
 
-			for (long i = 0; i < dimCell->size(); i++) {
-				for (long j = 0; j < lVerticesPerCell; j++) {
-					if ((dVertexOfCellBuf(j,i) < 1) || (dVertexOfCellBuf(j,i) > nodes.size())) {
-						_EXCEPTION4("ICON grid file \"%s\" vertex %li cell %li out of range (%li)",
-							strFile.c_str(), j, i, dVertexOfCellBuf(j,i));
-					}
-					faces[i].SetNode(j, dVertexOfCellBuf(j,i)-1);
+		// Load in cell degrees and vertex indices
+		DataArray1D<int> nEdgesOnCell(lCellCount);
+		varEdgesOnCell->set_cur((long)0);
+		varEdgesOnCell->get(&(nEdgesOnCell[0]), lCellCount);
+
+		DataArray2D<FileNodeIndex> nVerticesOnCell(lCellCount, lMaxEdges);
+		varVerticesOnCell->set_cur(0, 0);
+		varVerticesOnCell->get(&(nVerticesOnCell[0][0]), lCellCount, lMaxEdges);
+
+		// Build variable-degree faces; vertex indices are one-based
+		faces.resize(lCellCount);
+
+		long lInvalidCell = lCellCount;
+
+#pragma omp parallel for reduction(min:lInvalidCell)
+		for (long i = 0; i < lCellCount; i++) {
+			int nEdges = nEdgesOnCell[i];
+			if ((nEdges < 3) || (nEdges > lMaxEdges)) {
+				lInvalidCell = std::min(lInvalidCell, i);
+				continue;
+			}
+
+			faces[i] = Face(nEdges);
+			for (int j = 0; j < nEdges; j++) {
+				FileNodeIndex iVertex = nVerticesOnCell[i][j];
+				if ((iVertex < 1) || (iVertex > lVertexCount)) {
+					lInvalidCell = std::min(lInvalidCell, i);
+					break;
 				}
+				faces[i].SetNode(j, static_cast<NodeIndex>(iVertex - 1));
 			}
-			return;
 		}
-	}
 
-	// Check for dimension names "grid_size", "grid_rank" and "grid_corners"
-	int iSCRIPFormat = 0;
-	for (int i = 0; i < ncFile.num_dims(); i++) {
-		NcDim * dim = ncFile.get_dim(i);
-		std::string strDimName = dim->name();
-		if (strDimName == "grid_size") {
-			iSCRIPFormat++;
+		if (lInvalidCell != lCellCount) {
+			_EXCEPTION2("MPAS grid file \"%s\" cell %li has invalid "
+				"\"nEdgesOnCell\" or \"verticesOnCell\"",
+				strFile.c_str(), lInvalidCell);
 		}
-		if (strDimName == "grid_corners") {
-			iSCRIPFormat++;
-		}
-		if (strDimName == "grid_rank") {
-			iSCRIPFormat++;
+
+		// MPAS references an explicit vertex table, so coincident nodes are
+		// only removed if explicitly requested.
+		if (eCoincidentNodePolicy == CoincidentNodePolicy_Always) {
+			Announce("Removing coincident nodes");
+			RemoveCoincidentNodes();
 		}
+
+		// Output size
+		Announce("Mesh size: Nodes [%i] Elements [%i]",
+			nodes.size(), faces.size());
+
+		return;
 	}
 
 	// Input from a NetCDF SCRIP file
-	if (iSCRIPFormat == 3) {
+	if (eFormat == MeshFileInfo::Format_SCRIP) {
 		Announce("SCRIP Format File detected");
 
 		NcDim * dimGridSize = ncFile.get_dim("grid_size");
@@ -1303,43 +2489,19 @@ void Mesh::Read(
 					"\"grid_corner_lon\"", strFile.c_str());
 		}
 
-		int nGridSize = static_cast<int>(dimGridSize->size());
-		int nGridCorners = static_cast<int>(dimGridCorners->size());
-
-		DataArray2D<double> dCornerLat(nGridSize, nGridCorners);
-		DataArray2D<double> dCornerLon(nGridSize, nGridCorners);
+		const long lGridSize = dimGridSize->size();
+		const long lGridCorners = dimGridCorners->size();
 
-		varGridCornerLat->set_cur(0, 0);
-		varGridCornerLat->get(&(dCornerLat[0][0]), nGridSize, nGridCorners);
+		CheckMeshIndexRange(strFile, "face corners", lGridSize * lGridCorners);
 
-		varGridCornerLon->set_cur(0, 0);
-		varGridCornerLon->get(&(dCornerLon[0][0]), nGridSize, nGridCorners);
+		faces.resize(lGridSize);
+		nodes.resize((size_t)(lGridSize) * lGridCorners);
 
-		faces.resize(nGridSize);
-		nodes.resize(nGridSize * nGridCorners);
-
-		// Check for units attribute; if "degrees" then convert to radians
-		bool fConvertLonToRadians = false;
-		NcAtt * attGridCornerLonUnits = varGridCornerLon->get_att("units");
-
-		if (attGridCornerLonUnits != NULL) {
-			std::string strLonUnits = attGridCornerLonUnits->as_string(0);
-			STLStringHelper::ToLower(strLonUnits);
-			if (strLonUnits == "degrees") {
-				fConvertLonToRadians = true;
-			}
-		}
-
-		bool fConvertLatToRadians = false;
-		NcAtt * attGridCornerLatUnits = varGridCornerLat->get_att("units");
-
-		if (attGridCornerLatUnits != NULL) {
-			std::string strLatUnits = attGridCornerLatUnits->as_string(0);
-			STLStringHelper::ToLower(strLatUnits);
-			if (strLatUnits == "degrees") {
-				fConvertLatToRadians = true;
-			}
-		}
+		// Check for units attribute; if degrees then convert to radians
+		const bool fConvertLonToRadians =
+			IsSCRIPCoordinateInDegrees(varGridCornerLon);
+		const bool fConvertLatToRadians =
+			IsSCRIPCoordinateInDegrees(varGridCornerLat);
 
 		// Load mask variable
 		NcVar * varMask = ncFile.get_var("grid_imask");
@@ -1348,7 +2510,7 @@ void Mesh::Read(
 				_EXCEPTIONT("Unknown format of variable \"grid_imask\": "
 					"More than one dimension");
 			}
-			if (varMask->get_dim(0)->size() != nGridSize) {
+			if (varMask->get_dim(0)->size() != lGridSize) {
 				_EXCEPTIONT("Unknown format of variable \"grid_imask\": "
 					"Incorrect first dimension size");
 			}
@@ -1357,52 +2519,101 @@ void Mesh::Read(
 			//		"Expected int type");
 			//}
 
-			vecMask.Allocate(nGridSize);
-			varMask->get(&(vecMask[0]), nGridSize);
+			vecMask.Allocate(lGridSize);
+			varMask->get(&(vecMask[0]), lGridSize);
 		}
 
-		// Current global node index
-		int ixNode = 0;
-
-		for (int i = 0; i < nGridSize; i++) {
-
-			// Create a new Face
-			Face faceNew(nGridCorners);
-			for (int j = 0; j < nGridCorners; j++) {
-				faceNew.SetNode(j, ixNode + j);
+		// Create Faces; corner j of Face i is node i * lGridCorners + j
+#pragma omp parallel for
+		for (long i = 0; i < lGridSize; i++) {
+			faces[i] = Face(static_cast<int>(lGridCorners));
+			for (long j = 0; j < lGridCorners; j++) {
+				faces[i].SetNode(j, static_cast<NodeIndex>(i * lGridCorners + j));
 			}
-			faces[i] = faceNew;
-
-			// Insert Face corners into node table
-			for (int j = 0; j < nGridCorners; j++) {
-				double dLon = dCornerLon[i][j];
-				double dLat = dCornerLat[i][j];
-
-				if (fConvertLonToRadians) {
-					dLon = dLon / 180.0 * M_PI;
-				}
-				if (fConvertLatToRadians) {
-					dLat = dLat / 180.0 * M_PI;
-				}
-
-				if (dLat > 0.5 * M_PI) {
-					dLat = 0.5 * M_PI;
-				}
-				if (dLat < -0.5 * M_PI) {
-					dLat = -0.5 * M_PI;
-				}
+		}
 
-				nodes[ixNode].x = cos(dLon) * cos(dLat);
-				nodes[ixNode].y = sin(dLon) * cos(dLat);
-				nodes[ixNode].z = sin(dLat);
+		// Insert Face corners into node table.  Chunks of rows are read on
+		// an I/O thread while the previous chunk is converted to Cartesian
+		// coordinates in parallel.
+		{
+			const bool fDegrees =
+				(fConvertLonToRadians && fConvertLatToRadians);
+
+			const long RowsPerChunk = 65536;
+			const long lChunks = (lGridSize + RowsPerChunk - 1) / RowsPerChunk;
+			const size_t sChunkSize = (size_t)(RowsPerChunk) * lGridCorners;
+
+			// Each buffer holds a chunk of longitudes followed by latitudes
+			PipelinedChunkRead<double>(
+				lChunks,
+				2 * sChunkSize,
+				[&](long c, double * dBuffer) {
+					const long lRowBegin = c * RowsPerChunk;
+					const long lRows = std::min(RowsPerChunk, lGridSize - lRowBegin);
+
+					varGridCornerLon->set_cur(lRowBegin, 0);
+					varGridCornerLon->get(dBuffer, lRows, lGridCorners);
+
+					varGridCornerLat->set_cur(lRowBegin, 0);
+					varGridCornerLat->get(dBuffer + sChunkSize, lRows, lGridCorners);
+				},
+				[&](long c, double * dBuffer) {
+					const long lRowBegin = c * RowsPerChunk;
+					const long lRows = std::min(RowsPerChunk, lGridSize - lRowBegin);
+					const size_t sTotal = (size_t)(lRows) * lGridCorners;
+
+					double * dLon = dBuffer;
+					double * dLat = dBuffer + sChunkSize;
+
+					// Mixed units are converted to radians up front
+					if (!fDegrees && fConvertLonToRadians) {
+						for (size_t k = 0; k < sTotal; k++) {
+							dLon[k] *= M_PI / 180.0;
+						}
+					}
+					if (!fDegrees && fConvertLatToRadians) {
+						for (size_t k = 0; k < sTotal; k++) {
+							dLat[k] *= M_PI / 180.0;
+						}
+					}
 
-				ixNode++;
-			}
+					const long RowsPerBlock = 256;
+					const long lBlocks = (lRows + RowsPerBlock - 1) / RowsPerBlock;
+
+#pragma omp parallel
+					{
+						std::vector<double> dX(RowsPerBlock * lGridCorners);
+						std::vector<double> dY(RowsPerBlock * lGridCorners);
+						std::vector<double> dZ(RowsPerBlock * lGridCorners);
+
+#pragma omp for
+						for (long b = 0; b < lBlocks; b++) {
+							const long lBegin = b * RowsPerBlock;
+							const long lEnd = std::min(lBegin + RowsPerBlock, lRows);
+							const size_t sBegin = (size_t)(lBegin) * lGridCorners;
+							const size_t sCount = (size_t)(lEnd - lBegin) * lGridCorners;
+							const size_t sNode = (size_t)(lRowBegin) * lGridCorners + sBegin;
+
+							RLLtoXYZ_Batch(
+								sCount,
+								dLon + sBegin,
+								dLat + sBegin,
+								&(dX[0]),
+								&(dY[0]),
+								&(dZ[0]),
+								fDegrees);
+
+							for (size_t k = 0; k < sCount; k++) {
+								nodes[sNode + k].Set(dX[k], dY[k], dZ[k]);
+							}
+						}
+					}
+				});
 		}
 
 		// SCRIP does not reference a node table, so we must remove
 		// coincident nodes.
-		if (fRemoveCoincidentNodes) {
+		if (eCoincidentNodePolicy != CoincidentNodePolicy_Never) {
 			Announce("Removing coincident nodes");
 			RemoveCoincidentNodes();
 		}
@@ -1431,7 +2642,7 @@ void Mesh::Read(
 			_EXCEPTION1("Exodus Grid file \"%s\" is missing dimension "
 					"\"num_nodes\"", strFile.c_str());
 		}
-		int nNodeCount = dimNodes->size();
+		const long lNodeCount = dimNodes->size();
 
 		// Determine number of blocks
 		NcDim * dimElementBlocks = ncFile.get_dim("num_el_blk");
@@ -1439,7 +2650,7 @@ void Mesh::Read(
 			_EXCEPTION1("Exodus Grid file \"%s\" is missing dimension "
 					"\"num_el_blk\"", strFile.c_str());
 		}
-		int nElementBlocks = dimElementBlocks->size();
+		const long lElementBlocks = dimElementBlocks->size();
 
 		// Total number of elements
 		NcDim * dimElements = ncFile.get_dim("num_elem");
@@ -1447,50 +2658,51 @@ void Mesh::Read(
 			_EXCEPTION1("Exodus Grid file \"%s\" is missing dimension "
 					"\"num_elem\"", strFile.c_str());
 		}
-		int nTotalElementCount = dimElements->size();
+		const long lTotalElementCount = dimElements->size();
+
+		CheckMeshIndexRange(strFile, "nodes", lNodeCount);
+		CheckMeshIndexRange(strFile, "elements", lTotalElementCount);
 
 		// Output size
-		Announce("Mesh size: Nodes [%i] Elements [%i]",
-			nNodeCount, nTotalElementCount);
+		Announce("Mesh size: Nodes [%li] Elements [%li]",
+			lNodeCount, lTotalElementCount);
 
 		// Allocate faces
-		faces.resize(nTotalElementCount);
+		faces.resize(lTotalElementCount);
 
 		// Loop over all blocks
-		for (int n = 0; n < nElementBlocks; n++) {
+		for (long n = 0; n < lElementBlocks; n++) {
 
 			// Determine number of nodes per element in this block
 			char szNodesPerElement[ParamLenString];
-			snprintf(szNodesPerElement, ParamLenString, "num_nod_per_el%i", n+1);
+			snprintf(szNodesPerElement, ParamLenString, "num_nod_per_el%li", n+1);
 			NcDim * dimNodesPerElement = ncFile.get_dim(szNodesPerElement);
 			if (dimNodesPerElement == NULL) {
 				_EXCEPTION2("Exodus Grid file \"%s\" is missing dimension "
 					"\"%s\"", strFile.c_str(), szNodesPerElement);
 			}
-			int nNodesPerElement = dimNodesPerElement->size();
+			const int nNodesPerElement = static_cast<int>(dimNodesPerElement->size());
 
 			// Number of elements in block
 			char szElementsInBlock[ParamLenString];
-			snprintf(szElementsInBlock, ParamLenString, "num_el_in_blk%i", n+1);
+			snprintf(szElementsInBlock, ParamLenString, "num_el_in_blk%li", n+1);
 
 			NcDim * dimBlockElements = ncFile.get_dim(szElementsInBlock);
 			if (dimBlockElements == NULL) {
 				_EXCEPTION2("Exodus Grid file \"%s\" is missing dimension "
 						"\"%s\"", strFile.c_str(), szElementsInBlock);
 			}
-			int nElementCount = dimBlockElements->size();
+			const long lElementCount = dimBlockElements->size();
 
 			// Variables for each face
-			DataArray2D<int> iConnect(nElementCount, nNodesPerElement);
-			DataArray1D<int> iGlobalId(nElementCount);
-			DataArray2D<int> iEdgeType(nElementCount, nNodesPerElement);
+			DataArray1D<FileNodeIndex> iGlobalId(lElementCount);
 
-			DataArray1D<int> iParentA(nElementCount);
-			DataArray1D<int> iParentB(nElementCount);
+			DataArray1D<FileNodeIndex> iParentA(lElementCount);
+			DataArray1D<FileNodeIndex> iParentB(lElementCount);
 
-			// Load in nodes for all elements in this block
+			// Connectivity for all elements in this block
 			char szConnect[ParamLenString];
-			snprintf(szConnect, ParamLenString, "connect%i", n+1);
+			snprintf(szConnect, ParamLenString, "connect%li", n+1);
 
 			NcVar * varConnect = ncFile.get_var(szConnect);
 			if (varConnect == NULL) {
@@ -1498,22 +2710,16 @@ void Mesh::Read(
 						"\"%s\"", strFile.c_str(), szConnect);
 			}
 
-			varConnect->set_cur(0, 0);
-			varConnect->get(
-				&(iConnect[0][0]),
-				nElementCount,
-				nNodesPerElement);
-
 			// Earlier version didn't have global_id
 			if (flVersion == 4.98f) {
-				for (int i = 0; i < nElementCount; i++) {
+				for (long i = 0; i < lElementCount; i++) {
 					iGlobalId[i] = i + 1;
 				}
 
 			// Load in global id for all elements in this block
 			} else {
 				char szGlobalId[ParamLenString];
-				snprintf(szGlobalId, ParamLenString, "global_id%i", n+1);
+				snprintf(szGlobalId, ParamLenString, "global_id%li", n+1);
 
 				NcVar * varGlobalId = ncFile.get_var(szGlobalId);
 				if (varGlobalId == NULL) {
@@ -1524,7 +2730,7 @@ void Mesh::Read(
 				varGlobalId->set_cur((long)0);
 				varGlobalId->get(
 					&(iGlobalId[0]),
-					nElementCount);
+					lElementCount);
 			}
 
 			// Load in edge type for all elements in this block
@@ -1532,24 +2738,17 @@ void Mesh::Read(
 			if (flVersion == 4.98f) {
 				snprintf(szEdgeType, ParamLenString, "edge_type");
 			} else {
-				snprintf(szEdgeType, ParamLenString, "edge_type%i", n+1);
+				snprintf(szEdgeType, ParamLenString, "edge_type%li", n+1);
 			}
 
 			NcVar * varEdgeType = ncFile.get_var(szEdgeType);
-			if (varEdgeType != NULL) {
-				varEdgeType->set_cur(0, 0);
-				varEdgeType->get(
-					&(iEdgeType[0][0]),
-					nElementCount,
-					nNodesPerElement);
-			}
 
 			// Load in parent from A grid for all elements in this block
 			char szParentA[ParamLenString];
 			if (flVersion == 4.98f) {
 				snprintf(szParentA, ParamLenString, "face_source_1");
 			} else {
-				snprintf(szParentA, ParamLenString, "el_parent_a%i", n+1);
+				snprintf(szParentA, ParamLenString, "el_parent_a%li", n+1);
 			}
 
 			NcVar * varParentA = ncFile.get_var(szParentA);
@@ -1559,13 +2758,13 @@ void Mesh::Read(
 
 			} else if (varParentA != NULL) {
 				if (vecSourceFaceIx.size() == 0) {
-					vecSourceFaceIx.resize(nTotalElementCount);
+					vecSourceFaceIx.resize(lTotalElementCount);
 				}
 
 				varParentA->set_cur((long)0);
 				varParentA->get(
 					&(iParentA[0]),
-					nElementCount);
+					lElementCount);
 			}
 
 			// Load in parent from A grid for all elements in this block
@@ -1573,7 +2772,7 @@ void Mesh::Read(
 			if (flVersion == 4.98f) {
 				snprintf(szParentB, ParamLenString, "face_source_2");
 			} else {
-				snprintf(szParentB, ParamLenString, "el_parent_b%i", n+1);
+				snprintf(szParentB, ParamLenString, "el_parent_b%li", n+1);
 			}
 
 			NcVar * varParentB = ncFile.get_var(szParentB);
@@ -1583,47 +2782,92 @@ void Mesh::Read(
 
 			} else if (varParentB != NULL) {
 				if (vecTargetFaceIx.size() == 0) {
-					vecTargetFaceIx.resize(nTotalElementCount);
+					vecTargetFaceIx.resize(lTotalElementCount);
 				}
 
 				varParentB->set_cur((long)0);
 				varParentB->get(
 					&(iParentB[0]),
-					nElementCount);
+					lElementCount);
 			}
 
-			// Put local data into global structures
-			for (int i = 0; i < nElementCount; i++) {
-				if (iGlobalId[i] - 1 >= nTotalElementCount) {
-					_EXCEPTION2("global_id %i out of range [1,%i]",
-						iGlobalId[i], nTotalElementCount);
-				}
-				faces[iGlobalId[i]-1] = Face(nNodesPerElement);
-				for (int k = 0; k < nNodesPerElement; k++) {
-					faces[iGlobalId[i] - 1].SetNode(k, iConnect[i][k] - 1);
-					faces[iGlobalId[i] - 1].edges[k].type = 
-						static_cast<Edge::Type>(iEdgeType[i][k]);
-				}
-
-				if (vecSourceFaceIx.size() != 0) {
-					vecSourceFaceIx[iGlobalId[i] - 1] = iParentA[i] - 1;
-				}
-
-				if (vecTargetFaceIx.size() != 0) {
-					vecTargetFaceIx[iGlobalId[i] - 1] = iParentB[i] - 1;
+			// Validate global ids
+			for (long i = 0; i < lElementCount; i++) {
+				if ((iGlobalId[i] < 1) || (iGlobalId[i] > lTotalElementCount)) {
+					_EXCEPTION2("global_id %li out of range [1,%li]",
+						(long)(iGlobalId[i]), lTotalElementCount);
 				}
 			}
+
+			// Put local data into global structures.  Chunks of connectivity
+			// and edge types are read on an I/O thread while the previous
+			// chunk is decoded into Faces in parallel.
+			const long ElementsPerChunk = 65536;
+			const long lChunks =
+				(lElementCount + ElementsPerChunk - 1) / ElementsPerChunk;
+			const size_t sChunkSize =
+				(size_t)(ElementsPerChunk) * nNodesPerElement;
+
+			// Each buffer holds a chunk of connectivity followed by edge types
+			PipelinedChunkRead<FileNodeIndex>(
+				lChunks,
+				2 * sChunkSize,
+				[&](long c, FileNodeIndex * iBuffer) {
+					const long lBegin = c * ElementsPerChunk;
+					const long lCount =
+						std::min(ElementsPerChunk, lElementCount - lBegin);
+
+					varConnect->set_cur(lBegin, 0);
+					varConnect->get(iBuffer, lCount, nNodesPerElement);
+
+					if (varEdgeType != NULL) {
+						varEdgeType->set_cur(lBegin, 0);
+						varEdgeType->get(iBuffer + sChunkSize, lCount, nNodesPerElement);
+					} else {
+						memset(iBuffer + sChunkSize, 0, lCount * nNodesPerElement * sizeof(FileNodeIndex));
+					}
+				},
+				[&](long c, FileNodeIndex * iBuffer) {
+					const long lBegin = c * ElementsPerChunk;
+					const long lEnd = std::min(lBegin + ElementsPerChunk, lElementCount);
+
+					const FileNodeIndex * iConnect = iBuffer;
+					const FileNodeIndex * iEdgeType = iBuffer + sChunkSize;
+
+#pragma omp parallel for
+					for (long i = lBegin; i < lEnd; i++) {
+						const size_t sOffset = (size_t)(i - lBegin) * nNodesPerElement;
+
+						Face & face = faces[iGlobalId[i] - 1];
+						face = Face(nNodesPerElement);
+						for (int k = 0; k < nNodesPerElement; k++) {
+							face.SetNode(k, static_cast<NodeIndex>(iConnect[sOffset + k] - 1));
+							face.edges[k].type =
+								static_cast<Edge::Type>(iEdgeType[sOffset + k]);
+						}
+
+						if (vecSourceFaceIx.size() != 0) {
+							vecSourceFaceIx[iGlobalId[i] - 1] =
+								static_cast<FaceIndex>(iParentA[i] - 1);
+						}
+
+						if (vecTargetFaceIx.size() != 0) {
+							vecTargetFaceIx[iGlobalId[i] - 1] =
+								static_cast<FaceIndex>(iParentB[i] - 1);
+						}
+					}
+				});
 		}
 
 		// Earlier version had incorrect parent indexing
 		if (flVersion == 4.98f) {
 			if (vecSourceFaceIx.size() != 0) {
-				for (int i = 0; i < nTotalElementCount; i++) {
+				for (long i = 0; i < lTotalElementCount; i++) {
 					vecSourceFaceIx[i]++;
 				}
 			}
 			if (vecTargetFaceIx.size() != 0) {
-				for (int i = 0; i < nTotalElementCount; i++) {
+				for (long i = 0; i < lTotalElementCount; i++) {
 					vecTargetFaceIx[i]++;
 				}
 			}
@@ -1631,7 +2875,7 @@ void Mesh::Read(
 
 		// Load in node array
 		{
-			nodes.resize(nNodeCount);
+			nodes.resize(lNodeCount);
 
 			NcVar * varNodes = ncFile.get_var("coord");
 			if (varNodes == NULL) {
@@ -1639,520 +2883,2821 @@ void Mesh::Read(
 						"\"coord\"", strFile.c_str());
 			}
 
-			DataArray2D<double> dNodeCoords(3, nNodeCount);
-
-			// Load in node array
-			varNodes->set_cur(0, 0);
-			varNodes->get(&(dNodeCoords[0][0]), 3, nNodeCount);
-
-			for (int i = 0; i < nNodeCount; i++) {
-				nodes[i].x = static_cast<Real>(dNodeCoords[0][i]);
-				nodes[i].y = static_cast<Real>(dNodeCoords[1][i]);
-				nodes[i].z = static_cast<Real>(dNodeCoords[2][i]);
-			}
+			// Load in node array in chunks, overlapping reads with copies
+			const long NodesPerChunk = 262144;
+			const long lChunks =
+				(lNodeCount + NodesPerChunk - 1) / NodesPerChunk;
+
+			PipelinedChunkRead<double>(
+				lChunks,
+				3 * (size_t)(NodesPerChunk),
+				[&](long c, double * dBuffer) {
+					const long lBegin = c * NodesPerChunk;
+					const long lCount =
+						std::min(NodesPerChunk, lNodeCount - lBegin);
+
+					varNodes->set_cur(0, lBegin);
+					varNodes->get(dBuffer, 3, lCount);
+				},
+				[&](long c, double * dBuffer) {
+					const long lBegin = c * NodesPerChunk;
+					const long lCount = std::min(NodesPerChunk, lNodeCount - lBegin);
+
+					// Coordinates are stored [3][lCount] in the buffer
+					const double * dNodeX = dBuffer;
+					const double * dNodeY = dBuffer + lCount;
+					const double * dNodeZ = dBuffer + 2 * lCount;
+
+#pragma omp parallel for
+					for (long i = 0; i < lCount; i++) {
+						nodes[lBegin + i].x = static_cast<Real>(dNodeX[i]);
+						nodes[lBegin + i].y = static_cast<Real>(dNodeY[i]);
+						nodes[lBegin + i].z = static_cast<Real>(dNodeZ[i]);
+					}
+				});
 		}
 
-		// Remove coincident nodes.
-		RemoveCoincidentNodes();
+		// Exodus references a node table, so only remove coincident
+		// nodes if explicitly requested.
+		if (eCoincidentNodePolicy == CoincidentNodePolicy_Always) {
+			Announce("Removing coincident nodes");
+			RemoveCoincidentNodes();
+		}
 	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void Mesh::RemoveZeroEdges() {
-
-	// Remove zero edges from all Faces
-	for (int i = 0; i < faces.size(); i++) {
-		faces[i].RemoveZeroEdges();
-	}
+std::future<void> Mesh::ReadAsync(
+	const std::string & strFile,
+	CoincidentNodePolicy eCoincidentNodePolicy
+) {
+	return std::async(std::launch::async,
+		&Mesh::Read, this, strFile, eCoincidentNodePolicy);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void Mesh::Validate() const {
+///	<summary>
+///		Read the range of a coordinate variable, in degrees, from its
+///		actual_range or valid_min/valid_max attributes.
+///	</summary>
+static bool GetCoordinateRangeFromAttributes(
+	NcVar * var,
+	double dRange[2]
+) {
+	if (var == NULL) {
+		return false;
+	}
 
-	// Valid that Nodes have magnitude 1
-	for (int i = 0; i < nodes.size(); i++) {
-		double dMag = nodes[i].Magnitude();
+	NcAtt * attActualRange = var->get_att("actual_range");
+	NcAtt * attValidMin = var->get_att("valid_min");
+	NcAtt * attValidMax = var->get_att("valid_max");
 
-		if (fabs(dMag - 1.0) > ReferenceTolerance) {
-			_EXCEPTION5("Mesh validation failed: "
-				"Node[%i] of non-unit magnitude detected (%1.10e, %1.10e, %1.10e) = %1.10e",
-				i, nodes[i].x, nodes[i].y, nodes[i].z, dMag);
+	if ((attActualRange != NULL) && (attActualRange->num_vals() == 2)) {
+		dRange[0] = attActualRange->as_double(0);
+		dRange[1] = attActualRange->as_double(1);
+	} else if ((attValidMin != NULL) && (attValidMax != NULL)) {
+		dRange[0] = attValidMin->as_double(0);
+		dRange[1] = attValidMax->as_double(0);
+	} else {
+		return false;
+	}
 
+	NcAtt * attUnits = var->get_att("units");
+	if (attUnits != NULL) {
+		std::string strUnits = attUnits->as_string(0);
+		STLStringHelper::ToLower(strUnits);
+		if (strUnits.compare(0, 3, "rad") == 0) {
+			dRange[0] = RadToDeg(dRange[0]);
+			dRange[1] = RadToDeg(dRange[1]);
 		}
 	}
+	return true;
+}
 
-	// Validate that edges are oriented counter-clockwise
-	for (int i = 0; i < faces.size(); i++) {
-		const Face & face = faces[i];
+///////////////////////////////////////////////////////////////////////////////
 
-		const int nEdges = face.edges.size();
+///	<summary>
+///		Get the size of a dimension that must be present in a grid file.
+///	</summary>
+static long GetDimensionSize(
+	NcFile & ncFile,
+	const std::string & strFile,
+	const char * szDim
+) {
+	NcDim * dim = ncFile.get_dim(szDim);
+	if (dim == NULL) {
+		_EXCEPTION2("Grid file \"%s\" is missing dimension \"%s\"",
+			strFile.c_str(), szDim);
+	}
+	return dim->size();
+}
 
-		for (int j = 0; j < nEdges; j++) {
+///////////////////////////////////////////////////////////////////////////////
 
-			// Check for zero edges
-			for(;;) {
-				if (face.edges[j][0] == face.edges[j][1]) {
-					j++;
-				} else {
-					break;
-				}
-				if (j == nEdges) {
-					break;
-				}
-			}
+MeshFileInfo Mesh::Probe(
+	const std::string & strFile
+) {
+	const int ParamLenString = 33;
 
-			if (j == nEdges) {
-				break;
-			}
+	// Turn off fatal errors in NetCDF
+	NcError error(NcError::silent_nonfatal);
 
-			// Find the next non-zero edge
-			int jNext = (j + 1) % nEdges;
+	MeshFileInfo info;
 
-			for(;;) {
-				if (face.edges[jNext][0] == face.edges[jNext][1]) {
-					jNext++;
-				} else {
-					break;
-				}
-				if (jNext == nEdges) {
-					jNext = 0;
-				}
-				if (jNext == ((j + 1) % nEdges)) {
-					_EXCEPTIONT("Mesh validation failed: "
-						"No edge information on Face");
-				}
-			}
+	// Open the NetCDF file
+	if (strFile == "") {
+		_EXCEPTIONT("No grid file specified for probing");
+	}
+	NcFile ncFile(strFile.c_str(), NcFile::ReadOnly);
+	if (!ncFile.is_valid()) {
+		_EXCEPTION1("Unable to open grid file \"%s\" for reading",
+			strFile.c_str());
+	}
 
-			// Get edges
-			const Edge & edge0 = face.edges[j];
-			const Edge & edge1 = face.edges[(j + 1) % nEdges];
+	NcVar * varMeshTopology = NULL;
+	info.eFormat = DetectMeshFileFormat(ncFile, &varMeshTopology);
 
-			if (edge0[1] != edge1[0]) {
-				_EXCEPTIONT("Mesh validation failed: Edge cyclicity error");
-			}
+	NcVar * varLon = NULL;
+	NcVar * varLat = NULL;
 
-			const Node & node0 = nodes[edge0[0]];
-			const Node & node1 = nodes[edge0[1]];
-			const Node & node2 = nodes[edge1[1]];
+	switch (info.eFormat) {
+	case MeshFileInfo::Format_ICON:
+	{
+		info.lNodeCount = GetDimensionSize(ncFile, strFile, "vertex");
+		info.lFaceCount = GetDimensionSize(ncFile, strFile, "cell");
+		info.lMaxNodesPerFace = GetDimensionSize(ncFile, strFile, "nv");
+		varLon = ncFile.get_var("vlon");
+		varLat = ncFile.get_var("vlat");
+		break;
+	}
+	case MeshFileInfo::Format_UGRID:
+	{
+		NcAtt * attNodeCoordinates =
+			varMeshTopology->get_att("node_coordinates");
+		NcAtt * attFaceNodeConnectivity =
+			varMeshTopology->get_att("face_node_connectivity");
+		if ((attNodeCoordinates == NULL) || (attFaceNodeConnectivity == NULL)) {
+			_EXCEPTION2("UGRID mesh \"%s\" in file \"%s\" is missing "
+				"attribute \"node_coordinates\" or \"face_node_connectivity\"",
+				varMeshTopology->name(), strFile.c_str());
+		}
 
-			// Vectors along edges
-			Node nodeD1 = node0 - node1;
-			Node nodeD2 = node2 - node1;
+		std::istringstream iss(attNodeCoordinates->as_string(0));
+		std::string strLon;
+		std::string strLat;
+		iss >> strLon >> strLat;
+		varLon = ncFile.get_var(strLon.c_str());
+		varLat = ncFile.get_var(strLat.c_str());
+		if ((varLon == NULL) || (varLat == NULL) || (varLon->num_dims() != 1)) {
+			_EXCEPTION1("UGRID file \"%s\" has invalid node coordinates",
+				strFile.c_str());
+		}
+		NcAtt * attStandardName = varLon->get_att("standard_name");
+		if ((attStandardName != NULL) &&
+		    (std::string(attStandardName->as_string(0)) == "latitude")
+		) {
+			std::swap(varLon, varLat);
+		}
+		info.lNodeCount = varLon->get_dim(0)->size();
 
-			// Compute cross-product
-			Node nodeCross(CrossProduct(nodeD1, nodeD2));
+		NcVar * varFaceNodes =
+			ncFile.get_var(attFaceNodeConnectivity->as_string(0));
+		if ((varFaceNodes == NULL) || (varFaceNodes->num_dims() != 2)) {
+			_EXCEPTION1("UGRID file \"%s\" has invalid face_node_connectivity",
+				strFile.c_str());
+		}
 
-			// Dot cross product with radial vector
-			Real dDot = DotProduct(node1, nodeCross);
-/*
-#ifdef USE_EXACT_ARITHMETIC
-			FixedPoint dDotX = DotProductX(node1, nodeCross);
+		bool fTransposed = false;
+		NcAtt * attFaceDimension = varMeshTopology->get_att("face_dimension");
+		if ((attFaceDimension != NULL) &&
+		    (std::string(attFaceDimension->as_string(0)) ==
+		        varFaceNodes->get_dim(1)->name())
+		) {
+			fTransposed = true;
+		}
+		info.lFaceCount =
+			varFaceNodes->get_dim((fTransposed)?(1):(0))->size();
+		info.lMaxNodesPerFace =
+			varFaceNodes->get_dim((fTransposed)?(0):(1))->size();
+		break;
+	}
+	case MeshFileInfo::Format_MPAS:
+	{
+		info.lNodeCount = GetDimensionSize(ncFile, strFile, "nVertices");
+		info.lFaceCount = GetDimensionSize(ncFile, strFile, "nCells");
+		info.lMaxNodesPerFace = GetDimensionSize(ncFile, strFile, "maxEdges");
+		varLon = ncFile.get_var("lonVertex");
+		varLat = ncFile.get_var("latVertex");
+		break;
+	}
+	case MeshFileInfo::Format_SCRIP:
+	{
+		info.lFaceCount = GetDimensionSize(ncFile, strFile, "grid_size");
+		info.lMaxNodesPerFace = GetDimensionSize(ncFile, strFile, "grid_corners");
+		info.lNodeCount = info.lFaceCount * info.lMaxNodesPerFace;
+		varLon = ncFile.get_var("grid_corner_lon");
+		varLat = ncFile.get_var("grid_corner_lat");
+		break;
+	}
+	case MeshFileInfo::Format_Exodus:
+	{
+		info.lNodeCount = GetDimensionSize(ncFile, strFile, "num_nodes");
+		info.lFaceCount = GetDimensionSize(ncFile, strFile, "num_elem");
 
-			printf("%1.15e : ", nodeCross.x); nodeCross.fx.Print(); printf("\n");
+		long lElementBlocks = GetDimensionSize(ncFile, strFile, "num_el_blk");
+		for (long n = 0; n < lElementBlocks; n++) {
+			char szBuffer[ParamLenString];
 
-			if (fabs(nodeCross.x - nodeCross.fx.ToReal()) > ReferenceTolerance) {
-				printf("X0: %1.15e : ", node0.x); node0.fx.Print(); printf("\n");
-				printf("Y0: %1.15e : ", node0.y); node0.fy.Print(); printf("\n");
-				printf("Z0: %1.15e : ", node0.z); node0.fz.Print(); printf("\n");
-				printf("X1: %1.15e : ", node1.x); node1.fx.Print(); printf("\n");
-				printf("Y1: %1.15e : ", node1.y); node1.fy.Print(); printf("\n");
-				printf("Z1: %1.15e : ", node1.z); node1.fz.Print(); printf("\n");
-				printf("X2: %1.15e : ", node2.x); node2.fx.Print(); printf("\n");
-				printf("Y2: %1.15e : ", node2.y); node2.fy.Print(); printf("\n");
-				printf("Z2: %1.15e : ", node2.z); node2.fz.Print(); printf("\n");
+			snprintf(szBuffer, ParamLenString, "num_el_in_blk%li", n+1);
+			info.vecBlockFaceCount.push_back(
+				GetDimensionSize(ncFile, strFile, szBuffer));
 
-				printf("X1: %1.15e : ", nodeD1.x); nodeD1.fx.Print(); printf("\n");
-				printf("Y1: %1.15e : ", nodeD1.y); nodeD1.fy.Print(); printf("\n");
-				printf("Z1: %1.15e : ", nodeD1.z); nodeD1.fz.Print(); printf("\n");
-				printf("X2: %1.15e : ", nodeD2.x); nodeD2.fx.Print(); printf("\n");
-				printf("Y2: %1.15e : ", nodeD2.y); nodeD2.fy.Print(); printf("\n");
-				printf("Z2: %1.15e : ", nodeD2.z); nodeD2.fz.Print(); printf("\n");
-				_EXCEPTIONT("FixedPoint mismatch (X)");
-			}
-			if (fabs(nodeCross.y - nodeCross.fy.ToReal()) > ReferenceTolerance) {
-				_EXCEPTIONT("FixedPoint mismatch (Y)");
-			}
-			if (fabs(nodeCross.z - nodeCross.fz.ToReal()) > ReferenceTolerance) {
-				_EXCEPTIONT("FixedPoint mismatch (Z)");
-			}
+			snprintf(szBuffer, ParamLenString, "num_nod_per_el%li", n+1);
+			info.vecBlockNodesPerFace.push_back(
+				GetDimensionSize(ncFile, strFile, szBuffer));
 
-#endif
-*/
-			if (dDot > 0.0) {
-				printf("\nError detected (orientation):\n");
-				printf("  Face %i, Edge %i, Orientation %1.5e\n",
-					i, j, dDot);
+			info.lMaxNodesPerFace = std::max(
+				info.lMaxNodesPerFace, info.vecBlockNodesPerFace.back());
+		}
+		break;
+	}
+	default:
+		_EXCEPTION1("Unable to determine format of grid file \"%s\"",
+			strFile.c_str());
+	}
 
-				printf("  (x,y,z):\n");
-				printf("    n0: %1.5e %1.5e %1.5e\n", node0.x, node0.y, node0.z);
-				printf("    n1: %1.5e %1.5e %1.5e\n", node1.x, node1.y, node1.z);
-				printf("    n2: %1.5e %1.5e %1.5e\n", node2.x, node2.y, node2.z);
+	// Formats without element blocks are reported as a single block
+	if (info.vecBlockFaceCount.size() == 0) {
+		info.vecBlockFaceCount.push_back(info.lFaceCount);
+		info.vecBlockNodesPerFace.push_back(info.lMaxNodesPerFace);
+	}
 
-				Real dR0 = sqrt(
-					node0.x * node0.x + node0.y * node0.y + node0.z * node0.z);
-				Real dLat0 = asin(node0.z / dR0);
-				Real dLon0 = atan2(node0.y, node0.x);
+	// Coordinate ranges are only available from attributes
+	info.fHasCoordinateRange =
+		GetCoordinateRangeFromAttributes(varLon, info.dLonRange) &&
+		GetCoordinateRangeFromAttributes(varLat, info.dLatRange);
 
-				Real dR1 = sqrt(
-					node1.x * node1.x + node1.y * node1.y + node1.z * node1.z);
-				Real dLat1 = asin(node1.z / dR1);
-				Real dLon1 = atan2(node1.y, node1.x);
+	return info;
+}
 
-				Real dR2 = sqrt(
-					node2.x * node2.x + node2.y * node2.y + node2.z * node2.z);
-				Real dLat2 = asin(node2.z / dR2);
-				Real dLon2 = atan2(node2.y, node2.x);
+///////////////////////////////////////////////////////////////////////////////
 
-				printf("  (lambda, phi):\n");
-				printf("    n0: %1.5e %1.5e\n", dLon0, dLat0);
-				printf("    n1: %1.5e %1.5e\n", dLon1, dLat1);
-				printf("    n2: %1.5e %1.5e\n", dLon2, dLat2);
+void Mesh::RestrictToRegion(
+	const MeshRegion & region
+) {
+	// Flag Faces that intersect the region
+	std::vector<char> fFaceInside(faces.size());
 
-				printf("  X-Product:\n");
-				printf("    %1.5e %1.5e %1.5e\n",
-					nodeCross.x, nodeCross.y, nodeCross.z);
+#pragma omp parallel
+	{
+		NodeVector vecCorners;
 
-				_EXCEPTIONT(
-					"Mesh validation failed: Clockwise or concave face detected");
+#pragma omp for
+		for (long i = 0; i < (long)(faces.size()); i++) {
+			const Face & face = faces[i];
+			if (face.edges.size() == 0) {
+				fFaceInside[i] = 0;
+				continue;
+			}
+			vecCorners.resize(face.edges.size());
+			for (size_t j = 0; j < face.edges.size(); j++) {
+				vecCorners[j] = nodes[face[j]];
 			}
+			fFaceInside[i] =
+				(region.IntersectsFace(
+					&(vecCorners[0]),
+					static_cast<int>(vecCorners.size())))?(1):(0);
 		}
 	}
-}
-
-///////////////////////////////////////////////////////////////////////////////
-// General purpose functions
-///////////////////////////////////////////////////////////////////////////////
 
-bool IsPositivelyOrientedEdge(
-	const Node & nodeBegin,
-	const Node & nodeEnd
-) {
-	const Real Tolerance = ReferenceTolerance;
+	// Keep Faces that intersect the region
+	std::vector<NodeIndex> vecNodeMap(nodes.size(), InvalidNode);
 
-	if ((fabs(nodeBegin.x - nodeEnd.x) < Tolerance) &&
-		(fabs(nodeBegin.y - nodeEnd.y) < Tolerance) &&
-		(fabs(nodeBegin.z - nodeEnd.z) < Tolerance)
-	) {
-		_EXCEPTIONT("Latitude line of zero length");
+	FaceVector facesRegion;
+	std::vector<FaceIndex> vecFaceIx;
+	for (size_t i = 0; i < faces.size(); i++) {
+		if (!fFaceInside[i]) {
+			continue;
+		}
+		const Face & face = faces[i];
+		for (size_t j = 0; j < face.edges.size(); j++) {
+			vecNodeMap[face[j]] = 0;
+		}
+		facesRegion.push_back(face);
+		vecFaceIx.push_back(static_cast<FaceIndex>(i));
 	}
 
-	// Both nodes in positive y half-plane
-	if ((nodeBegin.y >= 0.0) && (nodeEnd.y >= 0.0)) {
-		if (nodeEnd.x < nodeBegin.x) {
-			return true;
-		} else {
-			return false;
+	// Renumber nodes in their original order
+	NodeVector nodesRegion;
+	std::vector<NodeIndex> vecNodeIx;
+	for (size_t i = 0; i < nodes.size(); i++) {
+		if (vecNodeMap[i] != InvalidNode) {
+			vecNodeMap[i] = static_cast<NodeIndex>(nodesRegion.size());
+			nodesRegion.push_back(nodes[i]);
+			vecNodeIx.push_back(static_cast<NodeIndex>(i));
 		}
-
-	// Both nodes in negative y half-plane
-	} else if ((nodeBegin.y <= 0.0) && (nodeEnd.y <= 0.0)) {
-		if (nodeEnd.x > nodeBegin.x) {
-			return true;
-		} else {
-			return false;
+	}
+	for (size_t f = 0; f < facesRegion.size(); f++) {
+		Face & face = facesRegion[f];
+		for (int j = 0; j < (int)(face.edges.size()); j++) {
+			face.SetNode(j, vecNodeMap[face[j]]);
 		}
+	}
 
-	// Both nodes in positive x half-plane
-	} else if ((nodeBegin.x >= 0.0) && (nodeEnd.x >= 0.0)) {
-		if (nodeEnd.y > nodeBegin.y) {
-			return true;
-		} else {
-			return false;
+	// Restrict the mask and map back to indices in the original mesh,
+	// composing with any existing map
+	if (vecMask.GetRows() == faces.size()) {
+		DataArray1D<int> vecMaskRegion(vecFaceIx.size());
+		for (size_t f = 0; f < vecFaceIx.size(); f++) {
+			vecMaskRegion[f] = vecMask[vecFaceIx[f]];
 		}
-
-	// Both nodes in negative x half-plane
-	} else if ((nodeBegin.x <= 0.0) && (nodeEnd.x <= 0.0)) {
-		if (nodeEnd.y < nodeBegin.y) {
-			return true;
-		} else {
-			return false;
+		vecMask = vecMaskRegion;
+	}
+	if (vecGlobalFaceIx.size() == faces.size()) {
+		for (size_t f = 0; f < vecFaceIx.size(); f++) {
+			vecFaceIx[f] = vecGlobalFaceIx[vecFaceIx[f]];
 		}
-
-	// Arc length too large
-	} else {
-		_EXCEPTIONT("Arc length too large to determine orientation.");
 	}
+	if (vecGlobalNodeIx.size() == nodes.size()) {
+		for (size_t i = 0; i < vecNodeIx.size(); i++) {
+			vecNodeIx[i] = vecGlobalNodeIx[vecNodeIx[i]];
+		}
+	}
+
+	nodes.swap(nodesRegion);
+	faces.swap(facesRegion);
+	vecGlobalFaceIx.swap(vecFaceIx);
+	vecGlobalNodeIx.swap(vecNodeIx);
+
+	edgemap.clear();
+	revnodearray.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void GetLocalDirection(
-	const Node & nodeBegin,
-	const Node & nodeEnd,
-	const Node & nodeRef,
-	const Edge::Type edgetype,
-	Node & nodeDir
+void Mesh::ReadRegion(
+	const std::string & strFile,
+	const MeshRegion & region,
+	CoincidentNodePolicy eCoincidentNodePolicy
 ) {
+	const int ParamLenString = 33;
 
-	// Direction along a great circle arc
-	if (edgetype == Edge::Type_GreatCircleArc) {
+	// Turn off fatal errors in NetCDF
+	NcError error(NcError::silent_nonfatal);
 
-		// Cartesian direction
-		nodeDir = nodeEnd - nodeBegin;
+	// Open the NetCDF file
+	if (strFile == "") {
+		_EXCEPTIONT("No grid file specified for reading");
+	}
+	NcFile ncFile(strFile.c_str(), NcFile::ReadOnly);
+	if (!ncFile.is_valid()) {
+		_EXCEPTION1("Unable to open grid file \"%s\" for reading",
+			strFile.c_str());
+	}
+
+	MeshFileInfo::Format eFormat = DetectMeshFileFormat(ncFile);
+
+	// Input from a NetCDF SCRIP file
+	if (eFormat == MeshFileInfo::Format_SCRIP) {
+		Announce("SCRIP Format File detected");
+
+		Clear();
+		vecGlobalFaceIx.clear();
+		vecGlobalNodeIx.clear();
+		strFileName = strFile;
+
+		NcVar * varGridCornerLat = ncFile.get_var("grid_corner_lat");
+		NcVar * varGridCornerLon = ncFile.get_var("grid_corner_lon");
+
+		if ((varGridCornerLat == NULL) || (varGridCornerLon == NULL)) {
+			_EXCEPTION1("SCRIP Grid file \"%s\" is missing variable "
+				"\"grid_corner_lat\" or \"grid_corner_lon\"", strFile.c_str());
+		}
+
+		const long lGridSize = GetDimensionSize(ncFile, strFile, "grid_size");
+		const long lGridCorners = GetDimensionSize(ncFile, strFile, "grid_corners");
+
+		const bool fDegrees[2] = {
+			IsSCRIPCoordinateInDegrees(varGridCornerLon),
+			IsSCRIPCoordinateInDegrees(varGridCornerLat)};
+
+		// Check the mask variable before reading any corners
+		NcVar * varMask = ncFile.get_var("grid_imask");
+		if (varMask != NULL) {
+			if (varMask->num_dims() != 1) {
+				_EXCEPTIONT("Unknown format of variable \"grid_imask\": "
+					"More than one dimension");
+			}
+			if (varMask->get_dim(0)->size() != lGridSize) {
+				_EXCEPTIONT("Unknown format of variable \"grid_imask\": "
+					"Incorrect first dimension size");
+			}
+		}
+
+		// Corner rows are read in chunks and converted to Cartesian
+		// coordinates in dX, dY and dZ
+		const long RowsPerChunk = 65536;
+		const long lChunkMax = std::min(RowsPerChunk, lGridSize);
+		const size_t sChunkCorners = (size_t)(lChunkMax) * lGridCorners;
+
+		std::vector<double> dCornerLon(sChunkCorners);
+		std::vector<double> dCornerLat(sChunkCorners);
+		std::vector<double> dX(sChunkCorners);
+		std::vector<double> dY(sChunkCorners);
+		std::vector<double> dZ(sChunkCorners);
+		std::vector<char> fFaceInside(lChunkMax);
+		std::vector<char> fFaceCandidate(lChunkMax);
+
+		auto ReadCornerRows = [&](long r, long lChunk) {
+			const size_t sTotal = (size_t)(lChunk) * lGridCorners;
+
+			varGridCornerLon->set_cur(r, 0);
+			varGridCornerLon->get(&(dCornerLon[0]), lChunk, lGridCorners);
+
+			varGridCornerLat->set_cur(r, 0);
+			varGridCornerLat->get(&(dCornerLat[0]), lChunk, lGridCorners);
+
+			// Mixed units are converted to radians up front
+			if (fDegrees[0] != fDegrees[1]) {
+				std::vector<double> & dCoord =
+					(fDegrees[0])?(dCornerLon):(dCornerLat);
+				for (size_t k = 0; k < sTotal; k++) {
+					dCoord[k] = DegToRad(dCoord[k]);
+				}
+			}
+
+			RLLtoXYZ_Batch(
+				sTotal,
+				&(dCornerLon[0]),
+				&(dCornerLat[0]),
+				&(dX[0]),
+				&(dY[0]),
+				&(dZ[0]),
+				fDegrees[0] && fDegrees[1]);
+		};
+
+		// Keep the corners of Faces in rows [r, r + lChunk) of the buffer
+		// that intersect the region, skipping rows not flagged in
+		// fRowCandidate if it is given.  Corner j of the n-th selected Face
+		// is node n * lGridCorners + j.
+		auto SelectRows = [&](long r, long lChunk, const char * fRowCandidate) {
+#pragma omp parallel
+			{
+				NodeVector vecCorners(lGridCorners);
+
+#pragma omp for
+				for (long i = 0; i < lChunk; i++) {
+					if ((fRowCandidate != NULL) && (!fRowCandidate[i])) {
+						fFaceInside[i] = 0;
+						continue;
+					}
+					for (long j = 0; j < lGridCorners; j++) {
+						const size_t k = (size_t)(i) * lGridCorners + j;
+						vecCorners[j].Set(dX[k], dY[k], dZ[k]);
+					}
+					fFaceInside[i] =
+						(region.IntersectsFace(
+							&(vecCorners[0]),
+							static_cast<int>(lGridCorners)))?(1):(0);
+				}
+			}
+
+			for (long i = 0; i < lChunk; i++) {
+				if (!fFaceInside[i]) {
+					continue;
+				}
+				vecGlobalFaceIx.push_back(static_cast<FaceIndex>(r + i));
+				for (long j = 0; j < lGridCorners; j++) {
+					const size_t k = (size_t)(i) * lGridCorners + j;
+					nodes.push_back(Node(dX[k], dY[k], dZ[k]));
+				}
+			}
+		};
+
+		NcVar * varGridCenterLat = ncFile.get_var("grid_center_lat");
+		NcVar * varGridCenterLon = ncFile.get_var("grid_center_lon");
+
+		if ((varGridCenterLat != NULL) && (varGridCenterLon != NULL)) {
+			if ((varGridCenterLat->num_dims() != 1) ||
+			    (varGridCenterLon->num_dims() != 1) ||
+			    (varGridCenterLat->get_dim(0)->size() != lGridSize) ||
+			    (varGridCenterLon->get_dim(0)->size() != lGridSize)
+			) {
+				_EXCEPTION1("SCRIP Grid file \"%s\" variables "
+					"\"grid_center_lat\" and \"grid_center_lon\" must have "
+					"dimension \"grid_size\"", strFile.c_str());
+			}
+
+			// Read the centers in chunks, using the corner buffers
+			NodeVector vecCenters(lGridSize);
+
+			const bool fCenterDegrees[2] = {
+				IsSCRIPCoordinateInDegrees(varGridCenterLon),
+				IsSCRIPCoordinateInDegrees(varGridCenterLat)};
+
+			for (long r = 0; r < lGridSize; r += (long)(sChunkCorners)) {
+				const long lChunk = std::min((long)(sChunkCorners), lGridSize - r);
+
+				varGridCenterLon->set_cur(r);
+				varGridCenterLon->get(&(dCornerLon[0]), lChunk);
+
+				varGridCenterLat->set_cur(r);
+				varGridCenterLat->get(&(dCornerLat[0]), lChunk);
+
+				for (long i = 0; i < lChunk; i++) {
+					double dLon = dCornerLon[i];
+					double dLat = dCornerLat[i];
+					if (fCenterDegrees[0]) {
+						dLon = DegToRad(dLon);
+					}
+					if (fCenterDegrees[1]) {
+						dLat = DegToRad(dLat);
+					}
+					RLLtoXYZ_Rad(
+						dLon, dLat,
+						vecCenters[r + i].x, vecCenters[r + i].y, vecCenters[r + i].z);
+				}
+			}
+
+			// Faces whose center lies within dMargin of the region are
+			// candidates, and only their corner rows are read.  The margin
+			// starts at twice the mean cell size and grows to the largest
+			// cell radius (center to corner) among the candidates, until no
+			// candidate is larger than the margin.  Faces away from the
+			// region are assumed to be no larger than those near it.
+			const char CandidateNone = 0;
+			const char CandidateNew = 1;
+			const char CandidateRead = 2;
+
+			std::vector<char> cCandidate(lGridSize, CandidateNone);
+
+			const long RowGapMax = 64;
+
+			double dMargin = 2.0 * sqrt(4.0 * M_PI / (double)(lGridSize));
+			double dMaxRadius = 0.0;
+			long lCandidates = 0;
+
+			for (;;) {
+#pragma omp parallel for
+				for (long i = 0; i < lGridSize; i++) {
+					if ((cCandidate[i] == CandidateNone) &&
+					    (region.MayIntersectCap(vecCenters[i], dMargin))
+					) {
+						cCandidate[i] = CandidateNew;
+					}
+				}
+
+				// Read runs of rows that contain new candidates, merging
+				// runs separated by short gaps
+				long lNew = 0;
+				long r = 0;
+				while (r < lGridSize) {
+					if (cCandidate[r] != CandidateNew) {
+						r++;
+						continue;
+					}
+					long rEnd = r + 1;
+					for (long i = r + 1;
+						(i < lGridSize) && (i < r + lChunkMax) && (i < rEnd + RowGapMax);
+						i++
+					) {
+						if (cCandidate[i] == CandidateNew) {
+							rEnd = i + 1;
+						}
+					}
+
+					const long lChunk = rEnd - r;
+					ReadCornerRows(r, lChunk);
+
+					for (long i = 0; i < lChunk; i++) {
+						if (cCandidate[r + i] != CandidateNew) {
+							continue;
+						}
+						lNew++;
+
+						const Node & nodeCenter = vecCenters[r + i];
+						for (long j = 0; j < lGridCorners; j++) {
+							const size_t k = (size_t)(i) * lGridCorners + j;
+							const Node nodeCorner(dX[k], dY[k], dZ[k]);
+							dMaxRadius = std::max(dMaxRadius,
+								atan2(
+									CrossProduct(nodeCenter, nodeCorner).Magnitude(),
+									DotProduct(nodeCenter, nodeCorner)));
+						}
+					}
+
+					for (long i = 0; i < lChunk; i++) {
+						fFaceCandidate[i] = (cCandidate[r + i] == CandidateNew)?(1):(0);
+						if (fFaceCandidate[i]) {
+							cCandidate[r + i] = CandidateRead;
+						}
+					}
+
+					SelectRows(r, lChunk, &(fFaceCandidate[0]));
+
+					r = rEnd;
+				}
+
+				lCandidates += lNew;
+
+				if ((lNew == 0) || (dMaxRadius <= dMargin)) {
+					break;
+				}
+				dMargin = dMaxRadius;
+			}
+
+			Announce("Read corners of %li candidate Faces (margin %1.5e)",
+				lCandidates, dMargin);
+
+			// Candidates are found out of order as the margin grows
+			const size_t sSelected = vecGlobalFaceIx.size();
+			std::vector<size_t> vecOrder(sSelected);
+			for (size_t f = 0; f < sSelected; f++) {
+				vecOrder[f] = f;
+			}
+			std::sort(vecOrder.begin(), vecOrder.end(),
+				[&](size_t a, size_t b) {
+					return (vecGlobalFaceIx[a] < vecGlobalFaceIx[b]);
+				});
+
+			std::vector<FaceIndex> vecGlobalFaceIxSorted(sSelected);
+			NodeVector nodesSorted(nodes.size());
+			for (size_t f = 0; f < sSelected; f++) {
+				vecGlobalFaceIxSorted[f] = vecGlobalFaceIx[vecOrder[f]];
+				for (long j = 0; j < lGridCorners; j++) {
+					nodesSorted[f * lGridCorners + j] =
+						nodes[vecOrder[f] * lGridCorners + j];
+				}
+			}
+			vecGlobalFaceIx.swap(vecGlobalFaceIxSorted);
+			nodes.swap(nodesSorted);
+
+		// Without centers, stream all corner rows
+		} else {
+			for (long r = 0; r < lGridSize; r += RowsPerChunk) {
+				const long lChunk = std::min(RowsPerChunk, lGridSize - r);
+				ReadCornerRows(r, lChunk);
+				SelectRows(r, lChunk, NULL);
+			}
+		}
+
+		const size_t sFaces = vecGlobalFaceIx.size();
+
+		CheckMeshIndexRange(strFile, "face corners", (long)(nodes.size()));
+
+		faces.resize(sFaces);
+		for (size_t f = 0; f < sFaces; f++) {
+			faces[f] = Face(static_cast<int>(lGridCorners));
+			for (long j = 0; j < lGridCorners; j++) {
+				faces[f].SetNode(j, static_cast<NodeIndex>(f * lGridCorners + j));
+			}
+		}
+
+		// Load mask variable
+		if (varMask != NULL) {
+			DataArray1D<int> vecMaskAll(lGridSize);
+			varMask->get(&(vecMaskAll[0]), lGridSize);
+
+			vecMask.Allocate(sFaces);
+			for (size_t f = 0; f < sFaces; f++) {
+				vecMask[f] = vecMaskAll[vecGlobalFaceIx[f]];
+			}
+		}
+
+		// SCRIP does not reference a node table, so we must remove
+		// coincident nodes.
+		if (eCoincidentNodePolicy != CoincidentNodePolicy_Never) {
+			Announce("Removing coincident nodes");
+			RemoveCoincidentNodes();
+		}
+
+		Announce("Region size: Nodes [%lu] Elements [%lu] of [%li]",
+			nodes.size(), faces.size(), lGridSize);
+
+	// Input from a NetCDF Exodus file
+	} else if (eFormat == MeshFileInfo::Format_Exodus) {
+		Announce("Exodus Format File detected");
+
+		Clear();
+		vecGlobalFaceIx.clear();
+		vecGlobalNodeIx.clear();
+		strFileName = strFile;
+
+		NcAtt * attVersion = ncFile.get_att("version");
+		if (attVersion == NULL) {
+			_EXCEPTION1("Exodus Grid file \"%s\" is missing attribute "
+					"\"version\"", strFile.c_str());
+		}
+		float flVersion = attVersion->as_float(0);
+
+		const long lNodeCount = GetDimensionSize(ncFile, strFile, "num_nodes");
+		const long lTotalElementCount = GetDimensionSize(ncFile, strFile, "num_elem");
+		const long lElementBlocks = GetDimensionSize(ncFile, strFile, "num_el_blk");
+
+		CheckMeshIndexRange(strFile, "nodes", lNodeCount);
+		CheckMeshIndexRange(strFile, "elements", lTotalElementCount);
+
+		NcVar * varNodes = ncFile.get_var("coord");
+		if (varNodes == NULL) {
+			_EXCEPTION1("Exodus Grid file \"%s\" is missing variable "
+					"\"coord\"", strFile.c_str());
+		}
+
+		const long NodesPerChunk = 262144;
+		const long ElementsPerChunk = 65536;
+		const long NodeGapMax = 1024;
+
+		DataArray2D<double> dNodeCoords(3, std::min(NodesPerChunk, lNodeCount));
+
+		// Read the coordinates of the nodes in vecIx (sorted, unique,
+		// zero-based) into vecCoords, in runs of nearby nodes so that
+		// only referenced parts of the coordinate array are read
+		auto ReadNodeCoords = [&](
+			const std::vector<NodeIndex> & vecIx,
+			NodeVector & vecCoords
+		) {
+			vecCoords.resize(vecIx.size());
+
+			size_t s = 0;
+			while (s < vecIx.size()) {
+				const long lBegin = vecIx[s];
+				size_t sEnd = s + 1;
+				while ((sEnd < vecIx.size()) &&
+				       (vecIx[sEnd] - vecIx[sEnd-1] <= NodeGapMax) &&
+				       (vecIx[sEnd] - lBegin < NodesPerChunk)
+				) {
+					sEnd++;
+				}
+				const long lChunk = vecIx[sEnd-1] - lBegin + 1;
+
+				varNodes->set_cur(0, lBegin);
+				varNodes->get(&(dNodeCoords[0][0]), 3, lChunk);
+
+				// Coordinates are stored [3][lChunk] in the buffer
+				const double * dCoordX = &(dNodeCoords[0][0]);
+				const double * dCoordY = dCoordX + lChunk;
+				const double * dCoordZ = dCoordY + lChunk;
+
+				for (; s < sEnd; s++) {
+					const long i = vecIx[s] - lBegin;
+					vecCoords[s].Set(dCoordX[i], dCoordY[i], dCoordZ[i]);
+				}
+			}
+		};
+
+		// Nodes referenced by the current chunk of connectivity
+		std::vector<NodeIndex> vecChunkNodeIx;
+		NodeVector vecChunkNodeCoords;
+		std::vector<size_t> vecChunkConnect;
+
+		// Read connectivity in chunks, keeping Faces that intersect the
+		// region; selected Faces are stored with their global index and
+		// zero-based node indices in the file
+		std::vector< std::pair<FaceIndex, Face> > vecSelected;
+
+		for (long b = 0; b < lElementBlocks; b++) {
+			char szBuffer[ParamLenString];
+
+			snprintf(szBuffer, ParamLenString, "num_nod_per_el%li", b+1);
+			const long lNodesPerElement =
+				GetDimensionSize(ncFile, strFile, szBuffer);
+
+			snprintf(szBuffer, ParamLenString, "num_el_in_blk%li", b+1);
+			const long lElementCount =
+				GetDimensionSize(ncFile, strFile, szBuffer);
+
+			snprintf(szBuffer, ParamLenString, "connect%li", b+1);
+			NcVar * varConnect = ncFile.get_var(szBuffer);
+			if (varConnect == NULL) {
+				_EXCEPTION2("Exodus Grid file \"%s\" is missing variable "
+						"\"%s\"", strFile.c_str(), szBuffer);
+			}
+
+			// Earlier version didn't have global_id
+			NcVar * varGlobalId = NULL;
+			if (flVersion != 4.98f) {
+				snprintf(szBuffer, ParamLenString, "global_id%li", b+1);
+				varGlobalId = ncFile.get_var(szBuffer);
+				if (varGlobalId == NULL) {
+					_EXCEPTION2("Exodus Grid file \"%s\" is missing variable "
+							"\"%s\"", strFile.c_str(), szBuffer);
+				}
+			}
+
+			if (flVersion == 4.98f) {
+				snprintf(szBuffer, ParamLenString, "edge_type");
+			} else {
+				snprintf(szBuffer, ParamLenString, "edge_type%li", b+1);
+			}
+			NcVar * varEdgeType = ncFile.get_var(szBuffer);
+
+			const long lChunkMax = std::min(ElementsPerChunk, lElementCount);
+
+			DataArray2D<FileNodeIndex> iConnect(lChunkMax, lNodesPerElement);
+			DataArray2D<int> iEdgeType(lChunkMax, lNodesPerElement);
+			DataArray1D<FileNodeIndex> iGlobalId(lChunkMax);
+			std::vector<char> fFaceInside(lChunkMax);
+
+			for (long e = 0; e < lElementCount; e += ElementsPerChunk) {
+				const long lChunk = std::min(ElementsPerChunk, lElementCount - e);
+
+				varConnect->set_cur(e, 0);
+				varConnect->get(&(iConnect[0][0]), lChunk, lNodesPerElement);
+
+				if (varGlobalId != NULL) {
+					varGlobalId->set_cur(e);
+					varGlobalId->get(&(iGlobalId[0]), lChunk);
+				} else {
+					for (long i = 0; i < lChunk; i++) {
+						iGlobalId[i] = e + i + 1;
+					}
+				}
+
+				if (varEdgeType != NULL) {
+					varEdgeType->set_cur(e, 0);
+					varEdgeType->get(&(iEdgeType[0][0]), lChunk, lNodesPerElement);
+				}
+
+				// Connectivity within a chunk is in the layout of the buffer
+				const FileNodeIndex * pConnect = &(iConnect[0][0]);
+				const int * pEdgeType = &(iEdgeType[0][0]);
+
+				for (long k = 0; k < lChunk * lNodesPerElement; k++) {
+					long lNode = pConnect[k] - 1;
+					if ((lNode < 0) || (lNode >= lNodeCount)) {
+						_EXCEPTION3("Exodus Grid file \"%s\" node index %li "
+							"out of range [1,%li]", strFile.c_str(),
+							lNode + 1, lNodeCount);
+					}
+				}
+
+				// Gather the coordinates of the nodes of this chunk.  Nodes
+				// are usually numbered with locality, in which case the
+				// range they span is read directly.
+				const long lChunkConnect = lChunk * lNodesPerElement;
+
+				long lMinNode = lNodeCount;
+				long lMaxNode = 0;
+				for (long k = 0; k < lChunkConnect; k++) {
+					lMinNode = std::min(lMinNode, (long)(pConnect[k] - 1));
+					lMaxNode = std::max(lMaxNode, (long)(pConnect[k] - 1));
+				}
+
+				vecChunkConnect.resize(lChunkConnect);
+
+				if (lMaxNode - lMinNode < 2 * lChunkConnect) {
+					vecChunkNodeIx.resize(lMaxNode - lMinNode + 1);
+					for (size_t i = 0; i < vecChunkNodeIx.size(); i++) {
+						vecChunkNodeIx[i] = static_cast<NodeIndex>(lMinNode + i);
+					}
+					for (long k = 0; k < lChunkConnect; k++) {
+						vecChunkConnect[k] = (size_t)(pConnect[k] - 1 - lMinNode);
+					}
+
+				} else {
+					vecChunkNodeIx.resize(lChunkConnect);
+					for (long k = 0; k < lChunkConnect; k++) {
+						vecChunkNodeIx[k] = static_cast<NodeIndex>(pConnect[k] - 1);
+					}
+					std::sort(vecChunkNodeIx.begin(), vecChunkNodeIx.end());
+					vecChunkNodeIx.erase(
+						std::unique(vecChunkNodeIx.begin(), vecChunkNodeIx.end()),
+						vecChunkNodeIx.end());
+
+					for (long k = 0; k < lChunkConnect; k++) {
+						vecChunkConnect[k] =
+							std::lower_bound(
+								vecChunkNodeIx.begin(),
+								vecChunkNodeIx.end(),
+								static_cast<NodeIndex>(pConnect[k] - 1))
+							- vecChunkNodeIx.begin();
+					}
+				}
+
+				ReadNodeCoords(vecChunkNodeIx, vecChunkNodeCoords);
+
+#pragma omp parallel
+				{
+					NodeVector vecCorners(lNodesPerElement);
+
+#pragma omp for
+					for (long i = 0; i < lChunk; i++) {
+						for (long k = 0; k < lNodesPerElement; k++) {
+							vecCorners[k] = vecChunkNodeCoords[
+								vecChunkConnect[i * lNodesPerElement + k]];
+						}
+						fFaceInside[i] =
+							(region.IntersectsFace(
+								&(vecCorners[0]),
+								static_cast<int>(lNodesPerElement)))?(1):(0);
+					}
+				}
+
+				for (long i = 0; i < lChunk; i++) {
+					const FileNodeIndex * pFaceConnect = pConnect + i * lNodesPerElement;
+
+					if (!fFaceInside[i]) {
+						continue;
+					}
+
+					if ((iGlobalId[i] < 1) || (iGlobalId[i] > lTotalElementCount)) {
+						_EXCEPTION2("global_id %li out of range [1,%li]",
+							(long)(iGlobalId[i]), lTotalElementCount);
+					}
+
+					Face face(static_cast<int>(lNodesPerElement));
+					for (long k = 0; k < lNodesPerElement; k++) {
+						face.SetNode(k, static_cast<NodeIndex>(pFaceConnect[k] - 1));
+						if (varEdgeType != NULL) {
+							face.edges[k].type = static_cast<Edge::Type>(
+								pEdgeType[i * lNodesPerElement + k]);
+						}
+					}
+					vecSelected.push_back(
+						std::pair<FaceIndex, Face>(
+							static_cast<FaceIndex>(iGlobalId[i] - 1), face));
+				}
+			}
+		}
+
+		// Order Faces by global index
+		std::sort(vecSelected.begin(), vecSelected.end(),
+			[](const std::pair<FaceIndex, Face> & a, const std::pair<FaceIndex, Face> & b) {
+				return (a.first < b.first);
+			});
+
+		// Referenced nodes in their original order
+		for (size_t f = 0; f < vecSelected.size(); f++) {
+			const Face & face = vecSelected[f].second;
+			for (size_t k = 0; k < face.edges.size(); k++) {
+				vecGlobalNodeIx.push_back(face[k]);
+			}
+		}
+		std::sort(vecGlobalNodeIx.begin(), vecGlobalNodeIx.end());
+		vecGlobalNodeIx.erase(
+			std::unique(vecGlobalNodeIx.begin(), vecGlobalNodeIx.end()),
+			vecGlobalNodeIx.end());
+
+		faces.resize(vecSelected.size());
+		vecGlobalFaceIx.resize(vecSelected.size());
+		for (size_t f = 0; f < vecSelected.size(); f++) {
+			vecGlobalFaceIx[f] = vecSelected[f].first;
+			faces[f] = vecSelected[f].second;
+			for (size_t k = 0; k < faces[f].edges.size(); k++) {
+				faces[f].SetNode(k, static_cast<NodeIndex>(
+					std::lower_bound(
+						vecGlobalNodeIx.begin(),
+						vecGlobalNodeIx.end(),
+						faces[f][k])
+					- vecGlobalNodeIx.begin()));
+			}
+		}
+		vecSelected.clear();
+
+		// Read referenced nodes
+		ReadNodeCoords(vecGlobalNodeIx, nodes);
+
+		// Exodus references a node table, so only remove coincident
+		// nodes if explicitly requested.
+		if (eCoincidentNodePolicy == CoincidentNodePolicy_Always) {
+			Announce("Removing coincident nodes");
+			RemoveCoincidentNodes();
+			vecGlobalNodeIx.clear();
+		}
+
+		Announce("Region size: Nodes [%lu] Elements [%lu] of [%li]",
+			nodes.size(), faces.size(), lTotalElementCount);
+
+	// Other formats are read in full and then restricted
+	} else {
+		ncFile.close();
+
+		Read(strFile, eCoincidentNodePolicy);
+
+		vecGlobalFaceIx.clear();
+		vecGlobalNodeIx.clear();
+
+		size_t sTotalFaces = faces.size();
+		RestrictToRegion(region);
+
+		// Node indices only refer to the file if nodes were not merged
+		if (eCoincidentNodePolicy == CoincidentNodePolicy_Always) {
+			vecGlobalNodeIx.clear();
+		}
+
+		Announce("Region size: Nodes [%lu] Elements [%lu] of [%lu]",
+			nodes.size(), faces.size(), sTotalFaces);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::RemoveZeroEdges() {
+
+	// Remove zero edges from all Faces
+	for (int i = 0; i < faces.size(); i++) {
+		faces[i].RemoveZeroEdges();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Mesh::Validate() const {
+
+	// Valid that Nodes have magnitude 1
+	for (int i = 0; i < nodes.size(); i++) {
+		double dMag = nodes[i].Magnitude();
+
+		if (fabs(dMag - 1.0) > ReferenceTolerance) {
+			_EXCEPTION5("Mesh validation failed: "
+				"Node[%i] of non-unit magnitude detected (%1.10e, %1.10e, %1.10e) = %1.10e",
+				i, nodes[i].x, nodes[i].y, nodes[i].z, dMag);
+
+		}
+	}
+
+	// Validate that edges are oriented counter-clockwise
+	for (int i = 0; i < faces.size(); i++) {
+		const Face & face = faces[i];
+
+		const int nEdges = face.edges.size();
+
+		for (int j = 0; j < nEdges; j++) {
+
+			// Check for zero edges
+			for(;;) {
+				if (face.edges[j][0] == face.edges[j][1]) {
+					j++;
+				} else {
+					break;
+				}
+				if (j == nEdges) {
+					break;
+				}
+			}
+
+			if (j == nEdges) {
+				break;
+			}
+
+			// Find the next non-zero edge
+			int jNext = (j + 1) % nEdges;
+
+			for(;;) {
+				if (face.edges[jNext][0] == face.edges[jNext][1]) {
+					jNext++;
+				} else {
+					break;
+				}
+				if (jNext == nEdges) {
+					jNext = 0;
+				}
+				if (jNext == ((j + 1) % nEdges)) {
+					_EXCEPTIONT("Mesh validation failed: "
+						"No edge information on Face");
+				}
+			}
+
+			// Get edges
+			const Edge & edge0 = face.edges[j];
+			const Edge & edge1 = face.edges[(j + 1) % nEdges];
+
+			if (edge0[1] != edge1[0]) {
+				_EXCEPTIONT("Mesh validation failed: Edge cyclicity error");
+			}
+
+			const Node & node0 = nodes[edge0[0]];
+			const Node & node1 = nodes[edge0[1]];
+			const Node & node2 = nodes[edge1[1]];
+
+			// Vectors along edges
+			Node nodeD1 = node0 - node1;
+			Node nodeD2 = node2 - node1;
+
+			// Compute cross-product
+			Node nodeCross(CrossProduct(nodeD1, nodeD2));
+
+			// Dot cross product with radial vector
+			Real dDot = DotProduct(node1, nodeCross);
+/*
+#ifdef USE_EXACT_ARITHMETIC
+			FixedPoint dDotX = DotProductX(node1, nodeCross);
+
+			printf("%1.15e : ", nodeCross.x); nodeCross.fx.Print(); printf("\n");
+
+			if (fabs(nodeCross.x - nodeCross.fx.ToReal()) > ReferenceTolerance) {
+				printf("X0: %1.15e : ", node0.x); node0.fx.Print(); printf("\n");
+				printf("Y0: %1.15e : ", node0.y); node0.fy.Print(); printf("\n");
+				printf("Z0: %1.15e : ", node0.z); node0.fz.Print(); printf("\n");
+				printf("X1: %1.15e : ", node1.x); node1.fx.Print(); printf("\n");
+				printf("Y1: %1.15e : ", node1.y); node1.fy.Print(); printf("\n");
+				printf("Z1: %1.15e : ", node1.z); node1.fz.Print(); printf("\n");
+				printf("X2: %1.15e : ", node2.x); node2.fx.Print(); printf("\n");
+				printf("Y2: %1.15e : ", node2.y); node2.fy.Print(); printf("\n");
+				printf("Z2: %1.15e : ", node2.z); node2.fz.Print(); printf("\n");
+
+				printf("X1: %1.15e : ", nodeD1.x); nodeD1.fx.Print(); printf("\n");
+				printf("Y1: %1.15e : ", nodeD1.y); nodeD1.fy.Print(); printf("\n");
+				printf("Z1: %1.15e : ", nodeD1.z); nodeD1.fz.Print(); printf("\n");
+				printf("X2: %1.15e : ", nodeD2.x); nodeD2.fx.Print(); printf("\n");
+				printf("Y2: %1.15e : ", nodeD2.y); nodeD2.fy.Print(); printf("\n");
+				printf("Z2: %1.15e : ", nodeD2.z); nodeD2.fz.Print(); printf("\n");
+				_EXCEPTIONT("FixedPoint mismatch (X)");
+			}
+			if (fabs(nodeCross.y - nodeCross.fy.ToReal()) > ReferenceTolerance) {
+				_EXCEPTIONT("FixedPoint mismatch (Y)");
+			}
+			if (fabs(nodeCross.z - nodeCross.fz.ToReal()) > ReferenceTolerance) {
+				_EXCEPTIONT("FixedPoint mismatch (Z)");
+			}
+
+#endif
+*/
+			if (dDot > 0.0) {
+				printf("\nError detected (orientation):\n");
+				printf("  Face %i, Edge %i, Orientation %1.5e\n",
+					i, j, dDot);
+
+				printf("  (x,y,z):\n");
+				printf("    n0: %1.5e %1.5e %1.5e\n", node0.x, node0.y, node0.z);
+				printf("    n1: %1.5e %1.5e %1.5e\n", node1.x, node1.y, node1.z);
+				printf("    n2: %1.5e %1.5e %1.5e\n", node2.x, node2.y, node2.z);
+
+				Real dR0 = sqrt(
+					node0.x * node0.x + node0.y * node0.y + node0.z * node0.z);
+				Real dLat0 = asin(node0.z / dR0);
+				Real dLon0 = atan2(node0.y, node0.x);
+
+				Real dR1 = sqrt(
+					node1.x * node1.x + node1.y * node1.y + node1.z * node1.z);
+				Real dLat1 = asin(node1.z / dR1);
+				Real dLon1 = atan2(node1.y, node1.x);
+
+				Real dR2 = sqrt(
+					node2.x * node2.x + node2.y * node2.y + node2.z * node2.z);
+				Real dLat2 = asin(node2.z / dR2);
+				Real dLon2 = atan2(node2.y, node2.x);
+
+				printf("  (lambda, phi):\n");
+				printf("    n0: %1.5e %1.5e\n", dLon0, dLat0);
+				printf("    n1: %1.5e %1.5e\n", dLon1, dLat1);
+				printf("    n2: %1.5e %1.5e\n", dLon2, dLat2);
+
+				printf("  X-Product:\n");
+				printf("    %1.5e %1.5e %1.5e\n",
+					nodeCross.x, nodeCross.y, nodeCross.z);
+
+				_EXCEPTIONT(
+					"Mesh validation failed: Clockwise or concave face detected");
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// General purpose functions
+///////////////////////////////////////////////////////////////////////////////
+
+bool IsPositivelyOrientedEdge(
+	const Node & nodeBegin,
+	const Node & nodeEnd
+) {
+	const Real Tolerance = ReferenceTolerance;
+
+	if ((fabs(nodeBegin.x - nodeEnd.x) < Tolerance) &&
+		(fabs(nodeBegin.y - nodeEnd.y) < Tolerance) &&
+		(fabs(nodeBegin.z - nodeEnd.z) < Tolerance)
+	) {
+		_EXCEPTIONT("Latitude line of zero length");
+	}
+
+	// Both nodes in positive y half-plane
+	if ((nodeBegin.y >= 0.0) && (nodeEnd.y >= 0.0)) {
+		if (nodeEnd.x < nodeBegin.x) {
+			return true;
+		} else {
+			return false;
+		}
+
+	// Both nodes in negative y half-plane
+	} else if ((nodeBegin.y <= 0.0) && (nodeEnd.y <= 0.0)) {
+		if (nodeEnd.x > nodeBegin.x) {
+			return true;
+		} else {
+			return false;
+		}
+
+	// Both nodes in positive x half-plane
+	} else if ((nodeBegin.x >= 0.0) && (nodeEnd.x >= 0.0)) {
+		if (nodeEnd.y > nodeBegin.y) {
+			return true;
+		} else {
+			return false;
+		}
+
+	// Both nodes in negative x half-plane
+	} else if ((nodeBegin.x <= 0.0) && (nodeEnd.x <= 0.0)) {
+		if (nodeEnd.y < nodeBegin.y) {
+			return true;
+		} else {
+			return false;
+		}
+
+	// Arc length too large
+	} else {
+		_EXCEPTIONT("Arc length too large to determine orientation.");
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GetLocalDirection(
+	const Node & nodeBegin,
+	const Node & nodeEnd,
+	const Node & nodeRef,
+	const Edge::Type edgetype,
+	Node & nodeDir
+) {
+
+	// Direction along a great circle arc
+	if (edgetype == Edge::Type_GreatCircleArc) {
+
+		// Cartesian direction
+		nodeDir = nodeEnd - nodeBegin;
+
+		// Project onto surface of the sphere
+		Real dDotDirBegin = DotProduct(nodeDir, nodeRef);
+		Real dNormNodeBegin = DotProduct(nodeRef, nodeRef);
+
+		nodeDir.x -= dDotDirBegin / dNormNodeBegin * nodeRef.x;
+		nodeDir.y -= dDotDirBegin / dNormNodeBegin * nodeRef.y;
+		nodeDir.z -= dDotDirBegin / dNormNodeBegin * nodeRef.z;
+
+	// Direction along a line of constant latitude
+	} else if (edgetype == Edge::Type_ConstantLatitude) {
+		nodeDir.z = 0.0;
+
+		if (IsPositivelyOrientedEdge(nodeBegin, nodeEnd)) {
+			nodeDir.x = - nodeBegin.y;
+			nodeDir.y = + nodeBegin.x;
+		} else {
+			nodeDir.x = + nodeBegin.y;
+			nodeDir.y = - nodeBegin.x;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GetLocalDirection(
+	const Node & nodeBegin,
+	const Node & nodeEnd,
+	const Edge::Type edgetype,
+	Node & nodeDir
+) {
+
+	// Direction along a great circle arc
+	if (edgetype == Edge::Type_GreatCircleArc) {
+
+		// Cartesian direction
+		nodeDir = nodeEnd - nodeBegin;
+
+		// Project onto surface of the sphere
+		Real dDotDirBegin   = DotProduct(nodeDir, nodeBegin);
+		Real dNormNodeBegin = DotProduct(nodeBegin, nodeBegin);
+
+		nodeDir.x -= dDotDirBegin / dNormNodeBegin * nodeBegin.x;
+		nodeDir.y -= dDotDirBegin / dNormNodeBegin * nodeBegin.y;
+		nodeDir.z -= dDotDirBegin / dNormNodeBegin * nodeBegin.z;
+
+	// Direction along a line of constant latitude
+	} else if (edgetype == Edge::Type_ConstantLatitude) {
+		nodeDir.z = 0.0;
+
+		if (IsPositivelyOrientedEdge(nodeBegin, nodeEnd)) {
+			nodeDir.x = - nodeBegin.y;
+			nodeDir.y = + nodeBegin.x;
+		} else {
+			nodeDir.x = + nodeBegin.y;
+			nodeDir.y = - nodeBegin.x;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void EqualizeCoincidentNodes(
+	const Mesh & meshFirst,
+	Mesh & meshSecond
+) {
+	_EXCEPTION();
+/*
+	// Sort nodes
+	std::map<Node, int> setSortedFirstNodes;
+	for (int i = 0; i < meshFirst.nodes.size(); i++) {
+		setSortedFirstNodes.insert(
+			std::pair<Node, int>(meshFirst.nodes[i], i));
+	}
+
+	// For each node in meshSecond determine if a corresponding node
+	// exists in meshFirst.
+	for (int i = 0; i < meshSecond.nodes.size(); i++) {
+		std::map<Node, int>::const_iterator iter =
+			setSortedFirstNodes.find(meshSecond.nodes[i]);
+
+		if (iter != setSortedFirstNodes.end()) {
+			meshSecond.nodes[i] = iter->first;
+		}
+	}
+*/
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/*
+void EqualizeCoincidentNodes(
+	Mesh & mesh
+) {
+	int nCoincidentNodes = 0;
+
+	// Sort nodes
+	std::map<Node, int> mapSortedNodes;
+	for (int i = 0; i < mesh.nodes.size(); i++) {
+		std::map<Node, int>::const_iterator iter =
+			mapSortedNodes.find(mesh.nodes[i]);
+
+		if (iter != mapSortedNodes.end()) {
+			nCoincidentNodes++;
+			mesh.nodes[i] = iter->first;
+		} else {
+			mapSortedNodes.insert(
+				std::pair<Node, int>(mesh.nodes[i], i));
+		}
+	}
+
+	printf("Coincident nodes: %i\n", nCoincidentNodes);
+}
+*/
+///////////////////////////////////////////////////////////////////////////////
+
+int BuildCoincidentNodeVector(
+	const Mesh & meshFirst,
+	const Mesh & meshSecond,
+	std::vector<int> & vecSecondToFirstCoincident
+) {
+	_EXCEPTION();
+/*
+	int nCoincidentNodes = 0;
+
+	// Sort nodes
+	std::map<Node, int> setSortedFirstNodes;
+	for (int i = 0; i < meshFirst.nodes.size(); i++) {
+		setSortedFirstNodes.insert(
+			std::pair<Node, int>(meshFirst.nodes[i], i));
+	}
+
+	// Resize array
+	vecSecondToFirstCoincident.resize(meshSecond.nodes.size(), InvalidNode);
+
+	// For each node in meshSecond determine if a corresponding node
+	// exists in meshFirst.
+	for (int i = 0; i < meshSecond.nodes.size(); i++) {
+		std::map<Node, int>::const_iterator iter =
+			setSortedFirstNodes.find(meshSecond.nodes[i]);
+
+		if (iter != setSortedFirstNodes.end()) {
+			vecSecondToFirstCoincident[i] = iter->second;
+			nCoincidentNodes++;
+		}
+	}
+
+	return nCoincidentNodes;
+*/
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Sum over q of dW[q] times the Jacobian of the map from reference
+///		coordinates (dA, dG[q]) to the unit sphere, through the flat
+///		triangle with vertices node1, node2 and node3 collapsed at node3.
+///		This is one row of the face area quadrature.  The loop over q has no
+///		dependencies other than the sum, so it vectorizes when nCount is a
+///		compile-time constant.
+///	</summary>
+static inline double SphericalTriangleQuadratureRow(
+	const Node & node1,
+	const Node & node2,
+	const Node & node3,
+	double dA,
+	int nCount,
+	const double * dG,
+	const double * dW
+) {
+	// Point on edge 1-2 and derivatives that only depend on dA
+	const double dPx = (1.0 - dA) * node1.x + dA * node2.x;
+	const double dPy = (1.0 - dA) * node1.y + dA * node2.y;
+	const double dPz = (1.0 - dA) * node1.z + dA * node2.z;
+
+	const double dDbFx = node3.x - dPx;
+	const double dDbFy = node3.y - dPy;
+	const double dDbFz = node3.z - dPz;
+
+	const double dD12x = node2.x - node1.x;
+	const double dD12y = node2.y - node1.y;
+	const double dD12z = node2.z - node1.z;
+
+	double dSum = 0.0;
+
+	for (int q = 0; q < nCount; q++) {
+		const double dB = dG[q];
+
+		const double dFx = (1.0 - dB) * dPx + dB * node3.x;
+		const double dFy = (1.0 - dB) * dPy + dB * node3.y;
+		const double dFz = (1.0 - dB) * dPz + dB * node3.z;
+
+		const double dDaFx = (1.0 - dB) * dD12x;
+		const double dDaFy = (1.0 - dB) * dD12y;
+		const double dDaFz = (1.0 - dB) * dD12z;
+
+		const double dR2 = dFx * dFx + dFy * dFy + dFz * dFz;
+
+		// Derivatives of the projection F / |F|, scaled by |F|^3
+		const double dDaFdotF = dDaFx * dFx + dDaFy * dFy + dDaFz * dFz;
+		const double dDbFdotF = dDbFx * dFx + dDbFy * dFy + dDbFz * dFz;
+
+		const double dDaGx = dDaFx * dR2 - dFx * dDaFdotF;
+		const double dDaGy = dDaFy * dR2 - dFy * dDaFdotF;
+		const double dDaGz = dDaFz * dR2 - dFz * dDaFdotF;
+
+		const double dDbGx = dDbFx * dR2 - dFx * dDbFdotF;
+		const double dDbGy = dDbFy * dR2 - dFy * dDbFdotF;
+		const double dDbGz = dDbFz * dR2 - dFz * dDbFdotF;
+
+		// Cross product gives local Jacobian
+		const double dCrossx = dDaGy * dDbGz - dDaGz * dDbGy;
+		const double dCrossy = dDaGz * dDbGx - dDaGx * dDbGz;
+		const double dCrossz = dDaGx * dDbGy - dDaGy * dDbGx;
+
+		const double dJacobian = sqrt(
+			  dCrossx * dCrossx
+			+ dCrossy * dCrossy
+			+ dCrossz * dCrossz) / (dR2 * dR2 * dR2);
+
+		dSum += dW[q] * dJacobian;
+	}
+
+	return dSum;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template<int Order>
+Real CalculateFaceAreaQuadratureMethod(
+	const Face & face,
+	const NodeVector & nodes
+) {
+	typedef GaussLegendreTable<Order> Table;
+
+	int nTriangles = face.edges.size() - 2;
+
+	double dFaceArea = 0.0;
+
+	// Loop over all sub-triangles of this Face
+	for (int j = 0; j < nTriangles; j++) {
+
+		const Node & node1 = nodes[face[0]];
+		const Node & node2 = nodes[face[j+1]];
+		const Node & node3 = nodes[face[j+2]];
+
+		// Calculate area at quadrature nodes; the trip counts are known at
+		// compile time so these loops are unrolled and vectorized
+		for (int p = 0; p < Order; p++) {
+			dFaceArea += Table::W[p]
+				* SphericalTriangleQuadratureRow(
+					node1, node2, node3,
+					Table::G[p], Order, Table::G, Table::W);
+		}
+	}
+
+	return dFaceArea;
+}
+
+template Real CalculateFaceAreaQuadratureMethod<1>(const Face &, const NodeVector &);
+template Real CalculateFaceAreaQuadratureMethod<2>(const Face &, const NodeVector &);
+template Real CalculateFaceAreaQuadratureMethod<3>(const Face &, const NodeVector &);
+template Real CalculateFaceAreaQuadratureMethod<4>(const Face &, const NodeVector &);
+template Real CalculateFaceAreaQuadratureMethod<5>(const Face &, const NodeVector &);
+template Real CalculateFaceAreaQuadratureMethod<6>(const Face &, const NodeVector &);
+template Real CalculateFaceAreaQuadratureMethod<7>(const Face &, const NodeVector &);
+template Real CalculateFaceAreaQuadratureMethod<8>(const Face &, const NodeVector &);
+
+///////////////////////////////////////////////////////////////////////////////
+
+Real CalculateFaceAreaQuadratureMethod(
+	const Face & face,
+	const NodeVector & nodes,
+	int nOrder
+) {
+	switch (nOrder) {
+		case 1: return CalculateFaceAreaQuadratureMethod<1>(face, nodes);
+		case 2: return CalculateFaceAreaQuadratureMethod<2>(face, nodes);
+		case 3: return CalculateFaceAreaQuadratureMethod<3>(face, nodes);
+		case 4: return CalculateFaceAreaQuadratureMethod<4>(face, nodes);
+		case 5: return CalculateFaceAreaQuadratureMethod<5>(face, nodes);
+		case 6: return CalculateFaceAreaQuadratureMethod<6>(face, nodes);
+		case 7: return CalculateFaceAreaQuadratureMethod<7>(face, nodes);
+		case 8: return CalculateFaceAreaQuadratureMethod<8>(face, nodes);
+	}
+
+	// Orders without a compile-time table
+	int nTriangles = face.edges.size() - 2;
+
+	DataArray1D<double> dG;
+	DataArray1D<double> dW;
+	GaussQuadrature::GetPoints(nOrder, 0.0, 1.0, dG, dW);
+
+	double dFaceArea = 0.0;
+
+	for (int j = 0; j < nTriangles; j++) {
+
+		const Node & node1 = nodes[face[0]];
+		const Node & node2 = nodes[face[j+1]];
+		const Node & node3 = nodes[face[j+2]];
+
+		for (int p = 0; p < nOrder; p++) {
+			dFaceArea += dW[p]
+				* SphericalTriangleQuadratureRow(
+					node1, node2, node3,
+					dG[p], nOrder, &(dG[0]), &(dW[0]));
+		}
+	}
+
+	return dFaceArea;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Real CalculateFaceArea(
+	const Face & face,
+	const NodeVector & nodes
+) {
+	return CalculateFaceAreaQuadratureMethod<6>(face, nodes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Real CalculateFaceAreaTriangularQuadrature(
+	const Face & face,
+	const NodeVector & nodes,
+	const TriangularQuadratureRule & rule
+) {
+	return IntegrateOverFace(face, nodes, rule, UnitIntegrand());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GenerateMeshGLLNodes(
+	Mesh & mesh,
+	int nP,
+	NodeVector & nodesGLL,
+	std::vector<NodeIndex> & vecGLLNodeIx
+) {
+	if (nP < 2) {
+		_EXCEPTION1("Invalid number of GLL points (%i)", nP);
+	}
+
+	const FaceIndex nFaces = static_cast<FaceIndex>(mesh.faces.size());
+
+	for (FaceIndex f = 0; f < nFaces; f++) {
+		if (mesh.faces[f].edges.size() != 4) {
+			_EXCEPTION2("Face %li has %li edges: GLL nodes require "
+				"quadrilateral Faces",
+				static_cast<long>(f),
+				static_cast<long>(mesh.faces[f].edges.size()));
+		}
+	}
+
+	if (mesh.edgemap.size() == 0) {
+		mesh.ConstructEdgeMap();
+	}
+
+	// GLL points on the reference element [0,1]
+	DataArray1D<double> dG;
+	DataArray1D<double> dW;
+	GaussLobattoQuadrature::GetPoints(nP, 0.0, 1.0, dG, dW);
+
+	const int nEdgeInterior = nP - 2;
+	const int nFaceInterior = nEdgeInterior * nEdgeInterior;
+
+	// Number the edges in EdgeMap order
+	std::vector<EdgeMapConstIterator> vecEdges;
+	vecEdges.reserve(mesh.edgemap.size());
+
+	EdgeMapConstIterator iterEdge = mesh.edgemap.begin();
+	for (; iterEdge != mesh.edgemap.end(); iterEdge++) {
+		vecEdges.push_back(iterEdge);
+	}
+
+	const NodeIndex nEdges = static_cast<NodeIndex>(vecEdges.size());
+
+	// Index of the edge between Face nodes k and k+1, found from the
+	// Faces adjacent to each edge
+	std::vector<NodeIndex> vecFaceEdgeIx(4 * nFaces, InvalidNode);
+
+#pragma omp parallel for
+	for (NodeIndex e = 0; e < nEdges; e++) {
+		const Edge & edge = vecEdges[e]->first;
+		const FacePair & facepair = vecEdges[e]->second;
+
+		for (int p = 0; p < 2; p++) {
+			if (facepair[p] == InvalidFace) {
+				continue;
+			}
+
+			const Face & face = mesh.faces[facepair[p]];
+			for (int k = 0; k < 4; k++) {
+				NodeIndex ix0 = face[k];
+				NodeIndex ix1 = face[(k+1)%4];
+				if (((ix0 == edge[0]) && (ix1 == edge[1])) ||
+				    ((ix0 == edge[1]) && (ix1 == edge[0]))
+				) {
+					vecFaceEdgeIx[4 * facepair[p] + k] = e;
+				}
+			}
+		}
+	}
+
+	for (FaceIndex f = 0; f < nFaces; f++) {
+		for (int k = 0; k < 4; k++) {
+			if (vecFaceEdgeIx[4 * f + k] == InvalidNode) {
+				_EXCEPTION1("Face %li has a degenerate edge: GLL nodes require "
+					"quadrilateral Faces", static_cast<long>(f));
+			}
+		}
+	}
+
+	// Layout of the global GLL nodes
+	const NodeIndex ixEdgeBegin = static_cast<NodeIndex>(mesh.nodes.size());
+	const NodeIndex ixFaceBegin = ixEdgeBegin + nEdges * nEdgeInterior;
+
+	nodesGLL.resize(ixFaceBegin + nFaces * nFaceInterior);
+	vecGLLNodeIx.resize(static_cast<size_t>(nFaces) * nP * nP);
+
+	// Corner points are the mesh nodes
+	std::copy(mesh.nodes.begin(), mesh.nodes.end(), nodesGLL.begin());
+
+	// Edge points, ordered from the smaller to the larger node index
+#pragma omp parallel for
+	for (NodeIndex e = 0; e < nEdges; e++) {
+		NodeIndex ixSmall;
+		NodeIndex ixBig;
+		vecEdges[e]->first.GetOrderedNodes(ixSmall, ixBig);
+
+		const Node & node0 = mesh.nodes[ixSmall];
+		const Node & node1 = mesh.nodes[ixBig];
+
+		for (int s = 1; s < nP - 1; s++) {
+			nodesGLL[ixEdgeBegin + e * nEdgeInterior + (s - 1)] =
+				InterpolateQuadrilateralNode(
+					node0, node1, node1, node0, dG[s], 0.0);
+		}
+	}
+
+	// Face points
+#pragma omp parallel for schedule(static)
+	for (FaceIndex f = 0; f < nFaces; f++) {
+		const Face & face = mesh.faces[f];
+
+		const Node & node0 = mesh.nodes[face[0]];
+		const Node & node1 = mesh.nodes[face[1]];
+		const Node & node2 = mesh.nodes[face[2]];
+		const Node & node3 = mesh.nodes[face[3]];
+
+		NodeIndex * ixGLL =
+			&(vecGLLNodeIx[static_cast<size_t>(f) * nP * nP]);
+
+		// Index of point t along edge k, counted from Face node k
+		auto EdgePointIx = [&](int k, int t) {
+			NodeIndex ixEdge = vecFaceEdgeIx[4 * f + k];
+			int s = (face[k] < face[(k+1)%4])?(t):(nP - 1 - t);
+			return (ixEdgeBegin + ixEdge * nEdgeInterior + (s - 1));
+		};
+
+		for (int j = 0; j < nP; j++) {
+			for (int i = 0; i < nP; i++) {
+				NodeIndex & ix = ixGLL[j * nP + i];
+
+				bool fLeft = (i == 0);
+				bool fRight = (i == nP - 1);
+				bool fBottom = (j == 0);
+				bool fTop = (j == nP - 1);
+
+				if (fBottom && fLeft) {
+					ix = face[0];
+				} else if (fBottom && fRight) {
+					ix = face[1];
+				} else if (fTop && fRight) {
+					ix = face[2];
+				} else if (fTop && fLeft) {
+					ix = face[3];
+				} else if (fBottom) {
+					ix = EdgePointIx(0, i);
+				} else if (fRight) {
+					ix = EdgePointIx(1, j);
+				} else if (fTop) {
+					ix = EdgePointIx(2, nP - 1 - i);
+				} else if (fLeft) {
+					ix = EdgePointIx(3, nP - 1 - j);
+				} else {
+					ix = ixFaceBegin + f * nFaceInterior
+						+ (j - 1) * nEdgeInterior + (i - 1);
+
+					nodesGLL[ix] = InterpolateQuadrilateralNode(
+						node0, node1, node2, node3, dG[i], dG[j]);
+				}
+			}
+		}
+	}
+}
+
+size_t InverseInterpolateQuadrilateralNode_Batch(
+	const FaceVector & faces,
+	const NodeVector & nodes,
+	size_t sCount,
+	const double * dX,
+	const double * dY,
+	const double * dZ,
+	const FaceIndex * ixFace,
+	double * dAlpha,
+	double * dBeta,
+	int * iConverged,
+	double dTolerance,
+	int nMaxIterations
+) {
+	const size_t TileSize = 256;
+
+	size_t sNotConverged = 0;
+
+	const long lTiles = static_cast<long>((sCount + TileSize - 1) / TileSize);
+
+#pragma omp parallel for schedule(static) reduction(+:sNotConverged)
+	for (long t = 0; t < lTiles; t++) {
+		const size_t s = static_cast<size_t>(t) * TileSize;
+		const size_t sTile = std::min(TileSize, sCount - s);
+
+		// Coefficients of Q(a,b) = A + a B + b C + a b D for each point
+		double dA[3][TileSize];
+		double dB[3][TileSize];
+		double dC[3][TileSize];
+		double dD[3][TileSize];
+
+		double dPx[TileSize];
+		double dPy[TileSize];
+		double dPz[TileSize];
+
+		double dTileAlpha[TileSize];
+		double dTileBeta[TileSize];
+		double dStep[TileSize];
+
+		bool fQuad[TileSize];
+		bool fValid[TileSize];
+
+		// Gather the Face nodes
+		for (size_t i = 0; i < sTile; i++) {
+			dPx[i] = dX[s + i];
+			dPy[i] = dY[s + i];
+			dPz[i] = dZ[s + i];
+
+			// The first iteration from the center solves the parallelogram
+			// approximation of the Face exactly
+			dTileAlpha[i] = 0.5;
+			dTileBeta[i] = 0.5;
+			dStep[i] = 1.0;
+
+			// Face indices outside the FaceVector are reported as not
+			// converged; the point itself stands in for the Face so that
+			// the iteration below remains well-defined
+			fValid[i] =
+				(ixFace[s + i] >= 0)
+				&& (static_cast<size_t>(ixFace[s + i]) < faces.size());
+
+			if (!fValid[i]) {
+				fQuad[i] = false;
+				for (int d = 0; d < 3; d++) {
+					dB[d][i] = 0.0;
+					dC[d][i] = 0.0;
+					dD[d][i] = 0.0;
+				}
+				dA[0][i] = dPx[i];
+				dA[1][i] = dPy[i];
+				dA[2][i] = dPz[i];
+				continue;
+			}
+
+			const Face & face = faces[ixFace[s + i]];
+
+			fQuad[i] = (face.edges.size() == 4);
+
+			const Node & node0 = nodes[face[0]];
+			const Node & node1 = nodes[face[fQuad[i]?1:0]];
+			const Node & node2 = nodes[face[fQuad[i]?2:0]];
+			const Node & node3 = nodes[face[fQuad[i]?3:0]];
+
+			dA[0][i] = node0.x;
+			dA[1][i] = node0.y;
+			dA[2][i] = node0.z;
+
+			dB[0][i] = node1.x - node0.x;
+			dB[1][i] = node1.y - node0.y;
+			dB[2][i] = node1.z - node0.z;
+
+			dC[0][i] = node3.x - node0.x;
+			dC[1][i] = node3.y - node0.y;
+			dC[2][i] = node3.z - node0.z;
+
+			dD[0][i] = node0.x - node1.x + node2.x - node3.x;
+			dD[1][i] = node0.y - node1.y + node2.y - node3.y;
+			dD[2][i] = node0.z - node1.z + node2.z - node3.z;
+		}
+
+		// Gauss-Newton iteration on the residual Q(a,b) x P
+		for (int iter = 0; iter < nMaxIterations; iter++) {
+			double dMaxStep = 0.0;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(max:dMaxStep)
+#endif
+			for (size_t i = 0; i < sTile; i++) {
+				const double a = dTileAlpha[i];
+				const double b = dTileBeta[i];
+
+				double dQ[3];
+				double dQa[3];
+				double dQb[3];
+				for (int d = 0; d < 3; d++) {
+					dQa[d] = dB[d][i] + b * dD[d][i];
+					dQb[d] = dC[d][i] + a * dD[d][i];
+					dQ[d] = dA[d][i] + a * dB[d][i] + b * dQb[d];
+				}
+
+				const double dR[3] = {
+					dQ[1] * dPz[i] - dQ[2] * dPy[i],
+					dQ[2] * dPx[i] - dQ[0] * dPz[i],
+					dQ[0] * dPy[i] - dQ[1] * dPx[i]};
+
+				const double dJa[3] = {
+					dQa[1] * dPz[i] - dQa[2] * dPy[i],
+					dQa[2] * dPx[i] - dQa[0] * dPz[i],
+					dQa[0] * dPy[i] - dQa[1] * dPx[i]};
+
+				const double dJb[3] = {
+					dQb[1] * dPz[i] - dQb[2] * dPy[i],
+					dQb[2] * dPx[i] - dQb[0] * dPz[i],
+					dQb[0] * dPy[i] - dQb[1] * dPx[i]};
+
+				const double dM00 = dJa[0] * dJa[0] + dJa[1] * dJa[1] + dJa[2] * dJa[2];
+				const double dM01 = dJa[0] * dJb[0] + dJa[1] * dJb[1] + dJa[2] * dJb[2];
+				const double dM11 = dJb[0] * dJb[0] + dJb[1] * dJb[1] + dJb[2] * dJb[2];
+
+				const double dG0 = dJa[0] * dR[0] + dJa[1] * dR[1] + dJa[2] * dR[2];
+				const double dG1 = dJb[0] * dR[0] + dJb[1] * dR[1] + dJb[2] * dR[2];
+
+				const double dInvDet = 1.0 / (dM00 * dM11 - dM01 * dM01);
+
+				const double dDeltaA = - (dM11 * dG0 - dM01 * dG1) * dInvDet;
+				const double dDeltaB = - (dM00 * dG1 - dM01 * dG0) * dInvDet;
+
+				dTileAlpha[i] = a + dDeltaA;
+				dTileBeta[i] = b + dDeltaB;
+
+				// NaN steps (degenerate Faces) compare false and stay at one
+				const double dAbsStep = std::max(fabs(dDeltaA), fabs(dDeltaB));
+				dStep[i] = (dAbsStep <= 1.0)?(dAbsStep):(1.0);
+				dMaxStep = std::max(dMaxStep, dStep[i]);
+			}
+
+			if (dMaxStep < dTolerance) {
+				break;
+			}
+		}
+
+		// Store and verify that Q is not on the antipode of P
+		for (size_t i = 0; i < sTile; i++) {
+			const double a = dTileAlpha[i];
+			const double b = dTileBeta[i];
+
+			double dQdotP = 0.0;
+			dQdotP += (dA[0][i] + a * dB[0][i] + b * (dC[0][i] + a * dD[0][i])) * dPx[i];
+			dQdotP += (dA[1][i] + a * dB[1][i] + b * (dC[1][i] + a * dD[1][i])) * dPy[i];
+			dQdotP += (dA[2][i] + a * dB[2][i] + b * (dC[2][i] + a * dD[2][i])) * dPz[i];
+
+			bool fConverged =
+				fQuad[i] && (dStep[i] < dTolerance) && (dQdotP > 0.0);
+
+			if (fValid[i]) {
+				dAlpha[s + i] = a;
+				dBeta[s + i] = b;
+			} else {
+				dAlpha[s + i] = std::numeric_limits<double>::quiet_NaN();
+				dBeta[s + i] = std::numeric_limits<double>::quiet_NaN();
+			}
+
+			if (iConverged != NULL) {
+				iConverged[s + i] = (fConverged)?(1):(0);
+			}
+			if (!fConverged) {
+				sNotConverged++;
+			}
+		}
+	}
+
+	return sNotConverged;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// MeshF
+///////////////////////////////////////////////////////////////////////////////
+
+void MeshF::Clear() {
+	nodes.clear();
+	vecFaceBegin.clear();
+	vecFaceNodes.clear();
+	vecFaceEdgeType.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void MeshF::FromMesh(
+	const Mesh & mesh
+) {
+	nodes.resize(mesh.nodes.size());
+	for (size_t i = 0; i < mesh.nodes.size(); i++) {
+		nodes[i] = NodeF(
+			static_cast<float>(mesh.nodes[i].x),
+			static_cast<float>(mesh.nodes[i].y),
+			static_cast<float>(mesh.nodes[i].z));
+	}
+
+	vecFaceBegin.resize(mesh.faces.size() + 1);
+	vecFaceBegin[0] = 0;
+	for (size_t f = 0; f < mesh.faces.size(); f++) {
+		vecFaceBegin[f+1] =
+			vecFaceBegin[f] + mesh.faces[f].edges.size();
+	}
+
+	bool fHasEdgeType = false;
+
+	vecFaceNodes.resize(vecFaceBegin[mesh.faces.size()]);
+	for (size_t f = 0; f < mesh.faces.size(); f++) {
+		for (size_t k = 0; k < mesh.faces[f].edges.size(); k++) {
+			vecFaceNodes[vecFaceBegin[f] + k] = mesh.faces[f][k];
+			if (mesh.faces[f].edges[k].type != Edge::Type_GreatCircleArc) {
+				fHasEdgeType = true;
+			}
+		}
+	}
+
+	vecFaceEdgeType.clear();
+	if (fHasEdgeType) {
+		vecFaceEdgeType.resize(vecFaceNodes.size());
+		for (size_t f = 0; f < mesh.faces.size(); f++) {
+			for (size_t k = 0; k < mesh.faces[f].edges.size(); k++) {
+				vecFaceEdgeType[vecFaceBegin[f] + k] =
+					static_cast<unsigned char>(mesh.faces[f].edges[k].type);
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Integer coordinates of a cell in the hash grid used by
+///		MeshF::RemoveCoincidentNodes().
+///	</summary>
+struct HashGridCell {
+	int ix;
+	int iy;
+	int iz;
+
+	bool operator==(const HashGridCell & cell) const {
+		return ((ix == cell.ix) && (iy == cell.iy) && (iz == cell.iz));
+	}
+};
+
+struct HashGridCellHash {
+	size_t operator()(const HashGridCell & cell) const {
+		return static_cast<size_t>(
+			  static_cast<uint64_t>(cell.ix) * 73856093ULL
+			^ static_cast<uint64_t>(cell.iy) * 19349663ULL
+			^ static_cast<uint64_t>(cell.iz) * 83492791ULL);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool MeshF::RemoveCoincidentNodes(
+	const std::atomic<bool> * pfCancel
+) {
+
+	// Nodes are coincident if they agree to within the tolerance in each
+	// coordinate.  With cells the size of the tolerance each cell holds at
+	// most one unique node, and any match lies in the same or an adjacent
+	// cell.  Exact duplicates are found in the node's own cell, so the
+	// adjacent cells are only searched for nodes without a match there.
+	const double dTolerance = static_cast<double>(coincident_node_tolerance);
+	const double dInvTolerance = 1.0 / dTolerance;
+
+	std::unordered_map<HashGridCell, NodeIndex, HashGridCellHash> mapCells;
+	mapCells.reserve(nodes.size());
+
+	std::vector<NodeIndex> vecNodeMap(nodes.size());
+	NodeFVector nodesUnique;
+
+	for (size_t i = 0; i < nodes.size(); i++) {
+		if ((i % 65536 == 0) && (pfCancel != NULL) && (*pfCancel)) {
+			return false;
+		}
+
+		const NodeF & node = nodes[i];
+
+		HashGridCell cell;
+		cell.ix = static_cast<int>(std::floor(node.x * dInvTolerance));
+		cell.iy = static_cast<int>(std::floor(node.y * dInvTolerance));
+		cell.iz = static_cast<int>(std::floor(node.z * dInvTolerance));
+
+		NodeIndex ixMatch = InvalidNode;
+		for (int n = 0; (n < 27) && (ixMatch == InvalidNode); n++) {
+
+			// Search the node's own cell (n = 13) first
+			int m = (n == 0)?(13):((n <= 13)?(n - 1):(n));
+
+			HashGridCell cellNbr;
+			cellNbr.ix = cell.ix + (m / 9) - 1;
+			cellNbr.iy = cell.iy + ((m / 3) % 3) - 1;
+			cellNbr.iz = cell.iz + (m % 3) - 1;
+
+			auto iter = mapCells.find(cellNbr);
+			if (iter == mapCells.end()) {
+				continue;
+			}
+
+			const NodeF & nodeUnique = nodesUnique[iter->second];
+			if ((std::fabs(nodeUnique.x - node.x) <= dTolerance) &&
+			    (std::fabs(nodeUnique.y - node.y) <= dTolerance) &&
+			    (std::fabs(nodeUnique.z - node.z) <= dTolerance)
+			) {
+				ixMatch = iter->second;
+			}
+		}
+
+		if (ixMatch == InvalidNode) {
+			ixMatch = static_cast<NodeIndex>(nodesUnique.size());
+			nodesUnique.push_back(node);
+			mapCells.insert(std::make_pair(cell, ixMatch));
+		}
+		vecNodeMap[i] = ixMatch;
+	}
+
+	// Renumber face nodes
+#pragma omp parallel for
+	for (long k = 0; k < (long)(vecFaceNodes.size()); k++) {
+		vecFaceNodes[k] = vecNodeMap[vecFaceNodes[k]];
+	}
+
+	nodes.swap(nodesUnique);
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read the node coordinates of an Exodus file in single precision,
+///		in chunks while converting the previous chunk.  Returns false if
+///		pfCancel was set before all chunks were read.
+///	</summary>
+static bool ReadExodusNodesF(
+	NcFile & ncFile,
+	const std::string & strFile,
+	long lNodeCount,
+	NodeFVector & nodes,
+	const std::atomic<bool> * pfCancel
+) {
+	NcVar * varNodes = ncFile.get_var("coord");
+	if (varNodes == NULL) {
+		_EXCEPTION1("Exodus Grid file \"%s\" is missing variable "
+				"\"coord\"", strFile.c_str());
+	}
+
+	nodes.resize(lNodeCount);
+
+	const long NodesPerChunk = 262144;
+	const long lChunks = (lNodeCount + NodesPerChunk - 1) / NodesPerChunk;
+
+	return PipelinedChunkRead<double>(
+		lChunks,
+		3 * (size_t)(NodesPerChunk),
+		[&](long c, double * dBuffer) {
+			const long lBegin = c * NodesPerChunk;
+			const long lCount = std::min(NodesPerChunk, lNodeCount - lBegin);
+
+			varNodes->set_cur(0, lBegin);
+			varNodes->get(dBuffer, 3, lCount);
+		},
+		[&](long c, double * dBuffer) {
+			const long lBegin = c * NodesPerChunk;
+			const long lCount = std::min(NodesPerChunk, lNodeCount - lBegin);
+
+#pragma omp parallel for
+			for (long i = 0; i < lCount; i++) {
+				nodes[lBegin + i] = NodeF(
+					static_cast<float>(dBuffer[i]),
+					static_cast<float>(dBuffer[lCount + i]),
+					static_cast<float>(dBuffer[2 * lCount + i]));
+			}
+		},
+		pfCancel);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool MeshF::Read(
+	const std::string & strFile,
+	Mesh::CoincidentNodePolicy eCoincidentNodePolicy,
+	const std::atomic<bool> * pfCancel
+) {
+	const int ParamLenString = 33;
+
+	// Turn off fatal errors in NetCDF
+	NcError error(NcError::silent_nonfatal);
+
+	// Open the NetCDF file
+	if (strFile == "") {
+		_EXCEPTIONT("No grid file specified for reading");
+	}
+	NcFile ncFile(strFile.c_str(), NcFile::ReadOnly);
+	if (!ncFile.is_valid()) {
+		_EXCEPTION1("Unable to open grid file \"%s\" for reading",
+			strFile.c_str());
+	}
+
+	Clear();
+
+	MeshFileInfo::Format eFormat = DetectMeshFileFormat(ncFile);
+
+	// Input from a NetCDF SCRIP file
+	if (eFormat == MeshFileInfo::Format_SCRIP) {
+		Announce("SCRIP Format File detected");
+
+		NcVar * varGridCornerLat = ncFile.get_var("grid_corner_lat");
+		NcVar * varGridCornerLon = ncFile.get_var("grid_corner_lon");
+
+		if ((varGridCornerLat == NULL) || (varGridCornerLon == NULL)) {
+			_EXCEPTION1("SCRIP Grid file \"%s\" is missing variable "
+				"\"grid_corner_lat\" or \"grid_corner_lon\"", strFile.c_str());
+		}
+
+		const long lGridSize = GetDimensionSize(ncFile, strFile, "grid_size");
+		const long lGridCorners = GetDimensionSize(ncFile, strFile, "grid_corners");
+
+		CheckMeshIndexRange(strFile, "face corners", lGridSize * lGridCorners);
+
+		// Units are radians unless degrees are specified
+		const bool fDegrees[2] = {
+			IsSCRIPCoordinateInDegrees(varGridCornerLon),
+			IsSCRIPCoordinateInDegrees(varGridCornerLat)};
+
+		// Corner j of face i is node i * lGridCorners + j
+		nodes.resize(lGridSize * lGridCorners);
+		vecFaceBegin.resize(lGridSize + 1);
+		vecFaceNodes.resize(lGridSize * lGridCorners);
+
+#pragma omp parallel for
+		for (long i = 0; i <= lGridSize; i++) {
+			vecFaceBegin[i] = static_cast<size_t>(i * lGridCorners);
+		}
+#pragma omp parallel for
+		for (long k = 0; k < lGridSize * lGridCorners; k++) {
+			vecFaceNodes[k] = static_cast<NodeIndex>(k);
+		}
+
+		// Read chunks of rows while converting the previous chunk
+		const long RowsPerChunk = 65536;
+		const long lChunks = (lGridSize + RowsPerChunk - 1) / RowsPerChunk;
+		const size_t sChunkSize = (size_t)(RowsPerChunk) * lGridCorners;
+
+		bool fComplete = PipelinedChunkRead<double>(
+			lChunks,
+			2 * sChunkSize,
+			[&](long c, double * dBuffer) {
+				const long lRowBegin = c * RowsPerChunk;
+				const long lRows = std::min(RowsPerChunk, lGridSize - lRowBegin);
+
+				varGridCornerLon->set_cur(lRowBegin, 0);
+				varGridCornerLon->get(dBuffer, lRows, lGridCorners);
+
+				varGridCornerLat->set_cur(lRowBegin, 0);
+				varGridCornerLat->get(dBuffer + sChunkSize, lRows, lGridCorners);
+			},
+			[&](long c, double * dBuffer) {
+				const long lRowBegin = c * RowsPerChunk;
+				const long lRows = std::min(RowsPerChunk, lGridSize - lRowBegin);
+				const long lTotal = lRows * lGridCorners;
+
+				double * dLon = dBuffer;
+				double * dLat = dBuffer + sChunkSize;
+
+				const long BlockSize = 4096;
+				const long nBlocks = (lTotal + BlockSize - 1) / BlockSize;
+
+#pragma omp parallel
+				{
+					std::vector<double> dX(BlockSize);
+					std::vector<double> dY(BlockSize);
+					std::vector<double> dZ(BlockSize);
+
+#pragma omp for
+					for (long b = 0; b < nBlocks; b++) {
+						const long lBegin = b * BlockSize;
+						const long lCount = std::min(BlockSize, lTotal - lBegin);
+
+						for (long k = lBegin; k < lBegin + lCount; k++) {
+							if (fDegrees[0]) {
+								dLon[k] *= M_PI / 180.0;
+							}
+							if (fDegrees[1]) {
+								dLat[k] *= M_PI / 180.0;
+							}
+						}
+
+						RLLtoXYZ_Batch(
+							lCount,
+							dLon + lBegin,
+							dLat + lBegin,
+							&(dX[0]),
+							&(dY[0]),
+							&(dZ[0]));
+
+						NodeF * pNodes = &(nodes[lRowBegin * lGridCorners + lBegin]);
+						for (long k = 0; k < lCount; k++) {
+							pNodes[k] = NodeF(
+								static_cast<float>(dX[k]),
+								static_cast<float>(dY[k]),
+								static_cast<float>(dZ[k]));
+						}
+					}
+				}
+			},
+			pfCancel);
+
+		if (!fComplete) {
+			Clear();
+			return false;
+		}
+
+		// SCRIP does not reference a node table, so we must remove
+		// coincident nodes.
+		if (eCoincidentNodePolicy != Mesh::CoincidentNodePolicy_Never) {
+			Announce("Removing coincident nodes");
+			if (!RemoveCoincidentNodes(pfCancel)) {
+				Clear();
+				return false;
+			}
+		}
+
+	// Input from a NetCDF Exodus file
+	} else if (eFormat == MeshFileInfo::Format_Exodus) {
+		Announce("Exodus Format File detected");
+
+		NcAtt * attVersion = ncFile.get_att("version");
+		if (attVersion == NULL) {
+			_EXCEPTION1("Exodus Grid file \"%s\" is missing attribute "
+					"\"version\"", strFile.c_str());
+		}
+		float flVersion = attVersion->as_float(0);
+
+		const long lNodeCount = GetDimensionSize(ncFile, strFile, "num_nodes");
+		const long lTotalElementCount = GetDimensionSize(ncFile, strFile, "num_elem");
+		const long lElementBlocks = GetDimensionSize(ncFile, strFile, "num_el_blk");
+
+		CheckMeshIndexRange(strFile, "nodes", lNodeCount);
+		CheckMeshIndexRange(strFile, "elements", lTotalElementCount);
+
+		// Global ids and sizes of all blocks determine the face offsets
+		std::vector< std::vector<FileNodeIndex> > vecGlobalId(lElementBlocks);
+		std::vector<long> vecNodesPerElement(lElementBlocks);
+
+		vecFaceBegin.resize(lTotalElementCount + 1, 0);
+
+		// Each global_id must occur once so that every Face is filled
+		std::vector<char> fFaceSeen(lTotalElementCount, 0);
+		long lBlockElementCount = 0;
+
+		for (long b = 0; b < lElementBlocks; b++) {
+			char szBuffer[ParamLenString];
+
+			snprintf(szBuffer, ParamLenString, "num_nod_per_el%li", b+1);
+			vecNodesPerElement[b] = GetDimensionSize(ncFile, strFile, szBuffer);
+
+			snprintf(szBuffer, ParamLenString, "num_el_in_blk%li", b+1);
+			const long lElementCount = GetDimensionSize(ncFile, strFile, szBuffer);
+
+			// Earlier version didn't have global_id
+			std::vector<FileNodeIndex> & vecBlockGlobalId = vecGlobalId[b];
+			vecBlockGlobalId.resize(lElementCount);
+
+			if (flVersion == 4.98f) {
+				for (long i = 0; i < lElementCount; i++) {
+					vecBlockGlobalId[i] = i + 1;
+				}
+			} else if (lElementCount != 0) {
+				snprintf(szBuffer, ParamLenString, "global_id%li", b+1);
+				NcVar * varGlobalId = ncFile.get_var(szBuffer);
+				if (varGlobalId == NULL) {
+					_EXCEPTION2("Exodus Grid file \"%s\" is missing variable "
+							"\"%s\"", strFile.c_str(), szBuffer);
+				}
+				varGlobalId->set_cur((long)0);
+				varGlobalId->get(&(vecBlockGlobalId[0]), lElementCount);
+			}
 
-		// Project onto surface of the sphere
-		Real dDotDirBegin = DotProduct(nodeDir, nodeRef);
-		Real dNormNodeBegin = DotProduct(nodeRef, nodeRef);
+			for (long i = 0; i < lElementCount; i++) {
+				if ((vecBlockGlobalId[i] < 1) ||
+				    (vecBlockGlobalId[i] > lTotalElementCount)
+				) {
+					_EXCEPTION2("global_id %li out of range [1,%li]",
+						(long)(vecBlockGlobalId[i]), lTotalElementCount);
+				}
+				if (fFaceSeen[vecBlockGlobalId[i] - 1]) {
+					_EXCEPTION2("Exodus Grid file \"%s\" has duplicate "
+						"global_id %li", strFile.c_str(),
+						(long)(vecBlockGlobalId[i]));
+				}
+				fFaceSeen[vecBlockGlobalId[i] - 1] = 1;
+				vecFaceBegin[vecBlockGlobalId[i]] =
+					static_cast<size_t>(vecNodesPerElement[b]);
+			}
+			lBlockElementCount += lElementCount;
+		}
 
-		nodeDir.x -= dDotDirBegin / dNormNodeBegin * nodeRef.x;
-		nodeDir.y -= dDotDirBegin / dNormNodeBegin * nodeRef.y;
-		nodeDir.z -= dDotDirBegin / dNormNodeBegin * nodeRef.z;
+		if (lBlockElementCount != lTotalElementCount) {
+			_EXCEPTION3("Exodus Grid file \"%s\" element blocks hold %li "
+				"elements but num_elem is %li", strFile.c_str(),
+				lBlockElementCount, lTotalElementCount);
+		}
+		std::vector<char>().swap(fFaceSeen);
 
-	// Direction along a line of constant latitude
-	} else if (edgetype == Edge::Type_ConstantLatitude) {
-		nodeDir.z = 0.0;
+		for (long f = 0; f < lTotalElementCount; f++) {
+			vecFaceBegin[f+1] += vecFaceBegin[f];
+		}
+		vecFaceNodes.resize(vecFaceBegin[lTotalElementCount]);
 
-		if (IsPositivelyOrientedEdge(nodeBegin, nodeEnd)) {
-			nodeDir.x = - nodeBegin.y;
-			nodeDir.y = + nodeBegin.x;
-		} else {
-			nodeDir.x = + nodeBegin.y;
-			nodeDir.y = - nodeBegin.x;
+		// Edge types are stored if any block has them
+		std::vector<NcVar *> vecVarEdgeType(lElementBlocks, NULL);
+		for (long b = 0; b < lElementBlocks; b++) {
+			char szEdgeType[ParamLenString];
+			if (flVersion == 4.98f) {
+				snprintf(szEdgeType, ParamLenString, "edge_type");
+			} else {
+				snprintf(szEdgeType, ParamLenString, "edge_type%li", b+1);
+			}
+			vecVarEdgeType[b] = ncFile.get_var(szEdgeType);
+			if (vecVarEdgeType[b] != NULL) {
+				vecFaceEdgeType.resize(vecFaceNodes.size(), 0);
+			}
 		}
-	}
-}
 
-///////////////////////////////////////////////////////////////////////////////
+		// Read connectivity in chunks while decoding the previous chunk
+		for (long b = 0; b < lElementBlocks; b++) {
+			char szConnect[ParamLenString];
+			snprintf(szConnect, ParamLenString, "connect%li", b+1);
 
-void GetLocalDirection(
-	const Node & nodeBegin,
-	const Node & nodeEnd,
-	const Edge::Type edgetype,
-	Node & nodeDir
-) {
+			NcVar * varConnect = ncFile.get_var(szConnect);
+			if (varConnect == NULL) {
+				_EXCEPTION2("Exodus Grid file \"%s\" is missing variable "
+						"\"%s\"", strFile.c_str(), szConnect);
+			}
 
-	// Direction along a great circle arc
-	if (edgetype == Edge::Type_GreatCircleArc) {
+			NcVar * varEdgeType = vecVarEdgeType[b];
 
-		// Cartesian direction
-		nodeDir = nodeEnd - nodeBegin;
+			const std::vector<FileNodeIndex> & vecBlockGlobalId = vecGlobalId[b];
+			const long lElementCount = static_cast<long>(vecBlockGlobalId.size());
+			const long lNodesPerElement = vecNodesPerElement[b];
 
-		// Project onto surface of the sphere
-		Real dDotDirBegin   = DotProduct(nodeDir, nodeBegin);
-		Real dNormNodeBegin = DotProduct(nodeBegin, nodeBegin);
+			const long ElementsPerChunk = 65536;
+			const long lChunks =
+				(lElementCount + ElementsPerChunk - 1) / ElementsPerChunk;
 
-		nodeDir.x -= dDotDirBegin / dNormNodeBegin * nodeBegin.x;
-		nodeDir.y -= dDotDirBegin / dNormNodeBegin * nodeBegin.y;
-		nodeDir.z -= dDotDirBegin / dNormNodeBegin * nodeBegin.z;
+			// Edge types follow the connectivity in the chunk buffer
+			const size_t sChunkSize = (size_t)(ElementsPerChunk) * lNodesPerElement;
 
-	// Direction along a line of constant latitude
-	} else if (edgetype == Edge::Type_ConstantLatitude) {
-		nodeDir.z = 0.0;
+			bool fComplete = PipelinedChunkRead<FileNodeIndex>(
+				lChunks,
+				(varEdgeType != NULL)?(2 * sChunkSize):(sChunkSize),
+				[&](long c, FileNodeIndex * iBuffer) {
+					const long lBegin = c * ElementsPerChunk;
+					const long lCount = std::min(ElementsPerChunk, lElementCount - lBegin);
 
-		if (IsPositivelyOrientedEdge(nodeBegin, nodeEnd)) {
-			nodeDir.x = - nodeBegin.y;
-			nodeDir.y = + nodeBegin.x;
-		} else {
-			nodeDir.x = + nodeBegin.y;
-			nodeDir.y = - nodeBegin.x;
+					varConnect->set_cur(lBegin, 0);
+					varConnect->get(iBuffer, lCount, lNodesPerElement);
+
+					if (varEdgeType != NULL) {
+						varEdgeType->set_cur(lBegin, 0);
+						varEdgeType->get(iBuffer + sChunkSize, lCount, lNodesPerElement);
+					}
+				},
+				[&](long c, FileNodeIndex * iBuffer) {
+					const long lBegin = c * ElementsPerChunk;
+					const long lCount = std::min(ElementsPerChunk, lElementCount - lBegin);
+
+					for (long k = 0; k < lCount * lNodesPerElement; k++) {
+						if ((iBuffer[k] < 1) || (iBuffer[k] > lNodeCount)) {
+							_EXCEPTION3("Exodus Grid file \"%s\" connectivity "
+								"%li out of range [1,%li]", strFile.c_str(),
+								(long)(iBuffer[k]), lNodeCount);
+						}
+					}
+
+#pragma omp parallel for
+					for (long i = 0; i < lCount; i++) {
+						const size_t ixFaceBegin =
+							vecFaceBegin[vecBlockGlobalId[lBegin + i] - 1];
+						NodeIndex * pFaceNodes = &(vecFaceNodes[ixFaceBegin]);
+						for (long k = 0; k < lNodesPerElement; k++) {
+							pFaceNodes[k] =
+								static_cast<NodeIndex>(iBuffer[i * lNodesPerElement + k] - 1);
+						}
+						if (varEdgeType != NULL) {
+							const FileNodeIndex * pEdgeType =
+								iBuffer + sChunkSize + i * lNodesPerElement;
+							for (long k = 0; k < lNodesPerElement; k++) {
+								vecFaceEdgeType[ixFaceBegin + k] =
+									static_cast<unsigned char>(pEdgeType[k]);
+							}
+						}
+					}
+				},
+				pfCancel);
+
+			if (!fComplete) {
+				Clear();
+				return false;
+			}
 		}
-	}
-}
 
-///////////////////////////////////////////////////////////////////////////////
+		// Read node coordinates in chunks while converting the previous chunk
+		if (!ReadExodusNodesF(ncFile, strFile, lNodeCount, nodes, pfCancel)) {
+			Clear();
+			return false;
+		}
 
-void EqualizeCoincidentNodes(
-	const Mesh & meshFirst,
-	Mesh & meshSecond
-) {
-	_EXCEPTION();
-/*
-	// Sort nodes
-	std::map<Node, int> setSortedFirstNodes;
-	for (int i = 0; i < meshFirst.nodes.size(); i++) {
-		setSortedFirstNodes.insert(
-			std::pair<Node, int>(meshFirst.nodes[i], i));
-	}
+		// Drop edge types if all edges are great circle arcs
+		if (std::find_if(vecFaceEdgeType.begin(), vecFaceEdgeType.end(),
+			[](unsigned char c) { return (c != Edge::Type_GreatCircleArc); })
+				== vecFaceEdgeType.end()
+		) {
+			std::vector<unsigned char>().swap(vecFaceEdgeType);
+		}
 
-	// For each node in meshSecond determine if a corresponding node
-	// exists in meshFirst.
-	for (int i = 0; i < meshSecond.nodes.size(); i++) {
-		std::map<Node, int>::const_iterator iter =
-			setSortedFirstNodes.find(meshSecond.nodes[i]);
+		// Exodus references a node table, so only remove coincident
+		// nodes if explicitly requested.
+		if (eCoincidentNodePolicy == Mesh::CoincidentNodePolicy_Always) {
+			Announce("Removing coincident nodes");
+			if (!RemoveCoincidentNodes(pfCancel)) {
+				Clear();
+				return false;
+			}
+		}
 
-		if (iter != setSortedFirstNodes.end()) {
-			meshSecond.nodes[i] = iter->first;
+	// Other formats are read in double precision and converted
+	} else {
+		ncFile.close();
+
+		Mesh mesh(strFile, eCoincidentNodePolicy);
+		if ((pfCancel != NULL) && (*pfCancel)) {
+			return false;
 		}
+		FromMesh(mesh);
+		return true;
 	}
-*/
+
+	// Output size
+	Announce("Mesh size: Nodes [%lu] Elements [%lu]",
+		nodes.size(), FaceCount());
+
+	return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-/*
-void EqualizeCoincidentNodes(
-	Mesh & mesh
-) {
-	int nCoincidentNodes = 0;
 
-	// Sort nodes
-	std::map<Node, int> mapSortedNodes;
-	for (int i = 0; i < mesh.nodes.size(); i++) {
-		std::map<Node, int>::const_iterator iter =
-			mapSortedNodes.find(mesh.nodes[i]);
+///	<summary>
+///		Get every lStride-th row of a two-dimensional variable, starting
+///		at row lRowBegin.  Rows are read one at a time through the C
+///		interface, which is several times faster than nc_get_vars and than
+///		a set_cur/get pair per row in the C++ interface.
+///	</summary>
+static int NcGetVara(int ncid, int varid, const size_t * start, const size_t * count, int * pData) {
+	return nc_get_vara_int(ncid, varid, start, count, pData);
+}
+static int NcGetVara(int ncid, int varid, const size_t * start, const size_t * count, long long * pData) {
+	return nc_get_vara_longlong(ncid, varid, start, count, pData);
+}
+static int NcGetVara(int ncid, int varid, const size_t * start, const size_t * count, double * pData) {
+	return nc_get_vara_double(ncid, varid, start, count, pData);
+}
 
-		if (iter != mapSortedNodes.end()) {
-			nCoincidentNodes++;
-			mesh.nodes[i] = iter->first;
-		} else {
-			mapSortedNodes.insert(
-				std::pair<Node, int>(mesh.nodes[i], i));
+template <typename T>
+static void GetStridedRows(
+	NcFile & ncFile,
+	NcVar * var,
+	long lRowBegin,
+	long lRows,
+	long lStride,
+	long lColumns,
+	T * pData
+) {
+	const int ncid = ncFile.id();
+	const int varid = var->id();
+
+	size_t start[2] = {0, 0};
+	const size_t count[2] = {1, (size_t)(lColumns)};
+
+	for (long r = 0; r < lRows; r++) {
+		start[0] = (size_t)(lRowBegin + r * lStride);
+		int status = NcGetVara(ncid, varid, start, count, pData + r * lColumns);
+		if (status != NC_NOERR) {
+			_EXCEPTION2("Unable to read rows of variable \"%s\": %s",
+				var->name(), nc_strerror(status));
 		}
 	}
-
-	printf("Coincident nodes: %i\n", nCoincidentNodes);
 }
-*/
+
 ///////////////////////////////////////////////////////////////////////////////
 
-int BuildCoincidentNodeVector(
-	const Mesh & meshFirst,
-	const Mesh & meshSecond,
-	std::vector<int> & vecSecondToFirstCoincident
+bool MeshF::ReadPreview(
+	const std::string & strFile,
+	size_t sFaceBudget,
+	size_t & sStride,
+	const std::atomic<bool> * pfCancel
 ) {
-	_EXCEPTION();
-/*
-	int nCoincidentNodes = 0;
+	const int ParamLenString = 33;
 
-	// Sort nodes
-	std::map<Node, int> setSortedFirstNodes;
-	for (int i = 0; i < meshFirst.nodes.size(); i++) {
-		setSortedFirstNodes.insert(
-			std::pair<Node, int>(meshFirst.nodes[i], i));
+	// Rows read between checks of pfCancel
+	const long RowsPerChunk = 65536;
+
+	sStride = 1;
+
+	// Turn off fatal errors in NetCDF
+	NcError error(NcError::silent_nonfatal);
+
+	// Open the NetCDF file
+	if (strFile == "") {
+		_EXCEPTIONT("No grid file specified for reading");
+	}
+	NcFile ncFile(strFile.c_str(), NcFile::ReadOnly);
+	if (!ncFile.is_valid()) {
+		_EXCEPTION1("Unable to open grid file \"%s\" for reading",
+			strFile.c_str());
 	}
 
-	// Resize array
-	vecSecondToFirstCoincident.resize(meshSecond.nodes.size(), InvalidNode);
+	Clear();
 
-	// For each node in meshSecond determine if a corresponding node
-	// exists in meshFirst.
-	for (int i = 0; i < meshSecond.nodes.size(); i++) {
-		std::map<Node, int>::const_iterator iter =
-			setSortedFirstNodes.find(meshSecond.nodes[i]);
+	if (sFaceBudget == 0) {
+		return false;
+	}
 
-		if (iter != setSortedFirstNodes.end()) {
-			vecSecondToFirstCoincident[i] = iter->second;
-			nCoincidentNodes++;
+	MeshFileInfo::Format eFormat = DetectMeshFileFormat(ncFile);
+
+	// Input from a NetCDF SCRIP file
+	if (eFormat == MeshFileInfo::Format_SCRIP) {
+		NcVar * varGridCornerLat = ncFile.get_var("grid_corner_lat");
+		NcVar * varGridCornerLon = ncFile.get_var("grid_corner_lon");
+
+		if ((varGridCornerLat == NULL) || (varGridCornerLon == NULL)) {
+			_EXCEPTION1("SCRIP Grid file \"%s\" is missing variable "
+				"\"grid_corner_lat\" or \"grid_corner_lon\"", strFile.c_str());
 		}
-	}
 
-	return nCoincidentNodes;
-*/
-}
+		const long lGridSize = GetDimensionSize(ncFile, strFile, "grid_size");
+		const long lGridCorners = GetDimensionSize(ncFile, strFile, "grid_corners");
 
-///////////////////////////////////////////////////////////////////////////////
+		if (lGridSize <= (long)(sFaceBudget)) {
+			return false;
+		}
+		sStride = (lGridSize + sFaceBudget - 1) / sFaceBudget;
 
-Real CalculateFaceAreaQuadratureMethod(
-	const Face & face,
-	const NodeVector & nodes
-) {
-	int nTriangles = face.edges.size() - 2;
+		const long lStride = static_cast<long>(sStride);
+		const long lRows = (lGridSize + lStride - 1) / lStride;
 
-	const int nOrder = 6;
+		// Units are radians unless degrees are specified
+		const bool fDegrees[2] = {
+			IsSCRIPCoordinateInDegrees(varGridCornerLon),
+			IsSCRIPCoordinateInDegrees(varGridCornerLat)};
 
-	DataArray1D<double> dG;
-	DataArray1D<double> dW;
-	GaussQuadrature::GetPoints(nOrder, 0.0, 1.0, dG, dW);
+		// Read the corners of every sStride-th row
+		std::vector<double> dLon(lRows * lGridCorners);
+		std::vector<double> dLat(lRows * lGridCorners);
 
-	double dFaceArea = 0.0;
+		for (long r = 0; r < lRows; r += RowsPerChunk) {
+			if ((pfCancel != NULL) && (*pfCancel)) {
+				return false;
+			}
+			const long lCount = std::min(RowsPerChunk, lRows - r);
 
-	// Loop over all sub-triangles of this Face
-	for (int j = 0; j < nTriangles; j++) {
+			GetStridedRows(ncFile, varGridCornerLon,
+				r * lStride, lCount, lStride, lGridCorners,
+				&(dLon[r * lGridCorners]));
 
-		// Calculate the area of the modified Face
-		Node node1 = nodes[face[0]];
-		Node node2 = nodes[face[j+1]];
-		Node node3 = nodes[face[j+2]];
-
-		// Calculate area at quadrature node
-		for (int p = 0; p < dW.GetRows(); p++) {
-		for (int q = 0; q < dW.GetRows(); q++) {
-
-			double dA = dG[p];
-			double dB = dG[q];
-
-			Node dF(
-				(1.0 - dB) * ((1.0 - dA) * node1.x + dA * node2.x) + dB * node3.x,
-				(1.0 - dB) * ((1.0 - dA) * node1.y + dA * node2.y) + dB * node3.y,
-				(1.0 - dB) * ((1.0 - dA) * node1.z + dA * node2.z) + dB * node3.z);
-
-			Node dDaF(
-				(1.0 - dB) * (node2.x - node1.x),
-				(1.0 - dB) * (node2.y - node1.y),
-				(1.0 - dB) * (node2.z - node1.z));
-
-			Node dDbF(
-				- (1.0 - dA) * node1.x - dA * node2.x + node3.x,
-				- (1.0 - dA) * node1.y - dA * node2.y + node3.y,
-				- (1.0 - dA) * node1.z - dA * node2.z + node3.z);
-
-			double dR = sqrt(dF.x * dF.x + dF.y * dF.y + dF.z * dF.z);
-
-			Node dDaG(
-				dDaF.x * (dF.y * dF.y + dF.z * dF.z)
-					- dF.x * (dDaF.y * dF.y + dDaF.z * dF.z),
-				dDaF.y * (dF.x * dF.x + dF.z * dF.z)
-					- dF.y * (dDaF.x * dF.x + dDaF.z * dF.z),
-				dDaF.z * (dF.x * dF.x + dF.y * dF.y)
-					- dF.z * (dDaF.x * dF.x + dDaF.y * dF.y));
-
-			Node dDbG(
-				dDbF.x * (dF.y * dF.y + dF.z * dF.z)
-					- dF.x * (dDbF.y * dF.y + dDbF.z * dF.z),
-				dDbF.y * (dF.x * dF.x + dF.z * dF.z)
-					- dF.y * (dDbF.x * dF.x + dDbF.z * dF.z),
-				dDbF.z * (dF.x * dF.x + dF.y * dF.y)
-					- dF.z * (dDbF.x * dF.x + dDbF.y * dF.y));
-
-			double dDenomTerm = 1.0 / (dR * dR * dR);
-
-			dDaG.x *= dDenomTerm;
-			dDaG.y *= dDenomTerm;
-			dDaG.z *= dDenomTerm;
-
-			dDbG.x *= dDenomTerm;
-			dDbG.y *= dDenomTerm;
-			dDbG.z *= dDenomTerm;
-/*
-			Node node;
-			Node dDx1G;
-			Node dDx2G;
-
-			ApplyLocalMap(
-				faceQuad,
-				nodes,
-				dG[p],
-				dG[q],
-				node,
-				dDx1G,
-				dDx2G);
-*/
-			// Cross product gives local Jacobian
-			Node nodeCross = CrossProduct(dDaG, dDbG);
+			GetStridedRows(ncFile, varGridCornerLat,
+				r * lStride, lCount, lStride, lGridCorners,
+				&(dLat[r * lGridCorners]));
+		}
+
+		// Drop repeated corners, which pad faces with fewer corners
+		vecFaceBegin.resize(lRows + 1);
+		vecFaceBegin[0] = 0;
+		vecFaceNodes.reserve(lRows * lGridCorners);
+
+		long lKept = 0;
+		for (long r = 0; r < lRows; r++) {
+			const long lRowBegin = lKept;
+			for (long j = 0; j < lGridCorners; j++) {
+				const long k = r * lGridCorners + j;
+				if ((lKept != lRowBegin) &&
+				    (dLon[k] == dLon[lKept-1]) &&
+				    (dLat[k] == dLat[lKept-1])
+				) {
+					continue;
+				}
+				dLon[lKept] = dLon[k];
+				dLat[lKept] = dLat[k];
+				vecFaceNodes.push_back(static_cast<NodeIndex>(lKept));
+				lKept++;
+			}
+			if ((lKept - lRowBegin > 1) &&
+			    (dLon[lKept-1] == dLon[lRowBegin]) &&
+			    (dLat[lKept-1] == dLat[lRowBegin])
+			) {
+				vecFaceNodes.pop_back();
+				lKept--;
+			}
+			vecFaceBegin[r+1] = static_cast<size_t>(lKept);
+		}
+
+		for (long k = 0; k < lKept; k++) {
+			if (fDegrees[0]) {
+				dLon[k] *= M_PI / 180.0;
+			}
+			if (fDegrees[1]) {
+				dLat[k] *= M_PI / 180.0;
+			}
+		}
+
+		std::vector<double> dX(lKept);
+		std::vector<double> dY(lKept);
+		std::vector<double> dZ(lKept);
+
+		RLLtoXYZ_Batch(lKept, &(dLon[0]), &(dLat[0]), &(dX[0]), &(dY[0]), &(dZ[0]));
+
+		nodes.resize(lKept);
+		for (long k = 0; k < lKept; k++) {
+			nodes[k] = NodeF(
+				static_cast<float>(dX[k]),
+				static_cast<float>(dY[k]),
+				static_cast<float>(dZ[k]));
+		}
+
+	// Input from a NetCDF Exodus file
+	} else if (eFormat == MeshFileInfo::Format_Exodus) {
+		NcAtt * attVersion = ncFile.get_att("version");
+		if (attVersion == NULL) {
+			_EXCEPTION1("Exodus Grid file \"%s\" is missing attribute "
+					"\"version\"", strFile.c_str());
+		}
+		float flVersion = attVersion->as_float(0);
+
+		const long lNodeCount = GetDimensionSize(ncFile, strFile, "num_nodes");
+		const long lTotalElementCount = GetDimensionSize(ncFile, strFile, "num_elem");
+		const long lElementBlocks = GetDimensionSize(ncFile, strFile, "num_el_blk");
+
+		CheckMeshIndexRange(strFile, "nodes", lNodeCount);
+
+		if (lTotalElementCount <= (long)(sFaceBudget)) {
+			return false;
+		}
+		sStride = (lTotalElementCount + sFaceBudget - 1) / sFaceBudget;
 
-			double dJacobian = sqrt(
-				  nodeCross.x * nodeCross.x
-				+ nodeCross.y * nodeCross.y
-				+ nodeCross.z * nodeCross.z);
+		const long lStride = static_cast<long>(sStride);
 
-			//dFaceArea += 2.0 * dW[p] * dW[q] * (1.0 - dG[q]) * dJacobian;
-			
-			dFaceArea += dW[p] * dW[q] * dJacobian;
+		vecFaceBegin.push_back(0);
+
+		bool fHasEdgeType = false;
+
+		// Read every sStride-th row of the blocks taken in file order
+		long lFileRow = 0;
+		for (long b = 0; b < lElementBlocks; b++) {
+			char szBuffer[ParamLenString];
+
+			snprintf(szBuffer, ParamLenString, "num_nod_per_el%li", b+1);
+			const long lNodesPerElement = GetDimensionSize(ncFile, strFile, szBuffer);
+
+			snprintf(szBuffer, ParamLenString, "num_el_in_blk%li", b+1);
+			const long lElementCount = GetDimensionSize(ncFile, strFile, szBuffer);
+
+			snprintf(szBuffer, ParamLenString, "connect%li", b+1);
+			NcVar * varConnect = ncFile.get_var(szBuffer);
+			if (varConnect == NULL) {
+				_EXCEPTION2("Exodus Grid file \"%s\" is missing variable "
+						"\"%s\"", strFile.c_str(), szBuffer);
+			}
+
+			if (flVersion == 4.98f) {
+				snprintf(szBuffer, ParamLenString, "edge_type");
+			} else {
+				snprintf(szBuffer, ParamLenString, "edge_type%li", b+1);
+			}
+			NcVar * varEdgeType = ncFile.get_var(szBuffer);
+
+			// First row of the block that is a multiple of lStride in file order
+			const long lRowBegin = (lStride - lFileRow % lStride) % lStride;
+			const long lRows =
+				(lRowBegin < lElementCount)
+					?((lElementCount - lRowBegin + lStride - 1) / lStride)
+					:(0);
+
+			if ((varEdgeType != NULL) && (!fHasEdgeType)) {
+				vecFaceEdgeType.resize(vecFaceNodes.size(), 0);
+				fHasEdgeType = true;
+			}
+
+			std::vector<FileNodeIndex> iConnect;
+			std::vector<FileNodeIndex> iEdgeType;
+
+			for (long r = 0; r < lRows; r += RowsPerChunk) {
+				if ((pfCancel != NULL) && (*pfCancel)) {
+					Clear();
+					return false;
+				}
+				const long lCount = std::min(RowsPerChunk, lRows - r);
+
+				iConnect.resize(lCount * lNodesPerElement);
+				GetStridedRows(ncFile, varConnect,
+					lRowBegin + r * lStride, lCount, lStride, lNodesPerElement,
+					&(iConnect[0]));
+
+				if (varEdgeType != NULL) {
+					iEdgeType.resize(lCount * lNodesPerElement);
+					GetStridedRows(ncFile, varEdgeType,
+						lRowBegin + r * lStride, lCount, lStride, lNodesPerElement,
+						&(iEdgeType[0]));
+				}
+
+				for (long i = 0; i < lCount * lNodesPerElement; i++) {
+					if ((iConnect[i] < 1) || (iConnect[i] > lNodeCount)) {
+						_EXCEPTION3("Exodus Grid file \"%s\" connectivity "
+							"%li out of range [1,%li]", strFile.c_str(),
+							(long)(iConnect[i]), lNodeCount);
+					}
+					vecFaceNodes.push_back(static_cast<NodeIndex>(iConnect[i] - 1));
+					if (fHasEdgeType) {
+						vecFaceEdgeType.push_back(
+							(varEdgeType != NULL)
+								?(static_cast<unsigned char>(iEdgeType[i]))
+								:(static_cast<unsigned char>(Edge::Type_GreatCircleArc)));
+					}
+					if ((i + 1) % lNodesPerElement == 0) {
+						vecFaceBegin.push_back(vecFaceNodes.size());
+					}
+				}
+			}
+			lFileRow += lElementCount;
 		}
+
+		if (!ReadExodusNodesF(ncFile, strFile, lNodeCount, nodes, pfCancel)) {
+			Clear();
+			return false;
 		}
+
+	// Other formats can only be read in full
+	} else {
+		return false;
 	}
 
-	return dFaceArea;
+	return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-Real CalculateFaceArea(
-	const Face & face,
-	const NodeVector & nodes
+std::future<void> MeshF::ReadAsync(
+	const std::string & strFile,
+	Mesh::CoincidentNodePolicy eCoincidentNodePolicy
 ) {
-	return CalculateFaceAreaQuadratureMethod(face, nodes);
+	return std::async(std::launch::async, [this, strFile, eCoincidentNodePolicy]() {
+		Read(strFile, eCoincidentNodePolicy);
+	});
 }
 
 ///////////////////////////////////////////////////////////////////////////////
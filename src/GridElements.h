@@ -21,16 +21,21 @@
 
 #include "Defines.h"
 
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <vector>
 #include <set>
 #include <map>
 #include <string>
+#include <future>
 #include <cmath>
 #include <cassert>
 
 #include "Exception.h"
 #include "DataArray1D.h"
 #include "CoordTransforms.h"
+#include "TriangularQuadrature.h"
 #include "netcdfcpp.h"
 #include "kdtree.h"
 
@@ -306,9 +311,19 @@ typedef NodeMap::const_iterator NodeMapConstIterator;
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
-///		A node index.
+///		A node index.  The width of this type is selected at compile time
+///		by MESH_INDEX_64 (see Defines.h).
 ///	</summary>
-typedef int NodeIndex;
+#if defined(MESH_INDEX_64)
+typedef int64_t NodeIndex;
+#else
+typedef int32_t NodeIndex;
+#endif
+
+///	<summary>
+///		A face index.
+///	</summary>
+typedef NodeIndex FaceIndex;
 
 ///	<summary>
 ///		A vector for the storage of Node indices.
@@ -323,7 +338,7 @@ static const NodeIndex InvalidNode = (-1);
 ///	<summary>
 ///		An index indicating this Face is invalid.
 ///	</summary>
-static const NodeIndex InvalidFace = (-1);
+static const FaceIndex InvalidFace = (-1);
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -408,7 +423,7 @@ public:
 	///	<summary>
 	///		Node indices representing the endpoints of this edge.
 	///	</summary>
-	int node[2];
+	NodeIndex node[2];
 
 	///	<summary>
 	///		The type of this edge.
@@ -420,8 +435,8 @@ public:
 	///		Constructor.
 	///	</summary>
 	Edge(
-		int node0 = InvalidNode,
-		int node1 = InvalidNode,
+		NodeIndex node0 = InvalidNode,
+		NodeIndex node1 = InvalidNode,
 		Type _type = Type_Default
 	) {
 		node[0] = node0;
@@ -441,19 +456,19 @@ public:
 	///		this method can be treated as const.
 	///	</summary>
 	void Flip() const {
-		int ixTemp = node[0];
-		const_cast<int&>(node[0]) = node[1];
-		const_cast<int&>(node[1]) = ixTemp;
+		NodeIndex ixTemp = node[0];
+		const_cast<NodeIndex&>(node[0]) = node[1];
+		const_cast<NodeIndex&>(node[1]) = ixTemp;
 	}
 
 	///	<summary>
 	///		Accessor.
 	///	</summary>
-	int operator[](int i) const {
+	NodeIndex operator[](int i) const {
 		return node[i];
 	}
 
-	int & operator[](int i) {
+	NodeIndex & operator[](int i) {
 		return node[i];
 	}
 
@@ -461,8 +476,8 @@ public:
 	///		Get the nodes as an ordered pair.
 	///	</summary>
 	void GetOrderedNodes(
-		int & ixNodeSmall,
-		int & ixNodeBig
+		NodeIndex & ixNodeSmall,
+		NodeIndex & ixNodeBig
 	) const {
 		if (node[0] < node[1]) {
 			ixNodeSmall = node[0];
@@ -479,13 +494,13 @@ public:
 	bool operator<(const Edge & edge) const {
 
 		// Order the local nodes
-		int ixNodeSmall;
-		int ixNodeBig;
+		NodeIndex ixNodeSmall;
+		NodeIndex ixNodeBig;
 		GetOrderedNodes(ixNodeSmall, ixNodeBig);
 
 		// Order the nodes in edge
-		int ixEdgeNodeSmall;
-		int ixEdgeNodeBig;
+		NodeIndex ixEdgeNodeSmall;
+		NodeIndex ixEdgeNodeBig;
 		edge.GetOrderedNodes(ixEdgeNodeSmall, ixEdgeNodeBig);
 
 		// Compare
@@ -533,7 +548,7 @@ public:
 	///	<summary>
 	///		Return the node that is shared between segments.
 	///	</summary>
-	int CommonNode(
+	NodeIndex CommonNode(
 		const Edge & edge
 	) const {
 		if (edge[0] == node[0]) {
@@ -555,7 +570,7 @@ public:
 ///	<summary>
 ///		An edge connects two nodes with a sub-array of interior nodes.
 ///	</summary>
-class MultiEdge : public std::vector<int> {
+class MultiEdge : public std::vector<NodeIndex> {
 
 public:
 	///	<summary>
@@ -584,7 +599,7 @@ public:
 	///	<summary>
 	///		Indices of the Faces in this pair.
 	///	</summary>
-	int face[2];
+	FaceIndex face[2];
 
 public:
 	///	<summary>
@@ -598,7 +613,7 @@ public:
 	///	<summary>
 	///		Add a face to this FacePair.
 	///	</summary>
-	void AddFace(int ixFace) {
+	void AddFace(FaceIndex ixFace) {
 		if (face[0] == InvalidFace) {
 			face[0] = ixFace;
 
@@ -620,7 +635,7 @@ public:
 	///	<summary>
 	///		Accessor.
 	///	</summary>
-	int operator[](int i) const {
+	FaceIndex operator[](int i) const {
 		return face[i];
 	}
 };
@@ -672,14 +687,14 @@ public:
 	///	<summary>
 	///		Accessor.
 	///	</summary>
-	inline int operator[](int ix) const {
+	inline NodeIndex operator[](int ix) const {
 		return edges[ix][0];
 	}
 
 	///	<summary>
 	///		Set a node.
 	///	</summary>
-	void SetNode(int ixLocal, int ixNode) {
+	void SetNode(int ixLocal, NodeIndex ixNode) {
 		int nEdges = static_cast<int>(edges.size());
 		edges[ixLocal][0] = ixNode;
 
@@ -730,7 +745,204 @@ typedef std::vector<Face> FaceVector;
 ///	<summary>
 ///		A reverse node array stores all faces associated with a given node.
 ///	</summary>
-typedef std::vector< std::set<int> > ReverseNodeArray;
+typedef std::vector< std::set<FaceIndex> > ReverseNodeArray;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Metadata describing a mesh file, obtained from its dimensions and
+///		attributes without reading any coordinate or connectivity arrays.
+///	</summary>
+class MeshFileInfo {
+
+public:
+	///	<summary>
+	///		Format of a mesh file.
+	///	</summary>
+	enum Format {
+		Format_Unknown = -1,
+		Format_ICON = 0,
+		Format_UGRID = 1,
+		Format_MPAS = 2,
+		Format_SCRIP = 3,
+		Format_Exodus = 4
+	};
+
+	///	<summary>
+	///		Name of a format.
+	///	</summary>
+	static const char * FormatName(Format eFormat);
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	MeshFileInfo() :
+		eFormat(Format_Unknown),
+		lNodeCount(0),
+		lFaceCount(0),
+		lMaxNodesPerFace(0),
+		fHasCoordinateRange(false)
+	{
+		dLonRange[0] = dLonRange[1] = 0.0;
+		dLatRange[0] = dLatRange[1] = 0.0;
+	}
+
+	///	<summary>
+	///		Format of the file.
+	///	</summary>
+	Format eFormat;
+
+	///	<summary>
+	///		Number of nodes stored in the file.  For SCRIP this counts every
+	///		face corner, before coincident nodes are removed.
+	///	</summary>
+	long lNodeCount;
+
+	///	<summary>
+	///		Number of faces stored in the file.
+	///	</summary>
+	long lFaceCount;
+
+	///	<summary>
+	///		Maximum number of nodes per face.
+	///	</summary>
+	long lMaxNodesPerFace;
+
+	///	<summary>
+	///		Number of faces in each element block (Exodus); otherwise a
+	///		single block containing all faces.
+	///	</summary>
+	std::vector<long> vecBlockFaceCount;
+
+	///	<summary>
+	///		Number of nodes per face in each element block.
+	///	</summary>
+	std::vector<long> vecBlockNodesPerFace;
+
+	///	<summary>
+	///		True if the longitude and latitude ranges are available from
+	///		attributes of the coordinate variables (actual_range, or
+	///		valid_min and valid_max).
+	///	</summary>
+	bool fHasCoordinateRange;
+
+	///	<summary>
+	///		Longitude and latitude ranges, in degrees.
+	///	</summary>
+	double dLonRange[2];
+	double dLatRange[2];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A region of interest on the sphere, given either as a box in
+///		longitude and latitude or as a spherical polygon.  A Face
+///		intersects the region if its longitude-latitude bounding box
+///		overlaps that of the region and, for polygons, if it also has a
+///		corner in the polygon, contains a polygon vertex or has an edge
+///		that crosses a polygon edge.  The bounding box of a Face covers its
+///		corners, the poleward bulge of its edges and any pole it contains.
+///		Faces on the boundary and Faces larger than the region are
+///		therefore selected.
+///	</summary>
+class MeshRegion {
+
+public:
+	///	<summary>
+	///		Type of region.
+	///	</summary>
+	enum Type {
+		Type_LatLonBox = 0,
+		Type_Polygon = 1
+	};
+
+public:
+	///	<summary>
+	///		Constructor for a longitude-latitude box (in degrees).  If
+	///		dLonMinDeg > dLonMaxDeg the box wraps through longitude 360.
+	///	</summary>
+	MeshRegion(
+		double dLonMinDeg,
+		double dLonMaxDeg,
+		double dLatMinDeg,
+		double dLatMaxDeg
+	);
+
+	///	<summary>
+	///		Constructor for a spherical polygon with great circle edges,
+	///		given by vertex longitudes and latitudes (in degrees) in
+	///		counter-clockwise order.  The polygon must be smaller than a
+	///		hemisphere.
+	///	</summary>
+	MeshRegion(
+		const std::vector<double> & vecLonDeg,
+		const std::vector<double> & vecLatDeg
+	);
+
+	///	<summary>
+	///		Determine if a point on the unit sphere lies in the region.
+	///	</summary>
+	bool Contains(
+		const Node & node
+	) const;
+
+	///	<summary>
+	///		Determine if a point, given in degrees, lies in the region.
+	///	</summary>
+	bool ContainsRLL_Deg(
+		double dLonDeg,
+		double dLatDeg
+	) const;
+
+	///	<summary>
+	///		Determine if a Face, given by its corners in order, intersects
+	///		the region.  Edges are treated as great circle arcs.  Corners
+	///		are not required to be normalized.
+	///	</summary>
+	bool IntersectsFace(
+		const Node * pCorners,
+		int nCorners
+	) const;
+
+	///	<summary>
+	///		Determine if the spherical cap of great circle radius dRadius
+	///		(in radians) about nodeCenter may intersect the region.  Only
+	///		the bounding box of the region is tested, so the result may be
+	///		true for caps that miss a polygon, but is never false for caps
+	///		that intersect the region.
+	///	</summary>
+	bool MayIntersectCap(
+		const Node & nodeCenter,
+		double dRadius
+	) const;
+
+protected:
+	///	<summary>
+	///		Type of region.
+	///	</summary>
+	Type m_eType;
+
+	///	<summary>
+	///		Western edge and longitudinal width of the box, or of the
+	///		bounding box of the polygon, in degrees.
+	///	</summary>
+	double m_dLonMinDeg;
+	double m_dLonWidthDeg;
+
+	///	<summary>
+	///		Latitude bounds of the box, or of the bounding box of the
+	///		polygon, in degrees.
+	///	</summary>
+	double m_dLatMinDeg;
+	double m_dLatMaxDeg;
+
+	///	<summary>
+	///		Polygon vertices.
+	///	</summary>
+	std::vector<Node> m_vecPolygon;
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -756,6 +968,19 @@ public:
 
     MeshType type;
 
+public:
+	///	<summary>
+	///		Policy for removing coincident nodes when reading a mesh.  Indexed
+	///		formats (such as Exodus, UGRID and MPAS) reference an explicit
+	///		node table and so typically do not require deduplication.
+	///	</summary>
+	enum CoincidentNodePolicy {
+		CoincidentNodePolicy_Never = 0,
+		CoincidentNodePolicy_Unindexed = 1,
+		CoincidentNodePolicy_Default = CoincidentNodePolicy_Unindexed,
+		CoincidentNodePolicy_Always = 2
+	};
+
 public:
 	///	<summary>
 	///		Filename for this mesh.
@@ -780,12 +1005,12 @@ public:
 	///	<summary>
 	///		Vector of first mesh Face indices.
 	///	</summary>
-	std::vector<int> vecSourceFaceIx;
+	std::vector<FaceIndex> vecSourceFaceIx;
 
 	///	<summary>
 	///		Vector of second mesh Face indices.
 	///	</summary>
-	std::vector<int> vecTargetFaceIx;
+	std::vector<FaceIndex> vecTargetFaceIx;
 
 	///	<summary>
 	///		Vector of Face areas.
@@ -811,7 +1036,20 @@ public:
 	///		Indices of the original Faces for this mesh (for use when
 	///		the original mesh has been subdivided).
 	///	</summary>
-	std::vector<int> vecMultiFaceMap;
+	std::vector<FaceIndex> vecMultiFaceMap;
+
+	///	<summary>
+	///		Indices of the Faces in the file this mesh was read from (for
+	///		use when only a region of the mesh has been read).
+	///	</summary>
+	std::vector<FaceIndex> vecGlobalFaceIx;
+
+	///	<summary>
+	///		Indices of the nodes in the file this mesh was read from (for
+	///		use when only a region of a mesh with a node table has been
+	///		read).
+	///	</summary>
+	std::vector<NodeIndex> vecGlobalNodeIx;
 
 public:
 	///	<summary>
@@ -829,13 +1067,13 @@ public:
 	///	</summary>
 	Mesh(
 		const std::string & strFile,
-		bool fRemoveCoincidentNodes = true,
+		CoincidentNodePolicy eCoincidentNodePolicy = CoincidentNodePolicy_Default,
 		double _coincident_node_tolerance = ReferenceTolerance
 	) :
 		type(MeshType_Unknown),
 		coincident_node_tolerance(_coincident_node_tolerance)
 	{
-		Read(strFile, fRemoveCoincidentNodes);
+		Read(strFile, eCoincidentNodePolicy);
 	}
 
 public:
@@ -873,9 +1111,21 @@ public:
 	///	</summary>
 	void ExchangeFirstAndSecondMesh();
 
+	///	<summary>
+	///		Determine if the Mesh contains any pair of nodes separated by
+	///		less than dTolerance.  Nodes are sorted by the cell of width
+	///		dTolerance that holds them and only nodes in the same or
+	///		adjacent cells are compared, so this check is much cheaper than
+	///		building a kd-tree.
+	///	</summary>
+	bool HasCoincidentNodes(
+		double dTolerance = ReferenceTolerance
+	) const;
+
 	///	<summary>
 	///		Remove coincident nodes from the Mesh and adjust indices in faces
-	///		using a kd-tree for nearest neighbor search.
+	///		using a kd-tree for nearest neighbor search.  If the Mesh is proven
+	///		to contain no coincident nodes the kd-tree is not constructed.
 	///	</summary>
 	void RemoveCoincidentNodes();
 
@@ -900,7 +1150,57 @@ public:
 	///	</summary>
 	void Read(
 		const std::string & strFile,
-		bool fRemoveCoincidentNodes = true
+		CoincidentNodePolicy eCoincidentNodePolicy = CoincidentNodePolicy_Default
+	);
+
+	///	<summary>
+	///		Read the mesh from a NetCDF file on a background thread.  The
+	///		Mesh must not be accessed until the returned future is ready.
+	///		Exceptions thrown by Read() are rethrown by future::get().
+	///	</summary>
+	std::future<void> ReadAsync(
+		const std::string & strFile,
+		CoincidentNodePolicy eCoincidentNodePolicy = CoincidentNodePolicy_Default
+	);
+
+	///	<summary>
+	///		Read the Faces of a mesh file that intersect a region of
+	///		interest (see MeshRegion).  For SCRIP files with grid_center_lat
+	///		and grid_center_lon the centers are read first, and only the
+	///		corner rows of Faces whose center lies within the largest cell
+	///		radius of the region are read and tested; otherwise the corner
+	///		arrays are streamed in chunks of rows.  For Exodus files
+	///		connectivity is streamed in chunks, reading only the node
+	///		coordinates each chunk references, so memory is proportional to
+	///		the chunk and the selection rather than the file.  Other
+	///		formats are read in full and then restricted.  The resulting
+	///		mesh is renumbered; vecGlobalFaceIx and (where the file has a
+	///		node table) vecGlobalNodeIx map back to indices in the file.
+	///	</summary>
+	void ReadRegion(
+		const std::string & strFile,
+		const MeshRegion & region,
+		CoincidentNodePolicy eCoincidentNodePolicy = CoincidentNodePolicy_Default
+	);
+
+	///	<summary>
+	///		Remove all Faces that do not intersect the region and renumber
+	///		the remaining Faces and nodes.  vecGlobalFaceIx and vecGlobalNodeIx
+	///		are set to the original indices.
+	///	</summary>
+	void RestrictToRegion(
+		const MeshRegion & region
+	);
+
+	///	<summary>
+	///		Determine the format and size of a mesh file using only its
+	///		header.  No large variables are read, so the call takes the same
+	///		time regardless of file size.  The NetCDF library is not
+	///		thread-safe, so many files are best probed from separate
+	///		processes.
+	///	</summary>
+	static MeshFileInfo Probe(
+		const std::string & strFile
 	);
 
 	///	<summary>
@@ -916,6 +1216,196 @@ public:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		A node on the unit sphere stored in single precision.
+///	</summary>
+class NodeF {
+
+public:
+	///	<summary>
+	///		Cartesian coordinates.
+	///	</summary>
+	float x;
+	float y;
+	float z;
+
+public:
+	///	<summary>
+	///		Default constructor.
+	///	</summary>
+	NodeF() :
+		x(0.0f),
+		y(0.0f),
+		z(0.0f)
+	{ }
+
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	NodeF(
+		float _x,
+		float _y,
+		float _z
+	) :
+		x(_x),
+		y(_y),
+		z(_z)
+	{ }
+};
+
+///	<summary>
+///		A vector of single precision nodes.
+///	</summary>
+typedef std::vector<NodeF> NodeFVector;
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A mesh with single precision nodes and compressed face connectivity,
+///		for visualization and binning where memory and bandwidth matter more
+///		than precision.  Face f has nodes vecFaceNodes[vecFaceBegin[f]]
+///		through vecFaceNodes[vecFaceBegin[f+1]-1]; edge types are only
+///		stored if some edge is not a great circle arc.  SCRIP and Exodus
+///		files are read directly in single precision; other formats are
+///		read with Mesh and then converted.
+///	</summary>
+class MeshF {
+
+public:
+	///	<summary>
+	///		Vector of nodes.
+	///	</summary>
+	NodeFVector nodes;
+
+	///	<summary>
+	///		Offset of the first node of each face in vecFaceNodes, plus a
+	///		final entry equal to vecFaceNodes.size().
+	///	</summary>
+	std::vector<size_t> vecFaceBegin;
+
+	///	<summary>
+	///		Node indices of all faces, stored contiguously.
+	///	</summary>
+	std::vector<NodeIndex> vecFaceNodes;
+
+	///	<summary>
+	///		Edge::Type of the edge from each node in vecFaceNodes to the
+	///		next node of its face, or empty if all edges are great circle
+	///		arcs.
+	///	</summary>
+	std::vector<unsigned char> vecFaceEdgeType;
+
+	///	<summary>
+	///		Tolerance for removing coincident nodes.
+	///	</summary>
+	float coincident_node_tolerance;
+
+public:
+	///	<summary>
+	///		Default constructor.
+	///	</summary>
+	MeshF(
+		float _coincident_node_tolerance = ReferenceToleranceF
+	) :
+		coincident_node_tolerance(_coincident_node_tolerance)
+	{ }
+
+public:
+	///	<summary>
+	///		Number of faces.
+	///	</summary>
+	size_t FaceCount() const {
+		return (vecFaceBegin.size() == 0)?(0):(vecFaceBegin.size() - 1);
+	}
+
+	///	<summary>
+	///		Number of nodes of face f.
+	///	</summary>
+	int FaceNodeCount(size_t f) const {
+		return static_cast<int>(vecFaceBegin[f+1] - vecFaceBegin[f]);
+	}
+
+	///	<summary>
+	///		Node ix of face f.
+	///	</summary>
+	NodeIndex FaceNode(size_t f, int ix) const {
+		return vecFaceNodes[vecFaceBegin[f] + ix];
+	}
+
+	///	<summary>
+	///		Type of the edge from node ix to node ix+1 of face f.
+	///	</summary>
+	Edge::Type FaceEdgeType(size_t f, int ix) const {
+		if (vecFaceEdgeType.size() == 0) {
+			return Edge::Type_GreatCircleArc;
+		}
+		return static_cast<Edge::Type>(vecFaceEdgeType[vecFaceBegin[f] + ix]);
+	}
+
+	///	<summary>
+	///		Clear the contents of the mesh.
+	///	</summary>
+	void Clear();
+
+	///	<summary>
+	///		Copy nodes and faces from a double precision Mesh.
+	///	</summary>
+	void FromMesh(
+		const Mesh & mesh
+	);
+
+	///	<summary>
+	///		Remove coincident nodes (within coincident_node_tolerance) and
+	///		adjust face indices, using a hash grid with cells of the size of
+	///		the tolerance.  If pfCancel is given it is checked periodically;
+	///		once it is set the mesh is left unchanged and false is returned.
+	///	</summary>
+	bool RemoveCoincidentNodes(
+		const std::atomic<bool> * pfCancel = NULL
+	);
+
+	///	<summary>
+	///		Read the mesh from a NetCDF file.  If pfCancel is given it is
+	///		checked between chunks; once it is set the mesh is cleared and
+	///		false is returned.  Exodus files must have in-range node
+	///		indices and unique global_ids covering every element.
+	///	</summary>
+	bool Read(
+		const std::string & strFile,
+		Mesh::CoincidentNodePolicy eCoincidentNodePolicy =
+			Mesh::CoincidentNodePolicy_Default,
+		const std::atomic<bool> * pfCancel = NULL
+	);
+
+	///	<summary>
+	///		Read a preview of a mesh with more than sFaceBudget faces: every
+	///		sStride-th face in file order, with sStride chosen so that at
+	///		most sFaceBudget faces are read.  Only the selected connectivity
+	///		rows are read, so this is much faster than Read for large SCRIP
+	///		and Exodus files.  Coincident nodes are not removed.  Returns
+	///		false, leaving the mesh empty, if the mesh is within the budget,
+	///		the format does not support partial reads or pfCancel is set.
+	///	</summary>
+	bool ReadPreview(
+		const std::string & strFile,
+		size_t sFaceBudget,
+		size_t & sStride,
+		const std::atomic<bool> * pfCancel = NULL
+	);
+
+	///	<summary>
+	///		Read the mesh from a NetCDF file on a background thread.  The
+	///		MeshF must not be accessed until the returned future is ready.
+	///	</summary>
+	std::future<void> ReadAsync(
+		const std::string & strFile,
+		Mesh::CoincidentNodePolicy eCoincidentNodePolicy =
+			Mesh::CoincidentNodePolicy_Default
+	);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Location data returned from FindFaceFromNode()
 ///		Generate a PathSegmentVector describing the path around the face
@@ -1050,6 +1540,29 @@ int BuildCoincidentNodeVector(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Calculate the area of a single Face by triangular decomposition and
+///		Order x Order point Gauss-Legendre quadrature on each triangle.
+///		Instantiated for orders 1 through GaussLegendreTableMaxOrder.
+///	</summary>
+template<int Order>
+Real CalculateFaceAreaQuadratureMethod(
+	const Face & face,
+	const NodeVector & nodes
+);
+
+///	<summary>
+///		Calculate the area of a single Face with quadrature of the given
+///		order, dispatching to the compile-time instantiation if one exists.
+///	</summary>
+Real CalculateFaceAreaQuadratureMethod(
+	const Face & face,
+	const NodeVector & nodes,
+	int nOrder = 6
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Calculate the area of a single Face.
 ///	</summary>
@@ -1060,6 +1573,480 @@ Real CalculateFaceArea(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Integrate a function over the spherical triangle obtained by central
+///		projection of the flat triangle with vertices node1, node2 and
+///		node3, using the given rule.  The function is called with points on
+///		the unit sphere and must return a double.  The integral is signed:
+///		positive if node1, node2 and node3 are counter-clockwise when seen
+///		from outside the sphere, so that the fan and subdivision triangles
+///		of a face add and cancel consistently.
+///	</summary>
+template<typename IntegrandType>
+Real IntegrateOverProjectedTriangle(
+	const Node & node1,
+	const Node & node2,
+	const Node & node3,
+	const TriangularQuadratureRule & rule,
+	IntegrandType & fnIntegrand
+) {
+	const DataArray2D<double> & dG = rule.GetG();
+	const DataArray1D<double> & dW = rule.GetW();
+
+	const int nPoints = rule.GetPoints();
+
+	// The signed area element of the projection F / |F| of the flat
+	// triangle is (F . N) / |F|^3 times the flat area element, where N is
+	// twice the oriented area vector of the triangle
+	const Node nodeNormal =
+		CrossProduct(node2 - node1, node3 - node1);
+
+	double dSum = 0.0;
+	for (int i = 0; i < nPoints; i++) {
+		Node nodeF(
+			dG(i,0) * node1.x + dG(i,1) * node2.x + dG(i,2) * node3.x,
+			dG(i,0) * node1.y + dG(i,1) * node2.y + dG(i,2) * node3.y,
+			dG(i,0) * node1.z + dG(i,1) * node2.z + dG(i,2) * node3.z);
+
+		const double dR2 = DotProduct(nodeF, nodeF);
+		const double dR = sqrt(dR2);
+
+		const double dJacobian =
+			DotProduct(nodeF, nodeNormal) / (dR2 * dR);
+
+		nodeF.x /= dR;
+		nodeF.y /= dR;
+		nodeF.z /= dR;
+
+		dSum += dW[i] * dJacobian * fnIntegrand(nodeF);
+	}
+
+	// Reference triangle has area 1/2
+	return 0.5 * dSum;
+}
+
+///	<summary>
+///		Unit integrand, used for computing areas with IntegrateOverFace()
+///		and IntegrateOverFaceAdaptive().
+///	</summary>
+struct UnitIntegrand {
+	double operator()(const Node &) const {
+		return 1.0;
+	}
+};
+
+///	<summary>
+///		Orientation of a Face: 1 if its nodes are counter-clockwise when
+///		seen from outside the sphere and -1 otherwise, from the sign of the
+///		vector area of the polygon through its nodes against their sum.
+///	</summary>
+inline double FaceOrientation(
+	const Face & face,
+	const NodeVector & nodes
+) {
+	const int nEdges = static_cast<int>(face.edges.size());
+
+	Node nodeSum(0.0, 0.0, 0.0);
+	Node nodeArea(0.0, 0.0, 0.0);
+	for (int k = 0; k < nEdges; k++) {
+		const Node & node1 = nodes[face[k]];
+		const Node & node2 = nodes[face[(k+1) % nEdges]];
+
+		nodeSum += node1;
+		nodeArea += CrossProduct(node1, node2);
+	}
+
+	return (DotProduct(nodeSum, nodeArea) >= 0.0)?(1.0):(-1.0);
+}
+
+///	<summary>
+///		Integrate a function over a single Face on the unit sphere.  The
+///		face is split into a fan of triangles about its first node and each
+///		triangle is integrated with IntegrateOverProjectedTriangle(); fan
+///		triangles that fold back over the face are subtracted, and the sum
+///		is taken relative to the orientation of the face.  All edges are
+///		treated as great circle arcs.
+///	</summary>
+template<typename IntegrandType>
+Real IntegrateOverFace(
+	const Face & face,
+	const NodeVector & nodes,
+	const TriangularQuadratureRule & rule,
+	IntegrandType fnIntegrand
+) {
+	const int nTriangles = static_cast<int>(face.edges.size()) - 2;
+
+	double dIntegral = 0.0;
+
+	for (int j = 0; j < nTriangles; j++) {
+		dIntegral += IntegrateOverProjectedTriangle(
+			nodes[face[0]], nodes[face[j+1]], nodes[face[j+2]],
+			rule, fnIntegrand);
+	}
+
+	return FaceOrientation(face, nodes) * dIntegral;
+}
+
+///	<summary>
+///		Calculate the area of a single Face using a symmetric triangular
+///		quadrature rule.
+///	</summary>
+Real CalculateFaceAreaTriangularQuadrature(
+	const Face & face,
+	const NodeVector & nodes,
+	const TriangularQuadratureRule & rule
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Signed area between a constant latitude arc from node1 to node2
+///		and the great circle arc with the same endpoints, positive if the
+///		constant latitude arc lies to the right of the great circle arc
+///		(so that it adds to the area of a counter-clockwise face).
+///	</summary>
+inline double ConstantLatitudeLuneArea(
+	const Node & node1,
+	const Node & node2
+) {
+	// Arcs in the southern hemisphere are reflected onto the northern
+	// hemisphere, which reverses orientation; this keeps t below one and
+	// the area finite for arcs through the south pole
+	if (node1.z < 0.0) {
+		return - ConstantLatitudeLuneArea(
+			Node(node1.x, node1.y, - node1.z),
+			Node(node2.x, node2.y, - node2.z));
+	}
+
+	const double dZ = node1.z;
+
+	// Signed longitude difference, taking the shorter way around
+	const double dDeltaLon = atan2(
+		node1.x * node2.y - node1.y * node2.x,
+		node1.x * node2.x + node1.y * node2.y);
+
+	// Area between the arc and the north pole: the polar sector for the
+	// constant latitude arc and the polar triangle for the great circle
+	// arc, where t = tan^2 of half the colatitude
+	const double dT = (1.0 - dZ) / (1.0 + dZ);
+	const double dAbsDeltaLon = fabs(dDeltaLon);
+
+	const double dSector = dAbsDeltaLon * (1.0 - dZ);
+	const double dTriangle = 2.0 * atan2(
+		dT * sin(dAbsDeltaLon), 1.0 + dT * cos(dAbsDeltaLon));
+
+	return (dDeltaLon >= 0.0)?(dSector - dTriangle):(dTriangle - dSector);
+}
+
+///	<summary>
+///		Midpoint of an edge of the given type on the unit sphere.
+///	</summary>
+inline Node EdgeMidpoint(
+	const Node & node1,
+	const Node & node2,
+	Edge::Type type
+) {
+	Node nodeMid(
+		0.5 * (node1.x + node2.x),
+		0.5 * (node1.y + node2.y),
+		0.5 * (node1.z + node2.z));
+
+	if (type == Edge::Type_ConstantLatitude) {
+		const double dZ = node1.z;
+		const double dRxy = sqrt(nodeMid.x * nodeMid.x + nodeMid.y * nodeMid.y);
+		const double dScale = sqrt(std::max(0.0, 1.0 - dZ * dZ)) / dRxy;
+		return Node(nodeMid.x * dScale, nodeMid.y * dScale, dZ);
+	}
+
+	const double dMag = nodeMid.Magnitude();
+	return Node(nodeMid.x / dMag, nodeMid.y / dMag, nodeMid.z / dMag);
+}
+
+///	<summary>
+///		Parameters and work counters for adaptive face integration.
+///	</summary>
+struct AdaptiveIntegrationParameters {
+
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	AdaptiveIntegrationParameters(
+		double _dRelTolerance = 1.0e-10,
+		double _dAbsTolerance = 0.0,
+		int _nMaxDepth = 12
+	) :
+		dRelTolerance(_dRelTolerance),
+		dAbsTolerance(_dAbsTolerance),
+		nMaxDepth(_nMaxDepth),
+		ruleLow(4),
+		ruleHigh(8)
+	{ }
+
+	///	<summary>
+	///		Tolerance on the integral over each face relative to the
+	///		integral of the absolute value of the integrand.
+	///	</summary>
+	double dRelTolerance;
+
+	///	<summary>
+	///		Absolute tolerance on the integral over each face.
+	///	</summary>
+	double dAbsTolerance;
+
+	///	<summary>
+	///		Maximum number of subdivisions of any triangle.
+	///	</summary>
+	int nMaxDepth;
+
+	///	<summary>
+	///		Pair of rules whose difference estimates the quadrature error.
+	///	</summary>
+	TriangularQuadratureRule ruleLow;
+	TriangularQuadratureRule ruleHigh;
+};
+
+///	<summary>
+///		Result of adaptive integration over a single Face.
+///	</summary>
+struct AdaptiveIntegrationResult {
+
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	AdaptiveIntegrationResult() :
+		dIntegral(0.0),
+		dErrorEstimate(0.0),
+		nTriangles(0),
+		fConverged(true)
+	{ }
+
+	///	<summary>
+	///		Integral over the face.
+	///	</summary>
+	double dIntegral;
+
+	///	<summary>
+	///		Sum of the error estimates of all accepted triangles.
+	///	</summary>
+	double dErrorEstimate;
+
+	///	<summary>
+	///		Number of triangles integrated (each with both rules).
+	///	</summary>
+	int nTriangles;
+
+	///	<summary>
+	///		False if the maximum depth was reached on some triangle before
+	///		its share of the tolerance was met and the total error
+	///		estimate over the face exceeds the tolerance, or if the error
+	///		estimate is NaN.
+	///	</summary>
+	bool fConverged;
+};
+
+///	<summary>
+///		Recursively integrate over a spherical triangle with vertices
+///		node[0..2] and edges of type eType[k] from node[k] to node[k+1].
+///		Constant latitude edges are accounted for by a one point correction
+///		over the lune between the arc and the corresponding great circle.
+///		All contributions are signed relative to dOrientation, the
+///		orientation of the parent face, so that triangles which fold over
+///		when a latitude arc crosses a fan or subdivision edge are
+///		subtracted rather than added.
+///	</summary>
+template<typename IntegrandType>
+void IntegrateOverSphericalTriangleAdaptive(
+	const Node node[3],
+	const Edge::Type eType[3],
+	double dOrientation,
+	double dTolerance,
+	int nDepth,
+	const AdaptiveIntegrationParameters & param,
+	IntegrandType & fnIntegrand,
+	AdaptiveIntegrationResult & result
+) {
+	const double dLow = dOrientation * IntegrateOverProjectedTriangle(
+		node[0], node[1], node[2], param.ruleLow, fnIntegrand);
+	const double dHigh = dOrientation * IntegrateOverProjectedTriangle(
+		node[0], node[1], node[2], param.ruleHigh, fnIntegrand);
+
+	result.nTriangles++;
+
+	double dIntegral = dHigh;
+	double dError = fabs(dHigh - dLow);
+
+	// Lune corrections, oriented with the parent face
+	for (int k = 0; k < 3; k++) {
+		if (eType[k] != Edge::Type_ConstantLatitude) {
+			continue;
+		}
+
+		const Node & node1 = node[k];
+		const Node & node2 = node[(k+1)%3];
+
+		const double dLune =
+			dOrientation * ConstantLatitudeLuneArea(node1, node2);
+
+		Node nodeMidLat = EdgeMidpoint(node1, node2, Edge::Type_ConstantLatitude);
+		Node nodeMidGC = EdgeMidpoint(node1, node2, Edge::Type_GreatCircleArc);
+		Node nodeMid = EdgeMidpoint(nodeMidLat, nodeMidGC, Edge::Type_GreatCircleArc);
+
+		const double dMidLat = fnIntegrand(nodeMidLat);
+		const double dMidGC = fnIntegrand(nodeMidGC);
+
+		dIntegral += dLune * fnIntegrand(nodeMid);
+		dError += fabs(dLune) * fabs(dMidLat - dMidGC);
+	}
+
+	// NaN estimates (degenerate triangles) are not refined further and are
+	// reported as not converged
+	if ((dError <= dTolerance)
+		|| (nDepth >= param.nMaxDepth)
+		|| std::isnan(dError)
+	) {
+		if (!(dError <= dTolerance)) {
+			result.fConverged = false;
+		}
+		result.dIntegral += dIntegral;
+		result.dErrorEstimate += dError;
+		return;
+	}
+
+	// Subdivide into four triangles; new interior edges are great circles
+	const Edge::Type GC = Edge::Type_GreatCircleArc;
+
+	const Node nodeMid[3] = {
+		EdgeMidpoint(node[0], node[1], eType[0]),
+		EdgeMidpoint(node[1], node[2], eType[1]),
+		EdgeMidpoint(node[2], node[0], eType[2])
+	};
+
+	const Node nodeChild[4][3] = {
+		{node[0], nodeMid[0], nodeMid[2]},
+		{nodeMid[0], node[1], nodeMid[1]},
+		{nodeMid[2], nodeMid[1], node[2]},
+		{nodeMid[0], nodeMid[1], nodeMid[2]}
+	};
+	const Edge::Type eTypeChild[4][3] = {
+		{eType[0], GC, eType[2]},
+		{eType[0], eType[1], GC},
+		{GC, eType[1], eType[2]},
+		{GC, GC, GC}
+	};
+
+	for (int c = 0; c < 4; c++) {
+		IntegrateOverSphericalTriangleAdaptive(
+			nodeChild[c], eTypeChild[c], dOrientation,
+			0.25 * dTolerance, nDepth + 1,
+			param, fnIntegrand, result);
+	}
+}
+
+///	<summary>
+///		Integrate a function over a single Face on the unit sphere to
+///		within the tolerances in param, comparing two quadrature rules on
+///		each triangle of the face and subdividing triangles whose error
+///		estimate is too large.  Both great circle and constant latitude
+///		edges are supported.
+///	</summary>
+template<typename IntegrandType>
+AdaptiveIntegrationResult IntegrateOverFaceAdaptive(
+	const Face & face,
+	const NodeVector & nodes,
+	const AdaptiveIntegrationParameters & param,
+	IntegrandType fnIntegrand
+) {
+	AdaptiveIntegrationResult result;
+
+	const int nEdges = static_cast<int>(face.edges.size());
+	const int nTriangles = nEdges - 2;
+
+	// Scale the relative tolerance by the integral of |f| from the fixed
+	// rule, so that integrands that cancel over the face do not force
+	// subdivision to the maximum depth.  The relative tolerance is never
+	// taken below roundoff in the sum of the triangle contributions.
+	const double dRoundoffTolerance =
+		64.0 * std::numeric_limits<double>::epsilon();
+
+	auto fnAbsIntegrand = [&fnIntegrand](const Node & node) {
+		return fabs(fnIntegrand(node));
+	};
+
+	const double dAbsEstimate =
+		fabs(IntegrateOverFace(face, nodes, param.ruleHigh, fnAbsIntegrand));
+
+	const double dOrientation = FaceOrientation(face, nodes);
+
+	const double dTolerance =
+		std::max(param.dAbsTolerance,
+			std::max(param.dRelTolerance, dRoundoffTolerance) * dAbsEstimate)
+		/ static_cast<double>(nTriangles);
+
+	for (int j = 0; j < nTriangles; j++) {
+		const Node node[3] = {
+			nodes[face[0]], nodes[face[j+1]], nodes[face[j+2]]
+		};
+
+		// Fan edges inside the face are great circle arcs
+		const Edge::Type eType[3] = {
+			(j == 0)?(face.edges[0].type):(Edge::Type_GreatCircleArc),
+			face.edges[j+1].type,
+			(j == nTriangles-1)?(face.edges[nEdges-1].type):(Edge::Type_GreatCircleArc)
+		};
+
+		IntegrateOverSphericalTriangleAdaptive(
+			node, eType, dOrientation, dTolerance, 0,
+			param, fnIntegrand, result);
+	}
+
+	// Triangles at the maximum depth may miss their share of the tolerance
+	// while the face as a whole meets it
+	if (result.dErrorEstimate <= dTolerance * static_cast<double>(nTriangles)) {
+		result.fConverged = true;
+	}
+
+	return result;
+}
+
+///	<summary>
+///		Integrate a function adaptively over every Face of a Mesh, in
+///		parallel batches of faces.  The integrand must be safe to call
+///		concurrently.  Returns the number of faces that did not converge.
+///	</summary>
+template<typename IntegrandType>
+int IntegrateOverFacesAdaptive(
+	const Mesh & mesh,
+	const AdaptiveIntegrationParameters & param,
+	IntegrandType fnIntegrand,
+	DataArray1D<double> & dIntegral
+) {
+	const int FaceBatchSize = 256;
+
+	const long lFaces = static_cast<long>(mesh.faces.size());
+
+	dIntegral.Allocate(lFaces);
+
+	int nNotConverged = 0;
+
+#pragma omp parallel for schedule(dynamic, FaceBatchSize) reduction(+:nNotConverged)
+	for (long f = 0; f < lFaces; f++) {
+		IntegrandType fnLocal(fnIntegrand);
+
+		AdaptiveIntegrationResult result =
+			IntegrateOverFaceAdaptive(
+				mesh.faces[f], mesh.nodes, param, fnLocal);
+
+		dIntegral[f] = result.dIntegral;
+		if (!result.fConverged) {
+			nNotConverged++;
+		}
+	}
+
+	return nNotConverged;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///	<summary>
 ///		Find a node within the specified quadrilateral.
 ///	</summary>
@@ -1105,5 +2092,59 @@ inline Node InterpolateQuadrilateralNode(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+///	<summary>
+///		Generate the nP x nP Gauss-Lobatto-Legendre nodes of a spectral
+///		element discretization on every Face of a mesh of quadrilaterals.
+///		Points shared between Faces are numbered once using the mesh
+///		topology rather than a spatial search, so coincident nodes must
+///		already have been removed.  The EdgeMap is constructed if empty.
+///		nodesGLL receives the mesh nodes, then nP-2 points per edge of the
+///		EdgeMap, then (nP-2)^2 interior points per Face.  vecGLLNodeIx
+///		receives faces.size() * nP * nP indices into nodesGLL, where
+///		point (i,j) of Face f is entry (f * nP + j) * nP + i and lies at
+///		reference coordinates (G[i], G[j]) of InterpolateQuadrilateralNode()
+///		on the Face nodes.  Faces and edges are processed in parallel.
+///	</summary>
+void GenerateMeshGLLNodes(
+	Mesh & mesh,
+	int nP,
+	NodeVector & nodesGLL,
+	std::vector<NodeIndex> & vecGLLNodeIx
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Invert InterpolateQuadrilateralNode() for a batch of points on the
+///		unit sphere, each paired with the quadrilateral Face that contains
+///		it (typically found by a point locator).  The local coordinates
+///		(dAlpha, dBeta) are found by Gauss-Newton iteration on Q(a,b) x P = 0,
+///		where Q is the bilinear map of the Face nodes, starting from the
+///		exact inverse of the parallelogram that approximates the Face about
+///		its center.  Points are processed in tiles so that the iteration
+///		vectorizes across points.  Points outside the Face still receive
+///		coordinates (outside [0,1]).  If iConverged is not NULL it is set
+///		to 1 for points that converged to dTolerance and 0 otherwise
+///		(including Faces that are not quadrilaterals); the number of points
+///		that did not converge is returned.  Points whose ixFace is outside
+///		of faces are counted as not converged and receive NaN coordinates.
+///	</summary>
+size_t InverseInterpolateQuadrilateralNode_Batch(
+	const FaceVector & faces,
+	const NodeVector & nodes,
+	size_t sCount,
+	const double * dX,
+	const double * dY,
+	const double * dZ,
+	const FaceIndex * ixFace,
+	double * dAlpha,
+	double * dBeta,
+	int * iConverged = NULL,
+	double dTolerance = 1.0e-12,
+	int nMaxIterations = 10
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
 #endif
 
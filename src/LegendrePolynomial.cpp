@@ -20,6 +20,7 @@
 #include <cmath>
 #include <cstring>
 #include <algorithm>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -144,6 +145,169 @@ double LegendrePolynomial::EvaluateDerivative(
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void LegendrePolynomial::EvaluateValueAndDerivative_Batch(
+	int nDegree,
+	size_t sCount,
+	const double * dX,
+	double * dValue,
+	double * dDerivative
+) {
+	if (nDegree < 0) {
+		_EXCEPTION1("Invalid degree (%i)", nDegree);
+	}
+	if ((dX == NULL) || (dValue == NULL)) {
+		_EXCEPTIONT("NULL pointer passed into EvaluateValueAndDerivative_Batch");
+	}
+
+	// Recurrence coefficients, so that the inner loop contains no divisions
+	std::vector<double> dA(nDegree + 1);
+	std::vector<double> dB(nDegree + 1);
+	for (int k = 2; k <= nDegree; k++) {
+		dA[k] = static_cast<double>(2 * k - 1) / static_cast<double>(k);
+		dB[k] = static_cast<double>(k - 1) / static_cast<double>(k);
+	}
+
+	// Values and derivatives of degree k-1 and k for each tile of points
+	const size_t TileSize = 256;
+
+	double dP0[TileSize];
+	double dP1[TileSize];
+	double dD1[TileSize];
+
+	for (size_t s = 0; s < sCount; s += TileSize) {
+		const size_t sTile = std::min(TileSize, sCount - s);
+		const double * dXTile = dX + s;
+
+		for (size_t i = 0; i < sTile; i++) {
+			dP0[i] = 1.0;
+			dP1[i] = (nDegree == 0)?(1.0):(dXTile[i]);
+			dD1[i] = (nDegree == 0)?(0.0):(1.0);
+		}
+
+		for (int k = 2; k <= nDegree; k++) {
+			const double dAk = dA[k];
+			const double dBk = dB[k];
+			const double dK = static_cast<double>(k);
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+			for (size_t i = 0; i < sTile; i++) {
+				double dPk = dAk * dXTile[i] * dP1[i] - dBk * dP0[i];
+				dD1[i] = dXTile[i] * dD1[i] + dK * dP1[i];
+				dP0[i] = dP1[i];
+				dP1[i] = dPk;
+			}
+		}
+
+		memcpy(dValue + s, dP1, sTile * sizeof(double));
+		if (dDerivative != NULL) {
+			memcpy(dDerivative + s, dD1, sTile * sizeof(double));
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void LegendrePolynomial::VandermondeMatrix(
+	int nMaxDegree,
+	const DataArray1D<double> & dX,
+	DataArray2D<double> & dV,
+	DataArray2D<double> * pdDV
+) {
+	if (nMaxDegree < 0) {
+		_EXCEPTION1("Invalid degree (%i)", nMaxDegree);
+	}
+
+	const size_t sCount = dX.GetRows();
+	const size_t sColumns = static_cast<size_t>(nMaxDegree) + 1;
+
+	dV.Allocate(sCount, sColumns);
+	if (pdDV != NULL) {
+		pdDV->Allocate(sCount, sColumns);
+	}
+	if (sCount == 0) {
+		return;
+	}
+
+	std::vector<double> dA(sColumns);
+	std::vector<double> dB(sColumns);
+	for (int k = 2; k <= nMaxDegree; k++) {
+		dA[k] = static_cast<double>(2 * k - 1) / static_cast<double>(k);
+		dB[k] = static_cast<double>(k - 1) / static_cast<double>(k);
+	}
+
+	// Each tile of points is evaluated degree-major into a scratch buffer,
+	// vectorized across points, and then transposed into the output rows
+	const size_t TileSize = 64;
+
+	const long lTiles = static_cast<long>((sCount + TileSize - 1) / TileSize);
+
+#pragma omp parallel
+	{
+		std::vector<double> dPTile(sColumns * TileSize);
+		std::vector<double> dDTile(sColumns * TileSize);
+
+#pragma omp for schedule(static)
+		for (long t = 0; t < lTiles; t++) {
+			const size_t s = static_cast<size_t>(t) * TileSize;
+			const size_t sTile = std::min(TileSize, sCount - s);
+			const double * dXTile = &(dX[s]);
+
+			double * dP = &(dPTile[0]);
+			double * dD = &(dDTile[0]);
+
+			for (size_t i = 0; i < sTile; i++) {
+				dP[i] = 1.0;
+				dD[i] = 0.0;
+			}
+			if (nMaxDegree >= 1) {
+				for (size_t i = 0; i < sTile; i++) {
+					dP[TileSize + i] = dXTile[i];
+					dD[TileSize + i] = 1.0;
+				}
+			}
+
+			for (int k = 2; k <= nMaxDegree; k++) {
+				const double dAk = dA[k];
+				const double dBk = dB[k];
+				const double dK = static_cast<double>(k);
+
+				const double * dP0 = dP + (k - 2) * TileSize;
+				const double * dP1 = dP + (k - 1) * TileSize;
+				const double * dD1 = dD + (k - 1) * TileSize;
+				double * dPk = dP + k * TileSize;
+				double * dDk = dD + k * TileSize;
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+				for (size_t i = 0; i < sTile; i++) {
+					dPk[i] = dAk * dXTile[i] * dP1[i] - dBk * dP0[i];
+					dDk[i] = dXTile[i] * dD1[i] + dK * dP1[i];
+				}
+			}
+
+			for (size_t i = 0; i < sTile; i++) {
+				double * dVRow = &(dV[s + i][0]);
+				for (size_t k = 0; k < sColumns; k++) {
+					dVRow[k] = dP[k * TileSize + i];
+				}
+			}
+			if (pdDV != NULL) {
+				for (size_t i = 0; i < sTile; i++) {
+					double * dDVRow = &((*pdDV)[s + i][0]);
+					for (size_t k = 0; k < sColumns; k++) {
+						dDVRow[k] = dD[k * TileSize + i];
+					}
+				}
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 double LegendrePolynomial::DerivativeRoot(
 	int nDegree,
 	int nRoot
@@ -580,12 +744,191 @@ double LegendrePolynomial::EvaluateCharacteristic(
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void LegendrePolynomial::AllRoots(
+///	<summary>
+///		First 20 zeros of the Bessel function J0.
+///	</summary>
+static const double BesselJ0Zeros[20] = {
+	 2.4048255576957728,  5.5200781102863106,  8.6537279129110122,
+	11.791534439014282,  14.930917708487786,  18.071063967910923,
+	21.211636629879259,  24.352471530749303,  27.493479132040255,
+	30.634606468431975,  33.775820213573569,  36.917098353664044,
+	40.058425764628239,  43.199791713176730,  46.341188371661814,
+	49.482609897397817,  52.624051841114996,  55.765510755019979,
+	58.906983926080942,  62.048469190227170
+};
+
+///	<summary>
+///		Square of the Bessel function J1 at the first 21 zeros of J0.
+///	</summary>
+static const double BesselJ1SquaredAtJ0Zeros[21] = {
+	0.26951412394191693,  0.11578013858220370,  0.073686351136408215,
+	0.054037573198116282, 0.042661429017243091, 0.035242103490996101,
+	0.030021070103054673, 0.026147391495308089, 0.023159121824691392,
+	0.020783829122267858, 0.018850450669317668, 0.017246157569665008,
+	0.015893518105923598, 0.014737626096472190, 0.013738465145387118,
+	0.012866181737615133, 0.012098051548626798, 0.011416471224491609,
+	0.010807592791180204, 0.010260372926280763, 0.0097658971397910505
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		The k-th zero (k >= 1) of the Bessel function J0, using McMahon's
+///		expansion beyond the tabulated values.
+///	</summary>
+static double BesselJ0Zero(
+	int k
+) {
+	if (k <= 20) {
+		return BesselJ0Zeros[k-1];
+	}
+
+	double dZ = M_PI * (static_cast<double>(k) - 0.25);
+	double dR = 1.0 / dZ;
+	double dR2 = dR * dR;
+
+	return dZ + dR * (0.125 + dR2 * (-0.807291666666666666666666666667e-1
+		+ dR2 * (0.246028645833333333333333333333
+		+ dR2 * (-1.82443876720610119047619047619
+		+ dR2 * (25.3364147973439050099206349206
+		+ dR2 * (-567.644412135183381139802038240
+		+ dR2 * (18690.4765282320653831636345064
+		+ dR2 * (-8.49353580299148769921876983660e5
+		+ dR2 * 5.09225462402226769498681286758e7))))))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Square of J1 at the k-th zero (k >= 1) of J0, using an asymptotic
+///		expansion beyond the tabulated values.
+///	</summary>
+static double BesselJ1SquaredAtJ0Zero(
+	int k
+) {
+	if (k <= 21) {
+		return BesselJ1SquaredAtJ0Zeros[k-1];
+	}
+
+	double dX = 1.0 / (static_cast<double>(k) - 0.25);
+	double dX2 = dX * dX;
+
+	return dX * (0.202642367284675542887091596703
+		+ dX2 * dX2 * (-0.303380429711290253026202643516e-3
+		+ dX2 * (0.198924364245969295201137972743e-3
+		+ dX2 * (-0.228969902772111653038747229723e-3
+		+ dX2 * (0.433710719130746277915572905025e-3
+		+ dX2 * (-0.123632349727175414724737657367e-2
+		+ dX2 * (0.496101423268883102872271417616e-2
+		+ dX2 * (-0.266837393702323757700998557826e-1
+		+ dX2 * 0.185395398206345628711318848386))))))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Asymptotic approximation to the k-th (k >= 1) Gauss-Legendre node,
+///		as dTheta = arccos(x), and its weight for a rule with nDegree points.
+///		Adapted from I. Bogaert (2014) "Iteration-free computation of
+///		Gauss-Legendre quadrature nodes and weights", SIAM J. Sci. Comput.
+///	</summary>
+static void GaussLegendreAsymptotic(
 	int nDegree,
-	double * dRoots
+	int k,
+	double & dTheta,
+	double & dWeight
 ) {
-	// Iteration tolerance
-	const double IterationTolerance = 1.0e-14;
+	const double dW = 1.0 / (static_cast<double>(nDegree) + 0.5);
+	const double dNu = BesselJ0Zero(k);
+	const double dB = BesselJ1SquaredAtJ0Zero(k);
+
+	dTheta = dW * dNu;
+	const double dX = dTheta * dTheta;
+
+	// Chebyshev interpolants for the nodes
+	double dSF1T = (((((-1.29052996274280508473467968379e-12 * dX
+		+ 2.40724685864330121825976175184e-10) * dX
+		- 3.13148654635992041468855740012e-8) * dX
+		+ 0.275573168962061235623801563453e-5) * dX
+		- 0.148809523713909147898955880165e-3) * dX
+		+ 0.416666666665193394525296923981e-2) * dX
+		- 0.416666666666662959639712457549e-1;
+
+	double dSF2T = (((((+2.20639421781871003734786884322e-9 * dX
+		- 7.53036771373769326811030753538e-8) * dX
+		+ 0.161969259453836261731700382098e-5) * dX
+		- 0.253300326008232025914059965302e-4) * dX
+		+ 0.282116886057560434805998583817e-3) * dX
+		- 0.209022248387852902722635654229e-2) * dX
+		+ 0.815972221772932265640401128517e-2;
+
+	double dSF3T = (((((-2.97058225375526229899781956673e-8 * dX
+		+ 5.55845330223796209655886325712e-7) * dX
+		- 0.567797841356833081642185432056e-5) * dX
+		+ 0.418498100329504574443885193835e-4) * dX
+		- 0.251395293283965914823026348764e-3) * dX
+		+ 0.128654198542845137196151147483e-2) * dX
+		- 0.416012165620204364833694266818e-2;
+
+	// Chebyshev interpolants for the weights
+	double dWSF1T = ((((((((-2.20902861044616638398573427475e-14 * dX
+		+ 2.30365726860377376873232578871e-12) * dX
+		- 1.75257700735423807659851042318e-10) * dX
+		+ 1.03756066927916795821098009353e-8) * dX
+		- 4.63968647553221331251529631098e-7) * dX
+		+ 0.149644593625028648361395938176e-4) * dX
+		- 0.326278659594412170300449074873e-3) * dX
+		+ 0.436507936507598105249726413120e-2) * dX
+		- 0.305555555555553028279487898503e-1) * dX
+		+ 0.833333333333333302184063103900e-1;
+
+	double dWSF2T = (((((((+3.63117412152654783455929483029e-12 * dX
+		+ 7.67643545069893130779501844323e-11) * dX
+		- 7.12912857233642220650643150625e-9) * dX
+		+ 2.11483880685947151466370130277e-7) * dX
+		- 0.381817918680045468483009307090e-5) * dX
+		+ 0.465969530694968391417927388162e-4) * dX
+		- 0.407297185611335764191683161117e-3) * dX
+		+ 0.268959435694729660779984493795e-2) * dX
+		- 0.111111111111214923138249347172e-1;
+
+	double dWSF3T = (((((((+2.01826791256703301806643264922e-9 * dX
+		- 4.38647122520206649251063212545e-8) * dX
+		+ 5.08898347288671653137451093208e-7) * dX
+		- 0.397933316519135275712977531366e-5) * dX
+		+ 0.200559326396458326778521795392e-4) * dX
+		- 0.422888059282921161626339411388e-4) * dX
+		- 0.105646050254076140548678457002e-3) * dX
+		- 0.947969308958577323145923317955e-4) * dX
+		+ 0.656966489926484797412985260842e-2;
+
+	// Combine the expansions
+	const double dNuOverSin = dNu / sin(dTheta);
+	const double dBNuOverSin = dB * dNuOverSin;
+	const double dWInvSinc = dW * dW * dNuOverSin;
+	const double dWIS2 = dWInvSinc * dWInvSinc;
+
+	dTheta = dW * (dNu + dTheta * dWInvSinc
+		* (dSF1T + dWIS2 * (dSF2T + dWIS2 * dSF3T)));
+
+	const double dDenominator = dBNuOverSin + dBNuOverSin * dWIS2
+		* (dWSF1T + dWIS2 * (dWSF2T + dWIS2 * dWSF3T));
+
+	dWeight = (2.0 * dW) / dDenominator;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void LegendrePolynomial::AllRootsAndWeights(
+	int nDegree,
+	double * dRoots,
+	double * dWeights
+) {
+	// Below this degree the asymptotic expansions are refined with Newton
+	const int AsymptoticMinDegree = 101;
+
+	// Minimum degree for evaluating roots in parallel
+	const int ParallelMinDegree = 10000;
 
 	// Check for degree 0
 	if (nDegree == 0) {
@@ -597,65 +940,84 @@ void LegendrePolynomial::AllRoots(
 		_EXCEPTION1("Invalid degree (%i)", nDegree);
 	}
 
-	// Check for NULL dRoots pointer
-	if (dRoots == NULL) {
-		_EXCEPTIONT("NULL pointer passed into AllRoots argument dRoots");
-	}
-
-	// Double degree
-	double dDegree = static_cast<double>(nDegree);
-
-	// Additional storage for roots
-	double * dBuffer = new double[nDegree];
-
-	// Set initial estimate
-	for (int k = 0; k < nDegree; k++) {
-		dRoots[k] = (static_cast<double>(k) + 0.5) * 2.0 / dDegree  - 1.0;
+	// Check for NULL pointers
+	if ((dRoots == NULL) || (dWeights == NULL)) {
+		_EXCEPTIONT("NULL pointer passed into AllRootsAndWeights");
 	}
 
-	// Refine estimate using Aberth-Ehrlich method
-	for (int iter = 0; iter < nDegree + 10; iter++) {
-
-		int nFoundRoots = 0;
+	// Roots are symmetric about the origin, so only compute the positive
+	// roots (from largest to smallest) and reflect
+	const int nHalf = (nDegree + 1) / 2;
+
+#pragma omp parallel for if (nDegree >= ParallelMinDegree)
+	for (int k = 1; k <= nHalf; k++) {
+		double dTheta;
+		double dWeight;
+		GaussLegendreAsymptotic(nDegree, k, dTheta, dWeight);
+
+		double dX = cos(dTheta);
+
+		if (nDegree < AsymptoticMinDegree) {
+			double dDerivative = 0.0;
+			for (int iter = 0; iter < 10; iter++) {
+				double dPnm1 = 1.0;
+				double dPn = dX;
+				for (int j = 2; j <= nDegree; j++) {
+					double dPnp1 = (static_cast<double>(2 * j - 1) * dX * dPn
+						- static_cast<double>(j - 1) * dPnm1)
+						/ static_cast<double>(j);
+					dPnm1 = dPn;
+					dPn = dPnp1;
+				}
+				dDerivative = static_cast<double>(nDegree)
+					* (dX * dPn - dPnm1) / (dX * dX - 1.0);
 
-		for (int k = 0; k < nDegree; k++) {
-			double dValue;
-			double dDerivative;
+				double dDelta = dPn / dDerivative;
+				dX -= dDelta;
+				if (fabs(dDelta) < 1.0e-15) {
+					break;
+				}
+			}
+			dWeight = 2.0 / ((1.0 - dX * dX) * dDerivative * dDerivative);
+		}
 
-			EvaluateValueAndDerivative(nDegree, dRoots[k], dValue, dDerivative);
+		dRoots[nDegree - k] = dX;
+		dWeights[nDegree - k] = dWeight;
 
-			if (fabs(dValue) < IterationTolerance) {
-				nFoundRoots++;
-				dBuffer[k] = dRoots[k];
-				continue;
-			}
+		dRoots[k - 1] = -dX;
+		dWeights[k - 1] = dWeight;
+	}
 
-			double dMod = 0.0;
-			for (int l = 0; l < nDegree; l++) {
-				if (l == k) {
-					continue;
-				}
+	// Odd degrees have a root at the origin
+	if (nDegree % 2 == 1) {
+		dRoots[nHalf - 1] = 0.0;
+	}
+}
 
-				dMod += 1.0 / (dRoots[k] - dRoots[l]);
-			}
+///////////////////////////////////////////////////////////////////////////////
 
-			dBuffer[k] = dRoots[k] - 1.0 / (dDerivative / dValue - dMod);
-		}
+void LegendrePolynomial::AllRoots(
+	int nDegree,
+	double * dRoots
+) {
+	// Check for degree 0
+	if (nDegree == 0) {
+		return;
+	}
 
-		// Copy buffer to roots
-		memcpy(dRoots, dBuffer, nDegree * sizeof(double));
+	// Check for negative degree
+	if (nDegree < 0) {
+		_EXCEPTION1("Invalid degree (%i)", nDegree);
+	}
 
-		// Check if all roots have been found
-		if (nFoundRoots == nDegree) {
-			break;
-		}
+	// Check for NULL dRoots pointer
+	if (dRoots == NULL) {
+		_EXCEPTIONT("NULL pointer passed into AllRoots argument dRoots");
 	}
 
-	// Sort roots
-	std::sort(dRoots, dRoots + nDegree);
+	std::vector<double> dWeights(nDegree);
 
-	// Delete buffer
-	delete[] dBuffer;
+	AllRootsAndWeights(nDegree, dRoots, &(dWeights[0]));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
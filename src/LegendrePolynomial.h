@@ -17,6 +17,11 @@
 #ifndef _LEGENDREPOLYNOMIAL_H_
 #define _LEGENDREPOLYNOMIAL_H_
 
+#include "DataArray1D.h"
+#include "DataArray2D.h"
+
+#include <cstddef>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ///	<summary>
@@ -60,6 +65,36 @@ public:
 		double dX
 	);
 
+	///	<summary>
+	///		Evaluate the Legendre polynomial of the given degree and its
+	///		derivative at sCount points.  The three-term recurrence is run
+	///		over tiles of points so that the inner loop vectorizes across
+	///		points.  The derivative is obtained from P'_k = x P'_{k-1}
+	///		+ k P_{k-1}, which is also valid at x = +/-1.  dDerivative may
+	///		be NULL if only values are needed.
+	///	</summary>
+	static void EvaluateValueAndDerivative_Batch(
+		int nDegree,
+		size_t sCount,
+		const double * dX,
+		double * dValue,
+		double * dDerivative
+	);
+
+	///	<summary>
+	///		Build the Legendre-Vandermonde matrix dV(i,k) = P_k(dX[i]) for
+	///		all degrees 0 <= k <= nMaxDegree, and optionally the derivative
+	///		matrix dDV(i,k) = P'_k(dX[i]).  Matrices are allocated with one
+	///		row per point and nMaxDegree+1 columns.  Rows are computed in
+	///		parallel in tiles that are vectorized across points.
+	///	</summary>
+	static void VandermondeMatrix(
+		int nMaxDegree,
+		const DataArray1D<double> & dX,
+		DataArray2D<double> & dV,
+		DataArray2D<double> * pdDV = NULL
+	);
+
 	///	<summary>
 	///		Determine the number of real roots of the derivative of the
 	///		Legendre polynomial of given degree.
@@ -119,6 +154,20 @@ public:
 		double * dRoots
 	);
 
+	///	<summary>
+	///		Return all roots to the Legendre polynomial of the given degree,
+	///		in ascending order, together with the corresponding Gauss-Legendre
+	///		quadrature weights.  Roots and weights are obtained from the
+	///		asymptotic expansions of Bogaert (2014), which are accurate to
+	///		double precision for nDegree > 100 and are Newton-refined for
+	///		lower degrees, so the cost is O(nDegree).
+	///	</summary>
+	static void AllRootsAndWeights(
+		int nDegree,
+		double * dRoots,
+		double * dWeights
+	);
+
 	///	<summary>
 	///		Return all roots to the derivative of the Legendre polynomial of the
 	///		given degree.
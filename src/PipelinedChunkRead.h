@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    PipelinedChunkRead.h
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _PIPELINEDCHUNKREAD_H_
+#define _PIPELINEDCHUNKREAD_H_
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Read a sequence of chunks with fnRead(c, pBuffer) on an I/O thread
+///		while the calling thread decodes the previous chunk with
+///		fnDecode(c, pBuffer).  Two buffers of sBufferSize elements are
+///		used alternately.  Only fnRead may call into the NetCDF library,
+///		which is therefore never accessed from two threads at once.
+///		If pfCancel is given it is checked between chunks, and false is
+///		returned as soon as it is set.
+///	</summary>
+template <typename T, typename ReadFunction, typename DecodeFunction>
+inline bool PipelinedChunkRead(
+	long lChunkCount,
+	size_t sBufferSize,
+	ReadFunction fnRead,
+	DecodeFunction fnDecode,
+	const std::atomic<bool> * pfCancel = NULL
+) {
+	if (lChunkCount == 0) {
+		return true;
+	}
+
+	std::vector<T> vecBuffer[2];
+	vecBuffer[0].resize(sBufferSize);
+	vecBuffer[1].resize((lChunkCount > 1)?(sBufferSize):(0));
+
+	std::future<void> futRead =
+		std::async(std::launch::async, fnRead, 0L, &(vecBuffer[0][0]));
+
+	for (long c = 0; c < lChunkCount; c++) {
+		futRead.get();
+
+		if ((pfCancel != NULL) && (*pfCancel)) {
+			return false;
+		}
+
+		if (c + 1 < lChunkCount) {
+			futRead = std::async(std::launch::async,
+				fnRead, c + 1, &(vecBuffer[(c + 1) % 2][0]));
+		}
+
+		fnDecode(c, &(vecBuffer[c % 2][0]));
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
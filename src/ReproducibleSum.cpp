@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ReproducibleSum.cpp
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "ReproducibleSum.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExactSum::Normalize() {
+	for (int i = 0; i < Limbs - 1; i++) {
+		int64_t lCarry;
+		if (m_lLimb[i] >= 0) {
+			lCarry = m_lLimb[i] >> 32;
+		} else {
+			lCarry = - ((- m_lLimb[i] + 0xffffffffLL) >> 32);
+		}
+		m_lLimb[i] -= lCarry * (static_cast<int64_t>(1) << 32);
+		m_lLimb[i+1] += lCarry;
+	}
+	m_nDeferred = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ExactSum::Merge(
+	const ExactSum & sum
+) {
+	ExactSum sumNormalized(sum);
+	sumNormalized.Normalize();
+	Normalize();
+
+	for (int i = 0; i < Limbs; i++) {
+		m_lLimb[i] += sumNormalized.m_lLimb[i];
+	}
+	m_nDeferred = 1;
+
+	if (sum.m_fNonFinite) {
+		m_fNonFinite = true;
+		m_dNonFinite += sum.m_dNonFinite;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+double ExactSum::Get() const {
+	if (m_fNonFinite) {
+		return m_dNonFinite;
+	}
+
+	// The normalized limbs are a canonical representation of the exact
+	// sum, so the conversion below is independent of the order of terms
+	ExactSum sumNormalized(*this);
+	sumNormalized.Normalize();
+
+	// A negative sum has a negative top limb and positive lower limbs,
+	// which would cancel catastrophically; convert its magnitude instead
+	double dSign = 1.0;
+	if (sumNormalized.m_lLimb[Limbs-1] < 0) {
+		dSign = -1.0;
+		for (int i = 0; i < Limbs; i++) {
+			sumNormalized.m_lLimb[i] = - sumNormalized.m_lLimb[i];
+		}
+		sumNormalized.Normalize();
+	}
+
+	const int64_t * lLimb = sumNormalized.m_lLimb;
+
+	int iTop = Limbs - 1;
+	while ((iTop >= 0) && (lLimb[iTop] == 0)) {
+		iTop--;
+	}
+	if (iTop < 0) {
+		return 0.0;
+	}
+
+	// Only the top three limbs can affect the rounded result; the
+	// remaining limbs are added to capture the sticky bits
+	CompensatedSum sumResult;
+	for (int i = iTop; i >= 0; i--) {
+		if (lLimb[i] != 0) {
+			sumResult.Add(ldexp(static_cast<double>(lLimb[i]), 32 * i - 1074));
+		}
+	}
+	return (dSign * sumResult.Get());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+double ReproducibleSum(
+	size_t sCount,
+	const double * dX
+) {
+	ExactSum sumTotal;
+
+#pragma omp parallel
+	{
+		ExactSum sumThread;
+
+#pragma omp for schedule(static) nowait
+		for (long i = 0; i < static_cast<long>(sCount); i++) {
+			sumThread.Add(dX[i]);
+		}
+
+#pragma omp critical
+		{
+			sumTotal.Merge(sumThread);
+		}
+	}
+
+	return sumTotal.Get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+double ReproducibleDot(
+	size_t sCount,
+	const double * dX,
+	const double * dY
+) {
+	ExactSum sumTotal;
+
+#pragma omp parallel
+	{
+		ExactSum sumThread;
+
+#pragma omp for schedule(static) nowait
+		for (long i = 0; i < static_cast<long>(sCount); i++) {
+			sumThread.AddProduct(dX[i], dY[i]);
+		}
+
+#pragma omp critical
+		{
+			sumTotal.Merge(sumThread);
+		}
+	}
+
+	return sumTotal.Get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    ReproducibleSum.h
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _REPRODUCIBLESUM_H_
+#define _REPRODUCIBLESUM_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compensated (Kahan-Babuska-Neumaier) summation.  The error is
+///		bounded independently of the number of terms, but the result still
+///		depends on the order in which terms are added.
+///	</summary>
+class CompensatedSum {
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	CompensatedSum() :
+		m_dSum(0.0),
+		m_dCompensation(0.0)
+	{ }
+
+	///	<summary>
+	///		Add a term to the sum.
+	///	</summary>
+	inline void Add(double dX) {
+		double dT = m_dSum + dX;
+		if (fabs(m_dSum) >= fabs(dX)) {
+			m_dCompensation += (m_dSum - dT) + dX;
+		} else {
+			m_dCompensation += (dX - dT) + m_dSum;
+		}
+		m_dSum = dT;
+	}
+
+	///	<summary>
+	///		Add another partial sum to this sum.
+	///	</summary>
+	inline void Merge(const CompensatedSum & sum) {
+		Add(sum.m_dSum);
+		m_dCompensation += sum.m_dCompensation;
+	}
+
+	///	<summary>
+	///		Get the value of the sum.
+	///	</summary>
+	inline double Get() const {
+		return (m_dSum + m_dCompensation);
+	}
+
+protected:
+	///	<summary>
+	///		Running sum.
+	///	</summary>
+	double m_dSum;
+
+	///	<summary>
+	///		Accumulated rounding error.
+	///	</summary>
+	double m_dCompensation;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Exact summation of doubles.  Every term is added without rounding
+///		into a fixed-point accumulator that spans the full double exponent
+///		range (67 limbs of 32 bits), so the accumulated value, and therefore
+///		the result, is independent of the order of the terms and of how
+///		they are partitioned among threads.  The result is the exact sum
+///		rounded to double (to within one unit in the last place).
+///		Non-finite terms are summed separately and propagate to the result.
+///	</summary>
+class ExactSum {
+
+public:
+	///	<summary>
+	///		Number of 32-bit limbs.
+	///	</summary>
+	static const int Limbs = 67;
+
+	///	<summary>
+	///		Number of additions after which carries must be propagated.
+	///	</summary>
+	static const int32_t MaxDeferredCarries = (1 << 30);
+
+public:
+	///	<summary>
+	///		Constructor.
+	///	</summary>
+	ExactSum() :
+		m_nDeferred(0),
+		m_fNonFinite(false),
+		m_dNonFinite(0.0)
+	{
+		memset(m_lLimb, 0, sizeof(m_lLimb));
+	}
+
+	///	<summary>
+	///		Add a term to the sum.
+	///	</summary>
+	inline void Add(double dX) {
+		uint64_t uBits;
+		memcpy(&uBits, &dX, sizeof(double));
+
+		const int nExponent = static_cast<int>((uBits >> 52) & 0x7ff);
+		uint64_t uMantissa = uBits & ((static_cast<uint64_t>(1) << 52) - 1);
+
+		if (nExponent == 0x7ff) {
+			m_fNonFinite = true;
+			m_dNonFinite += dX;
+			return;
+		}
+		if ((nExponent == 0) && (uMantissa == 0)) {
+			return;
+		}
+
+		// Position of the lowest mantissa bit above 2^-1074
+		int nBit;
+		if (nExponent == 0) {
+			nBit = 0;
+		} else {
+			uMantissa |= (static_cast<uint64_t>(1) << 52);
+			nBit = nExponent - 1;
+		}
+
+		const int nLimb = nBit / 32;
+		const int nShift = nBit % 32;
+		const uint64_t Mask = 0xffffffffULL;
+
+		int64_t lPiece0 = static_cast<int64_t>((uMantissa << nShift) & Mask);
+		int64_t lPiece1;
+		int64_t lPiece2;
+		if (nShift == 0) {
+			lPiece1 = static_cast<int64_t>(uMantissa >> 32);
+			lPiece2 = 0;
+		} else {
+			lPiece1 = static_cast<int64_t>((uMantissa >> (32 - nShift)) & Mask);
+			lPiece2 = static_cast<int64_t>(uMantissa >> (64 - nShift));
+		}
+
+		if (uBits >> 63) {
+			m_lLimb[nLimb] -= lPiece0;
+			m_lLimb[nLimb+1] -= lPiece1;
+			m_lLimb[nLimb+2] -= lPiece2;
+		} else {
+			m_lLimb[nLimb] += lPiece0;
+			m_lLimb[nLimb+1] += lPiece1;
+			m_lLimb[nLimb+2] += lPiece2;
+		}
+
+		m_nDeferred++;
+		if (m_nDeferred == MaxDeferredCarries) {
+			Normalize();
+		}
+	}
+
+	///	<summary>
+	///		Add the exact product dA * dB to the sum.  The rounding error of
+	///		the product is recovered with a fused multiply-add where it is
+	///		fast and with Dekker's product otherwise.
+	///	</summary>
+	inline void AddProduct(double dA, double dB) {
+		double dP = dA * dB;
+
+#if defined(FP_FAST_FMA)
+		double dE = std::fma(dA, dB, -dP);
+#else
+		const double Split = 134217729.0;
+
+		double dTa = Split * dA;
+		double dAHi = dTa - (dTa - dA);
+		double dALo = dA - dAHi;
+
+		double dTb = Split * dB;
+		double dBHi = dTb - (dTb - dB);
+		double dBLo = dB - dBHi;
+
+		double dE = ((dAHi * dBHi - dP) + dAHi * dBLo + dALo * dBHi)
+			+ dALo * dBLo;
+#endif
+
+		Add(dP);
+		if (std::isfinite(dE)) {
+			Add(dE);
+		}
+	}
+
+	///	<summary>
+	///		Add another partial sum to this sum.
+	///	</summary>
+	void Merge(const ExactSum & sum);
+
+	///	<summary>
+	///		Get the value of the sum.
+	///	</summary>
+	double Get() const;
+
+protected:
+	///	<summary>
+	///		Propagate carries so that all limbs except the last lie in
+	///		[0, 2^32).
+	///	</summary>
+	void Normalize();
+
+protected:
+	///	<summary>
+	///		Limbs of the accumulator; limb i has weight 2^(32 i - 1074).
+	///		Two guard limbs above the largest double hold carries.
+	///	</summary>
+	int64_t m_lLimb[Limbs];
+
+	///	<summary>
+	///		Number of additions since the last carry propagation.
+	///	</summary>
+	int32_t m_nDeferred;
+
+	///	<summary>
+	///		Flag indicating a non-finite term has been added.
+	///	</summary>
+	bool m_fNonFinite;
+
+	///	<summary>
+	///		Sum of the non-finite terms.
+	///	</summary>
+	double m_dNonFinite;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Sum an array of doubles in parallel.  The result is bitwise
+///		identical for any number of threads and any ordering of the terms.
+///	</summary>
+double ReproducibleSum(
+	size_t sCount,
+	const double * dX
+);
+
+///	<summary>
+///		Compute the dot product of two arrays of doubles in parallel, for
+///		instance an area-weighted integral.  Products are accumulated
+///		exactly, so the result is the exact dot product rounded to double
+///		and is bitwise identical for any number of threads.
+///	</summary>
+double ReproducibleDot(
+	size_t sCount,
+	const double * dX,
+	const double * dY
+);
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
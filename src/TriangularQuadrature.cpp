@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    TriangularQuadrature.cpp
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "TriangularQuadrature.h"
+#include "Exception.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Symmetry orbits of points in barycentric coordinates.
+///	</summary>
+enum TriangularQuadratureOrbitType {
+	Orbit_S3,	// Centroid (1/3, 1/3, 1/3)
+	Orbit_S21,	// Permutations of (a, a, 1-2a), three points
+	Orbit_S111	// Permutations of (a, b, 1-a-b), six points
+};
+
+///	<summary>
+///		An orbit of a symmetric rule, with the weight of each of its points.
+///	</summary>
+struct TriangularQuadratureOrbit {
+	TriangularQuadratureOrbitType eType;
+	double dA;
+	double dB;
+	double dW;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Rules of D. A. Dunavant (1985) "High degree efficient symmetrical Gaussian
+// quadrature rules for the triangle", Int. J. Numer. Meth. Eng. 21, with
+// positive weights and interior points.  The degree 7 rule is the 15 point
+// rule with three S21 orbits and one S111 orbit, since the 13 point Dunavant
+// rule has a negative weight.  Values were refined to full precision by
+// solving the moment equations.
+
+// Degree 1, 1 point
+static const TriangularQuadratureOrbit TriangularQuadratureDegree1[] = {
+	{Orbit_S3,   0.0, 0.0, 1.0}
+};
+
+// Degree 2, 3 points
+static const TriangularQuadratureOrbit TriangularQuadratureDegree2[] = {
+	{Orbit_S21,  0.16666666666666667, 0.0, 0.33333333333333333}
+};
+
+// Degree 4, 6 points
+static const TriangularQuadratureOrbit TriangularQuadratureDegree4[] = {
+	{Orbit_S21,  0.44594849091596489, 0.0, 0.22338158967801147},
+	{Orbit_S21,  0.091576213509770743, 0.0, 0.10995174365532187}
+};
+
+// Degree 5, 7 points
+static const TriangularQuadratureOrbit TriangularQuadratureDegree5[] = {
+	{Orbit_S3,   0.0, 0.0, 0.225},
+	{Orbit_S21,  0.47014206410511509, 0.0, 0.13239415278850618},
+	{Orbit_S21,  0.10128650732345634, 0.0, 0.12593918054482715}
+};
+
+// Degree 6, 12 points
+static const TriangularQuadratureOrbit TriangularQuadratureDegree6[] = {
+	{Orbit_S21,  0.24928674517091042, 0.0, 0.11678627572637937},
+	{Orbit_S21,  0.063089014491502228, 0.0, 0.050844906370206817},
+	{Orbit_S111, 0.053145049844816947, 0.31035245103378441, 0.082851075618373575}
+};
+
+// Degree 7, 15 points
+static const TriangularQuadratureOrbit TriangularQuadratureDegree7[] = {
+	{Orbit_S21,  0.062086485372373326, 0.0, 0.048767474950460727},
+	{Orbit_S21,  0.19869683151525835, 0.0, 0.076103903498626752},
+	{Orbit_S21,  0.40944216532382379, 0.0, 0.089265322347414069},
+	{Orbit_S111, 0.035812187387702353, 0.65124368797519233, 0.059598316268415893}
+};
+
+// Degree 8, 16 points
+static const TriangularQuadratureOrbit TriangularQuadratureDegree8[] = {
+	{Orbit_S3,   0.0, 0.0, 0.14431560767778717},
+	{Orbit_S21,  0.45929258829272316, 0.0, 0.095091634267284625},
+	{Orbit_S21,  0.17056930775176021, 0.0, 0.10321737053471825},
+	{Orbit_S21,  0.050547228317030975, 0.0, 0.03245849762319808},
+	{Orbit_S111, 0.0083947774099576053, 0.26311282963463811, 0.027230314174434994}
+};
+
+///	<summary>
+///		Table of available rules, in order of increasing degree.
+///	</summary>
+struct TriangularQuadratureRuleData {
+	int nDegree;
+	int nOrbits;
+	const TriangularQuadratureOrbit * pOrbits;
+};
+
+static const TriangularQuadratureRuleData TriangularQuadratureRules[] = {
+	{1, 1, TriangularQuadratureDegree1},
+	{2, 1, TriangularQuadratureDegree2},
+	{4, 2, TriangularQuadratureDegree4},
+	{5, 3, TriangularQuadratureDegree5},
+	{6, 3, TriangularQuadratureDegree6},
+	{7, 4, TriangularQuadratureDegree7},
+	{8, 5, TriangularQuadratureDegree8}
+};
+
+static const int TriangularQuadratureRuleCount =
+	sizeof(TriangularQuadratureRules) / sizeof(TriangularQuadratureRuleData);
+
+///////////////////////////////////////////////////////////////////////////////
+
+int TriangularQuadratureRule::MaxDegree() {
+	return TriangularQuadratureRules[TriangularQuadratureRuleCount-1].nDegree;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TriangularQuadratureRule::TriangularQuadratureRule(
+	int nDegree
+) {
+	if (nDegree < 1) {
+		_EXCEPTION1("Invalid degree (%i): Minimum degree 1", nDegree);
+	}
+	if (nDegree > MaxDegree()) {
+		_EXCEPTION2("Invalid degree (%i): Maximum degree %i",
+			nDegree, MaxDegree());
+	}
+
+	// Find the first rule of sufficient degree
+	int r = 0;
+	while (TriangularQuadratureRules[r].nDegree < nDegree) {
+		r++;
+	}
+
+	const TriangularQuadratureRuleData & data = TriangularQuadratureRules[r];
+
+	m_nDegree = data.nDegree;
+
+	// Count points
+	int nPoints = 0;
+	for (int o = 0; o < data.nOrbits; o++) {
+		if (data.pOrbits[o].eType == Orbit_S3) {
+			nPoints += 1;
+		} else if (data.pOrbits[o].eType == Orbit_S21) {
+			nPoints += 3;
+		} else {
+			nPoints += 6;
+		}
+	}
+
+	m_dG.Allocate(nPoints, 3);
+	m_dW.Allocate(nPoints);
+
+	// Expand orbits into points
+	int i = 0;
+	for (int o = 0; o < data.nOrbits; o++) {
+		const TriangularQuadratureOrbit & orbit = data.pOrbits[o];
+
+		if (orbit.eType == Orbit_S3) {
+			m_dG(i,0) = 1.0 / 3.0;
+			m_dG(i,1) = 1.0 / 3.0;
+			m_dG(i,2) = 1.0 / 3.0;
+			m_dW[i] = orbit.dW;
+			i++;
+
+		} else if (orbit.eType == Orbit_S21) {
+			const double dC = 1.0 - 2.0 * orbit.dA;
+			for (int k = 0; k < 3; k++) {
+				m_dG(i,0) = (k == 0)?(dC):(orbit.dA);
+				m_dG(i,1) = (k == 1)?(dC):(orbit.dA);
+				m_dG(i,2) = (k == 2)?(dC):(orbit.dA);
+				m_dW[i] = orbit.dW;
+				i++;
+			}
+
+		} else {
+			const double dABC[3] =
+				{orbit.dA, orbit.dB, 1.0 - orbit.dA - orbit.dB};
+			static const int nPerm[6][3] =
+				{{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+
+			for (int k = 0; k < 6; k++) {
+				m_dG(i,0) = dABC[nPerm[k][0]];
+				m_dG(i,1) = dABC[nPerm[k][1]];
+				m_dG(i,2) = dABC[nPerm[k][2]];
+				m_dW[i] = orbit.dW;
+				i++;
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    TriangularQuadrature.h
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2010 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#ifndef _TRIANGULARQUADRATURE_H_
+#define _TRIANGULARQUADRATURE_H_
+
+#include "DataArray1D.h"
+#include "DataArray2D.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		A fully symmetric quadrature rule on the triangle (Dunavant family).
+///		Points are given in barycentric coordinates and all weights are
+///		positive and sum to one, so an integral over a triangle of area A
+///		is approximated by A * sum_i W[i] f(G[i]).  All points lie strictly
+///		inside the triangle.
+///	</summary>
+class TriangularQuadratureRule {
+
+public:
+	///	<summary>
+	///		Constructor.  Selects the rule with the fewest points that
+	///		integrates all polynomials of degree nDegree exactly.
+	///	</summary>
+	TriangularQuadratureRule(
+		int nDegree
+	);
+
+	///	<summary>
+	///		Maximum polynomial degree of the available rules.
+	///	</summary>
+	static int MaxDegree();
+
+public:
+	///	<summary>
+	///		Polynomial degree of the selected rule, which may exceed the
+	///		requested degree.
+	///	</summary>
+	int GetDegree() const {
+		return m_nDegree;
+	}
+
+	///	<summary>
+	///		Number of points in the rule.
+	///	</summary>
+	int GetPoints() const {
+		return static_cast<int>(m_dW.GetRows());
+	}
+
+	///	<summary>
+	///		Barycentric coordinates of the quadrature points (points x 3).
+	///	</summary>
+	const DataArray2D<double> & GetG() const {
+		return m_dG;
+	}
+
+	///	<summary>
+	///		Quadrature weights.
+	///	</summary>
+	const DataArray1D<double> & GetW() const {
+		return m_dW;
+	}
+
+protected:
+	///	<summary>
+	///		Polynomial degree of the rule.
+	///	</summary>
+	int m_nDegree;
+
+	///	<summary>
+	///		Barycentric coordinates of the quadrature points.
+	///	</summary>
+	DataArray2D<double> m_dG;
+
+	///	<summary>
+	///		Quadrature weights.
+	///	</summary>
+	DataArray1D<double> m_dW;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif
+
@@ -0,0 +1,444 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///	\file    meshbench.cpp
+///	\author  Paul Ullrich
+///	\version October 17, 2026
+///
+///	<remarks>
+///		Copyright 2000-2014 Paul Ullrich
+///
+///		This file is distributed as part of the Tempest source code package.
+///		Permission is granted to use, copy, modify and distribute this
+///		source code and its documentation under the terms of the GNU General
+///		Public License.  This software is provided "as is" without express
+///		or implied warranty.
+///	</remarks>
+
+#include "CoordTransforms.h"
+#include "GridElements.h"
+#include "STLStringHelper.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Distance between dValue and dReference in units in the last place
+///		of dReference.
+///	</summary>
+static double UlpDistance(
+	double dValue,
+	double dReference
+) {
+	const double dAbsRef =
+		std::max(std::fabs(dReference), std::numeric_limits<double>::min());
+
+	const double dUlp =
+		std::nextafter(dAbsRef, std::numeric_limits<double>::infinity())
+		- dAbsRef;
+
+	return std::fabs(dValue - dReference) / dUlp;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Smallest wall clock time (in seconds) of nRepeats calls to fn.
+///	</summary>
+template<typename FunctionType>
+static double BestTime(
+	int nRepeats,
+	FunctionType fn
+) {
+	double dBest = std::numeric_limits<double>::max();
+	for (int r = 0; r < nRepeats; r++) {
+		std::chrono::steady_clock::time_point t0 =
+			std::chrono::steady_clock::now();
+		fn();
+		std::chrono::steady_clock::time_point t1 =
+			std::chrono::steady_clock::now();
+		dBest = std::min(dBest,
+			std::chrono::duration<double>(t1 - t0).count());
+	}
+	return dBest;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Print one line of the report and return true if the deviation is
+///		within the documented bound.
+///	</summary>
+static bool ReportKernel(
+	const char * szName,
+	size_t sCount,
+	double dScalarTime,
+	double dBatchTime,
+	double dDeviation,
+	double dBound,
+	const char * szUnits
+) {
+	const bool fPass = (dDeviation <= dBound);
+
+	printf("%-30s %10.2f %10.2f %8.2fx   %9.3g / %-9.3g %-4s %s\n",
+		szName,
+		1.0e9 * dScalarTime / static_cast<double>(sCount),
+		1.0e9 * dBatchTime / static_cast<double>(sCount),
+		dScalarTime / dBatchTime,
+		dDeviation, dBound, szUnits,
+		(fPass)?("ok"):("FAIL"));
+
+	return fPass;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Compare the scalar transforms in CoordTransforms.h against their
+///		batch counterparts on sCount random points, reporting the time per
+///		point and the largest deviation against the bound documented on
+///		each batch kernel.  Returns the number of kernels that exceed their
+///		bound.
+///	</summary>
+static int BenchCoordTransforms(
+	size_t sCount,
+	int nRepeats
+) {
+	std::mt19937_64 rng(20261017);
+	std::uniform_real_distribution<double> distLon(-M_PI, 3.0 * M_PI);
+	std::uniform_real_distribution<double> distZ(-1.0, 1.0);
+
+	std::vector<double> dLon(sCount);
+	std::vector<double> dLat(sCount);
+	std::vector<double> dX(sCount);
+	std::vector<double> dY(sCount);
+	std::vector<double> dZ(sCount);
+
+	// Uniformly distributed points on the sphere, with longitudes outside
+	// of the standard range to exercise argument reduction
+	for (size_t i = 0; i < sCount; i++) {
+		dLon[i] = distLon(rng);
+		dLat[i] = asin(distZ(rng));
+	}
+
+	std::vector<double> dOut0(sCount);
+	std::vector<double> dOut1(sCount);
+	std::vector<double> dOut2(sCount);
+	std::vector<double> dRef0(sCount);
+	std::vector<double> dRef1(sCount);
+	std::vector<double> dRef2(sCount);
+
+	int nFailed = 0;
+
+	printf("%-30s %10s %10s %9s   %s\n",
+		"kernel", "scalar ns", "batch ns", "speedup", "max deviation / bound");
+
+	// RLLtoXYZ
+	{
+		double dScalarTime = BestTime(nRepeats, [&]() {
+			for (size_t i = 0; i < sCount; i++) {
+				RLLtoXYZ_Rad(dLon[i], dLat[i], dRef0[i], dRef1[i], dRef2[i]);
+			}
+		});
+		double dBatchTime = BestTime(nRepeats, [&]() {
+			RLLtoXYZ_Batch(sCount, &(dLon[0]), &(dLat[0]),
+				&(dOut0[0]), &(dOut1[0]), &(dOut2[0]));
+		});
+
+		double dDeviation = 0.0;
+		for (size_t i = 0; i < sCount; i++) {
+			dDeviation = std::max(dDeviation, std::fabs(dOut0[i] - dRef0[i]));
+			dDeviation = std::max(dDeviation, std::fabs(dOut1[i] - dRef1[i]));
+			dDeviation = std::max(dDeviation, std::fabs(dOut2[i] - dRef2[i]));
+		}
+		if (!ReportKernel("RLLtoXYZ_Batch", sCount,
+			dScalarTime, dBatchTime, dDeviation, 2.0e-15, "abs")
+		) {
+			nFailed++;
+		}
+
+		dX = dRef0;
+		dY = dRef1;
+		dZ = dRef2;
+	}
+
+	// XYZtoRLL (the bound applies away from the poles, which is where
+	// the scalar version switches to asin)
+	{
+		double dScalarTime = BestTime(nRepeats, [&]() {
+			for (size_t i = 0; i < sCount; i++) {
+				XYZtoRLL_Rad(dX[i], dY[i], dZ[i], dRef0[i], dRef1[i]);
+			}
+		});
+		double dBatchTime = BestTime(nRepeats, [&]() {
+			XYZtoRLL_Batch(sCount, &(dX[0]), &(dY[0]), &(dZ[0]),
+				&(dOut0[0]), &(dOut1[0]));
+		});
+
+		double dDeviation = 0.0;
+		for (size_t i = 0; i < sCount; i++) {
+			if (std::fabs(dZ[i]) > 0.99) {
+				continue;
+			}
+			dDeviation = std::max(dDeviation, UlpDistance(dOut0[i], dRef0[i]));
+			dDeviation = std::max(dDeviation, UlpDistance(dOut1[i], dRef1[i]));
+		}
+		if (!ReportKernel("XYZtoRLL_Batch", sCount,
+			dScalarTime, dBatchTime, dDeviation, 4.0, "ulp")
+		) {
+			nFailed++;
+		}
+	}
+
+	// GreatCircleDistanceXYZ, between each point and a shuffled partner
+	{
+		std::vector<double> dX1(dX);
+		std::vector<double> dY1(dY);
+		std::vector<double> dZ1(dZ);
+		std::rotate(dX1.begin(), dX1.begin() + sCount / 3, dX1.end());
+		std::rotate(dY1.begin(), dY1.begin() + sCount / 3, dY1.end());
+		std::rotate(dZ1.begin(), dZ1.begin() + sCount / 3, dZ1.end());
+
+		double dScalarTime = BestTime(nRepeats, [&]() {
+			for (size_t i = 0; i < sCount; i++) {
+				dRef0[i] = GreatCircleDistanceXYZ_Rad(
+					dX[i], dY[i], dZ[i], dX1[i], dY1[i], dZ1[i]);
+			}
+		});
+		double dBatchTime = BestTime(nRepeats, [&]() {
+			GreatCircleDistanceXYZ_Batch(sCount,
+				&(dX[0]), &(dY[0]), &(dZ[0]),
+				&(dX1[0]), &(dY1[0]), &(dZ1[0]),
+				&(dOut0[0]));
+		});
+
+		double dDeviation = 0.0;
+		for (size_t i = 0; i < sCount; i++) {
+			dDeviation = std::max(dDeviation, UlpDistance(dOut0[i], dRef0[i]));
+		}
+		if (!ReportKernel("GreatCircleDistanceXYZ_Batch", sCount,
+			dScalarTime, dBatchTime, dDeviation, 4.0, "ulp")
+		) {
+			nFailed++;
+		}
+	}
+
+	// StereographicProjection about a fixed center; the bound is scaled
+	// by the conditioning of the projection, which is unbounded at the
+	// antipode
+	{
+		const double dLonRad0 = 0.3;
+		const double dLatRad0 = 0.7;
+
+		double dScalarTime = BestTime(nRepeats, [&]() {
+			for (size_t i = 0; i < sCount; i++) {
+				StereographicProjection(
+					dLonRad0, dLatRad0, dLon[i], dLat[i], dRef0[i], dRef1[i]);
+			}
+		});
+		double dBatchTime = BestTime(nRepeats, [&]() {
+			StereographicProjection_Batch(dLonRad0, dLatRad0, sCount,
+				&(dLon[0]), &(dLat[0]), &(dOut0[0]), &(dOut1[0]));
+		});
+
+		double dDeviation = 0.0;
+		for (size_t i = 0; i < sCount; i++) {
+			const double dRadius =
+				sqrt(dRef0[i] * dRef0[i] + dRef1[i] * dRef1[i]);
+			const double dDiff = std::max(
+				std::fabs(dOut0[i] - dRef0[i]),
+				std::fabs(dOut1[i] - dRef1[i]));
+			dDeviation = std::max(dDeviation,
+				dDiff / (std::max(1.0, dRadius) * (1.0 + 0.25 * dRadius * dRadius)));
+		}
+		if (!ReportKernel("StereographicProjection_Batch", sCount,
+			dScalarTime, dBatchTime, dDeviation, 1.0e-15, "rel")
+		) {
+			nFailed++;
+		}
+	}
+
+	return nFailed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///	<summary>
+///		Integrand z^2, whose integral over a latitude-longitude box is known.
+///	</summary>
+struct ZSquaredIntegrand {
+	double operator()(const Node & node) const {
+		return node.z * node.z;
+	}
+};
+
+///	<summary>
+///		Integrate 1 and z^2 adaptively over single latitude-longitude boxes
+///		bounded by two constant latitude edges, in both orientations, and
+///		compare against the exact integrals.  Wide boxes make the latitude
+///		arcs bulge across the fan diagonal of the face, so that subdivision
+///		triangles fold over.  Returns the number of integrals that exceed
+///		the tolerance or report that they did not converge.
+///	</summary>
+static int CheckLatitudeBands(
+	double dRelTolerance
+) {
+	// Latitude and longitude bounds (degrees) of each box
+	const double dBoxes[][4] = {
+		{40.0, 50.0, 0.0, 60.0},
+		{40.0, 50.0, 0.0, 90.0},
+		{60.0, 80.0, 0.0, 90.0},
+		{0.0, 60.0, 0.0, 120.0},
+		{-70.0, -20.0, 30.0, 170.0},
+		{-80.0, 80.0, 0.0, 10.0},
+		{80.0, 89.9, 0.0, 170.0},
+		{10.0, 20.0, 0.0, 179.0}
+	};
+	const int nBoxes = sizeof(dBoxes) / sizeof(dBoxes[0]);
+
+	const AdaptiveIntegrationParameters param(dRelTolerance);
+
+	int nFailed = 0;
+
+	printf("%-30s %10s %10s %10s %11s\n",
+		"latitude band", "area err", "z^2 err", "triangles", "converged");
+
+	for (int b = 0; b < nBoxes; b++) {
+		const double dLat0 = DegToRad(dBoxes[b][0]);
+		const double dLat1 = DegToRad(dBoxes[b][1]);
+		const double dLon0 = DegToRad(dBoxes[b][2]);
+		const double dLon1 = DegToRad(dBoxes[b][3]);
+
+		const double dSin0 = sin(dLat0);
+		const double dSin1 = sin(dLat1);
+
+		const double dExactArea = (dLon1 - dLon0) * (dSin1 - dSin0);
+		const double dExactZ2 =
+			(dLon1 - dLon0) * (dSin1 * dSin1 * dSin1 - dSin0 * dSin0 * dSin0) / 3.0;
+
+		NodeVector nodes(4);
+		RLLtoXYZ_Rad(dLon0, dLat0, nodes[0].x, nodes[0].y, nodes[0].z);
+		RLLtoXYZ_Rad(dLon1, dLat0, nodes[1].x, nodes[1].y, nodes[1].z);
+		RLLtoXYZ_Rad(dLon1, dLat1, nodes[2].x, nodes[2].y, nodes[2].z);
+		RLLtoXYZ_Rad(dLon0, dLat1, nodes[3].x, nodes[3].y, nodes[3].z);
+
+		for (int iReverse = 0; iReverse < 2; iReverse++) {
+			Face face(4);
+			for (int k = 0; k < 4; k++) {
+				face.SetNode(k, (iReverse == 0)?(k):((4 - k) % 4));
+			}
+
+			// Edges 0 -> 1 and 2 -> 3 of the counter-clockwise box are the
+			// constant latitude edges
+			const int iLat0 = (iReverse == 0)?(0):(3);
+			const int iLat1 = (iReverse == 0)?(2):(1);
+			face.edges[iLat0].type = Edge::Type_ConstantLatitude;
+			face.edges[iLat1].type = Edge::Type_ConstantLatitude;
+
+			AdaptiveIntegrationResult resultArea =
+				IntegrateOverFaceAdaptive(face, nodes, param, UnitIntegrand());
+			AdaptiveIntegrationResult resultZ2 =
+				IntegrateOverFaceAdaptive(face, nodes, param, ZSquaredIntegrand());
+
+			const double dAreaError =
+				std::fabs(resultArea.dIntegral - dExactArea) / dExactArea;
+			const double dZ2Error =
+				std::fabs(resultZ2.dIntegral - dExactZ2) / std::fabs(dExactZ2);
+
+			const bool fPass =
+				resultArea.fConverged && resultZ2.fConverged
+				&& (dAreaError <= 10.0 * dRelTolerance)
+				&& (dZ2Error <= 10.0 * dRelTolerance);
+
+			char szBand[64];
+			snprintf(szBand, 64, "[%g,%g]x[%g,%g] %s",
+				dBoxes[b][0], dBoxes[b][1], dBoxes[b][2], dBoxes[b][3],
+				(iReverse == 0)?("ccw"):("cw"));
+
+			printf("%-30s %10.2e %10.2e %10i %5i %5i %s\n",
+				szBand, dAreaError, dZ2Error,
+				resultArea.nTriangles + resultZ2.nTriangles,
+				resultArea.fConverged, resultZ2.fConverged,
+				(fPass)?("ok"):("FAIL"));
+
+			if (!fPass) {
+				nFailed++;
+			}
+		}
+	}
+
+	return nFailed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+	size_t sCount = 1 << 22;
+	int nRepeats = 5;
+
+	bool fPrintUsage = false;
+	for (int c = 1; c < argc; c++) {
+		if (c == argc-1) {
+			printf("ERROR: Missing parameter for argument %s\n", argv[c]);
+			fPrintUsage = true;
+			break;
+		}
+		if ((strcmp(argv[c],"-n") == 0)
+			&& STLStringHelper::IsInteger(argv[c+1])
+			&& (atol(argv[c+1]) > 0)
+		) {
+			sCount = static_cast<size_t>(atol(argv[c+1]));
+		} else if ((strcmp(argv[c],"-r") == 0)
+			&& STLStringHelper::IsInteger(argv[c+1])
+			&& (atoi(argv[c+1]) > 0)
+		) {
+			nRepeats = atoi(argv[c+1]);
+		} else {
+			printf("ERROR: Invalid argument %s\n", argv[c]);
+			fPrintUsage = true;
+			break;
+		}
+		c++;
+	}
+
+	if (fPrintUsage) {
+		printf("meshbench [-n count] [-r repeats]\n");
+		printf("  [-n count]         Number of points (default 4194304)\n");
+		printf("  [-r repeats]       Timed repetitions; the best is kept (default 5)\n");
+		return (-1);
+	}
+
+	printf("%lu points, best of %i\n\n", sCount, nRepeats);
+
+	int nFailed = BenchCoordTransforms(sCount, nRepeats);
+
+	if (nFailed != 0) {
+		printf("\n%i kernels exceed their documented accuracy bound\n", nFailed);
+	}
+
+	printf("\n");
+
+	int nBandsFailed = CheckLatitudeBands(1.0e-12);
+
+	if (nBandsFailed != 0) {
+		printf("\n%i latitude band integrals are inaccurate\n", nBandsFailed);
+	}
+
+	if ((nFailed != 0) || (nBandsFailed != 0)) {
+		return (1);
+	}
+
+	return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
@@ -1,7 +1,17 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <vector>
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -16,6 +26,30 @@ const float ZOOM_STEP = 0.4f;
 std::chrono::steady_clock::time_point lastClickTime;
 const double DOUBLE_CLICK_THRESHOLD = 0.3; // seconds
 
+///	<summary>
+///		Redraw information.  The view is redrawn only when it has changed;
+///		frames drawn during interaction use a subset of the mesh and full
+///		detail is drawn once the view has been idle for REFINE_DELAY.
+///	</summary>
+bool viewDirty = true;
+const double REFINE_DELAY = 0.15; // seconds
+const size_t INTERACTIVE_FACE_BUDGET = 250000;
+
+///	<summary>
+///		Time spent uploading streamed mesh chunks per loop iteration.
+///	</summary>
+const double MAX_UPLOAD_TIME = 0.01; // seconds
+
+///	<summary>
+///		Edge tessellation.  Edges are subdivided along their true path so
+///		that each segment deviates from it by at most SAG_TOLERANCE pixels
+///		and subtends at most MAX_SEGMENT_ANGLE (keeping segments above the
+///		globe, which has radius 0.999).
+///	</summary>
+const double SAG_TOLERANCE = 0.25; // pixels
+const double MAX_SEGMENT_ANGLE = 0.05; // radians
+const int MAX_SEGMENTS = 64;
+
 ///	<summary>
 ///		Get the vertices and incides of the sphere.
 ///	</summary>
@@ -66,51 +100,419 @@ void createSphere(
 }
 
 ///	<summary>
-///		Get vertices and indices from a mesh file
+///		One mesh edge, drawn as an instanced screen-aligned quad.
 ///	</summary>
-void getMesh(
-	const std::string & filename,
-	std::vector<float> & vertices,
-	std::vector<unsigned int> & indices
+struct LineInstance {
+	float start[3];
+	float end[3];
+	unsigned char color[4];
+	unsigned char type[4];
+};
+
+///	<summary>
+///		Make a LineInstance from two mesh nodes.
+///	</summary>
+inline LineInstance makeLineInstance(
+	const NodeF & node0,
+	const NodeF & node1,
+	Edge::Type type,
+	const unsigned char color[4]
+) {
+	LineInstance line;
+	line.start[0] = node0.x;
+	line.start[1] = node0.z;
+	line.start[2] = node0.y;
+	line.end[0] = node1.x;
+	line.end[1] = node1.z;
+	line.end[2] = node1.y;
+	memcpy(line.color, color, 4);
+	line.type[0] = static_cast<unsigned char>(type);
+	line.type[1] = line.type[2] = line.type[3] = 0;
+	return line;
+}
+
+///	<summary>
+///		Angle subtended by a line along its path: the great circle arc, or
+///		the arc of the circle of latitude scaled by its radius.
+///	</summary>
+inline float lineArcLength(
+	const LineInstance & line
+) {
+	const float * a = line.start;
+	const float * b = line.end;
+
+	if (line.type[0] == Edge::Type_ConstantLatitude) {
+		float dLon = atan2f(a[0] * b[2] - a[2] * b[0], a[0] * b[0] + a[2] * b[2]);
+		return fabsf(dLon) * sqrtf(a[0] * a[0] + a[2] * a[2]);
+	}
+
+	float cx = a[1] * b[2] - a[2] * b[1];
+	float cy = a[2] * b[0] - a[0] * b[2];
+	float cz = a[0] * b[1] - a[1] * b[0];
+	return atan2f(sqrtf(cx * cx + cy * cy + cz * cz),
+		a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+///	<summary>
+///		Largest arc length of lines [begin, end).
+///	</summary>
+float getMaxArcLength(
+	const std::vector<LineInstance> & lines,
+	size_t begin,
+	size_t end
+) {
+	float maxArc = 0.0f;
+#pragma omp parallel for reduction(max:maxArc)
+	for (long i = (long)begin; i < (long)end; i++) {
+		maxArc = std::max(maxArc, lineArcLength(lines[i]));
+	}
+	return maxArc;
+}
+
+///	<summary>
+///		Flag the edge slots of a mesh (entry vecFaceBegin[f]+k for the edge
+///		from node k to node k+1 of face f) that are drawn.  Each edge is
+///		drawn once, by the lowest numbered face containing it, and
+///		degenerate edges are skipped.  Edges are bucketed by their lower
+///		node index so that duplicates are found in linear time.  Returns
+///		the number of edges drawn.
+///	</summary>
+size_t getMeshEdgeOwners(
+	const MeshF & mesh,
+	std::vector<char> & owner
+) {
+	const long nNodes = static_cast<long>(mesh.nodes.size());
+	const size_t nFaces = mesh.FaceCount();
+
+	owner.assign(mesh.vecFaceNodes.size(), 0);
+
+	// Count edges in each bucket
+	std::vector<size_t> bucketBegin(nNodes + 1, 0);
+	for (size_t f = 0; f < nFaces; f++) {
+		int nFaceNodes = mesh.FaceNodeCount(f);
+		for (int k = 0; k < nFaceNodes; k++) {
+			NodeIndex a = mesh.FaceNode(f, k);
+			NodeIndex b = mesh.FaceNode(f, (k + 1) % nFaceNodes);
+			if (a != b) {
+				bucketBegin[std::min(a, b) + 1]++;
+			}
+		}
+	}
+	for (long n = 0; n < nNodes; n++) {
+		bucketBegin[n+1] += bucketBegin[n];
+	}
+
+	// Fill buckets with (other node, slot) in slot order
+	std::vector< std::pair<NodeIndex, size_t> > entries(bucketBegin[nNodes]);
+	std::vector<size_t> bucketNext(bucketBegin.begin(), bucketBegin.end() - 1);
+	for (size_t f = 0; f < nFaces; f++) {
+		int nFaceNodes = mesh.FaceNodeCount(f);
+		for (int k = 0; k < nFaceNodes; k++) {
+			NodeIndex a = mesh.FaceNode(f, k);
+			NodeIndex b = mesh.FaceNode(f, (k + 1) % nFaceNodes);
+			if (a != b) {
+				entries[bucketNext[std::min(a, b)]++] =
+					std::pair<NodeIndex, size_t>(
+						std::max(a, b), mesh.vecFaceBegin[f] + k);
+			}
+		}
+	}
+
+	// The first slot of each run of equal edges owns the edge
+	size_t nOwned = 0;
+#pragma omp parallel for schedule(static, 65536) reduction(+:nOwned)
+	for (long n = 0; n < nNodes; n++) {
+		auto itBegin = entries.begin() + bucketBegin[n];
+		auto itEnd = entries.begin() + bucketBegin[n+1];
+		std::sort(itBegin, itEnd);
+		for (auto it = itBegin; it != itEnd; it++) {
+			if ((it == itBegin) || ((it-1)->first != it->first)) {
+				owner[it->second] = 1;
+				nOwned++;
+			}
+		}
+	}
+	return nOwned;
+}
+
+///	<summary>
+///		Get the edges owned by faces [begin, end) of a mesh.
+///	</summary>
+void getMeshLines(
+	const MeshF & mesh,
+	const std::vector<char> & owner,
+	size_t begin,
+	size_t end,
+	const unsigned char color[4],
+	std::vector<LineInstance> & lines
+) {
+	lines.clear();
+	for (size_t f = begin; f < end; f++) {
+		int nFaceNodes = mesh.FaceNodeCount(f);
+		for (int k = 0; k < nFaceNodes; k++) {
+			if (owner[mesh.vecFaceBegin[f] + k]) {
+				lines.push_back(makeLineInstance(
+					mesh.nodes[mesh.FaceNode(f, k)],
+					mesh.nodes[mesh.FaceNode(f, (k + 1) % nFaceNodes)],
+					mesh.FaceEdgeType(f, k),
+					color));
+			}
+		}
+	}
+}
+
+///	<summary>
+///		Get a coarse preview of a mesh made of all edges of every
+///		stride-th face.  previewFaceBegin receives the index of the first
+///		line of each preview face, plus a final entry equal to lines.size().
+///	</summary>
+void getMeshPreview(
+	const MeshF & mesh,
+	size_t stride,
+	const unsigned char color[4],
+	std::vector<LineInstance> & lines,
+	std::vector<size_t> & previewFaceBegin
+) {
+	size_t nPreviewFaces = (mesh.FaceCount() + stride - 1) / stride;
+
+	lines.clear();
+	previewFaceBegin.resize(nPreviewFaces + 1);
+
+	for (size_t p = 0; p < nPreviewFaces; p++) {
+		size_t f = p * stride;
+		previewFaceBegin[p] = lines.size();
+
+		int nFaceNodes = mesh.FaceNodeCount(f);
+		for (int k = 0; k < nFaceNodes; k++) {
+			NodeIndex a = mesh.FaceNode(f, k);
+			NodeIndex b = mesh.FaceNode(f, (k + 1) % nFaceNodes);
+			if (a != b) {
+				lines.push_back(makeLineInstance(
+					mesh.nodes[a], mesh.nodes[b], mesh.FaceEdgeType(f, k), color));
+			}
+		}
+	}
+	previewFaceBegin[nPreviewFaces] = lines.size();
+}
+
+///	<summary>
+///		A piece of the mesh passed from the loader thread to the render
+///		thread for upload.
+///	</summary>
+struct MeshChunk {
+	enum Type {
+		Type_Preview,
+		Type_Lines
+	};
+
+	Type type;
+
+	// Offset of the chunk in the full line buffer (instances)
+	size_t offset;
+
+	// Number of faces whose edges have been streamed through this chunk
+	size_t faceEnd;
+
+	// Size of the full line buffer (instances), set on Type_Lines chunks
+	size_t totalLines;
+
+	// Stride of the preview faces
+	size_t stride;
+
+	// Largest arc length of the lines in the chunk (radians)
+	float maxArc;
+
+	std::vector<LineInstance> lines;
+	std::vector<size_t> previewFaceBegin;
+};
+
+///	<summary>
+///		Bounded queue of MeshChunks.  The loader blocks while the queue is
+///		full so that at most a few chunks are held in memory, and stops
+///		once the queue is closed by the render thread.
+///	</summary>
+class MeshChunkQueue {
+
+public:
+	MeshChunkQueue() :
+		m_fClosed(false)
+	{ }
+
+	///	<summary>
+	///		Add a chunk, waiting for space.  Returns false if closed.
+	///	</summary>
+	bool push(MeshChunk && chunk) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cond.wait(lock, [this]() {
+			return m_fClosed || (m_queue.size() < MaxChunks);
+		});
+		if (m_fClosed) {
+			return false;
+		}
+		m_queue.push_back(std::move(chunk));
+		return true;
+	}
+
+	///	<summary>
+	///		Remove a chunk without waiting.  Returns false if empty.
+	///	</summary>
+	bool pop(MeshChunk & chunk) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_queue.empty()) {
+			return false;
+		}
+		chunk = std::move(m_queue.front());
+		m_queue.pop_front();
+		m_cond.notify_all();
+		return true;
+	}
+
+	///	<summary>
+	///		Check if there are no chunks waiting.
+	///	</summary>
+	bool empty() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_queue.empty();
+	}
+
+	///	<summary>
+	///		Flag set once the queue is closed, for the loader to check
+	///		during long reads.
+	///	</summary>
+	const std::atomic<bool> * closedFlag() const {
+		return &m_fClosed;
+	}
+
+	///	<summary>
+	///		Stop accepting chunks and release a waiting loader.
+	///	</summary>
+	void close() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_fClosed = true;
+		m_queue.clear();
+		m_cond.notify_all();
+	}
+
+protected:
+	static const size_t MaxChunks = 4;
+
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::deque<MeshChunk> m_queue;
+	std::atomic<bool> m_fClosed;
+};
+
+///	<summary>
+///		Read a mesh and stream it to the render thread: a preview of at
+///		most nFaceBudget faces (if the mesh is larger), then the edges of
+///		all faces in chunks.  The preview is read directly from the file
+///		where the format allows, so that it is shown before the full mesh
+///		has been read.  Reading stops early once the queue is closed.
+///	</summary>
+void streamMesh(
+	const std::string & strMesh,
+	size_t nFaceBudget,
+	const unsigned char color[4],
+	MeshChunkQueue & queue
 ) {
-	Mesh mesh(filename);
+	const size_t FacesPerChunk = 1 << 19;
+
+	MeshChunk chunk;
+	chunk.offset = 0;
+	chunk.faceEnd = 0;
+	chunk.totalLines = 0;
+	chunk.stride = 1;
+
+	// Preview from a partial read of every stride-th face
+	bool fPreviewSent = false;
+	{
+		MeshF meshPreview;
+		if (meshPreview.ReadPreview(strMesh, nFaceBudget, chunk.stride, queue.closedFlag())) {
+			chunk.type = MeshChunk::Type_Preview;
+			getMeshPreview(meshPreview, 1, color, chunk.lines, chunk.previewFaceBegin);
+			chunk.maxArc = getMaxArcLength(chunk.lines, 0, chunk.lines.size());
+			if (!queue.push(std::move(chunk))) {
+				return;
+			}
+			fPreviewSent = true;
+		}
+	}
 
-	vertices.resize(5 * mesh.nodes.size());
-	indices.resize(4 * mesh.faces.size());
+	MeshF mesh;
+	if (!mesh.Read(strMesh, Mesh::CoincidentNodePolicy_Default, queue.closedFlag())) {
+		return;
+	}
 
-	for (size_t v = 0; v < mesh.nodes.size(); v++) {
-		vertices[5*v+0] = static_cast<float>(mesh.nodes[v].x);
-		vertices[5*v+1] = static_cast<float>(mesh.nodes[v].z);
-		vertices[5*v+2] = static_cast<float>(mesh.nodes[v].y);
-		vertices[5*v+3] = 0.0f;
-		vertices[5*v+4] = 0.0f;
+	const size_t nFaces = mesh.FaceCount();
+
+	// Formats that can only be read in full get their preview now, still
+	// ahead of the edge ownership pass
+	if (!fPreviewSent && (nFaces > nFaceBudget)) {
+		chunk.type = MeshChunk::Type_Preview;
+		chunk.stride = (nFaces + nFaceBudget - 1) / nFaceBudget;
+		getMeshPreview(mesh, chunk.stride, color, chunk.lines, chunk.previewFaceBegin);
+		chunk.maxArc = getMaxArcLength(chunk.lines, 0, chunk.lines.size());
+		if (!queue.push(std::move(chunk))) {
+			return;
+		}
 	}
 
-	for (size_t f = 0; f < mesh.faces.size(); f++) {
-		indices[4*f+0] = static_cast<unsigned int>(mesh.faces[f][0]);
-		indices[4*f+1] = static_cast<unsigned int>(mesh.faces[f][1]);
-		indices[4*f+2] = static_cast<unsigned int>(mesh.faces[f][2]);
-		indices[4*f+3] = static_cast<unsigned int>(mesh.faces[f][3]);
+	std::vector<char> owner;
+	const size_t nTotalLines = getMeshEdgeOwners(mesh, owner);
+
+	size_t offset = 0;
+	for (size_t f = 0; f < nFaces; f += FacesPerChunk) {
+		chunk.type = MeshChunk::Type_Lines;
+		chunk.offset = offset;
+		chunk.faceEnd = std::min(f + FacesPerChunk, nFaces);
+		chunk.totalLines = nTotalLines;
+		chunk.previewFaceBegin.clear();
+		getMeshLines(mesh, owner, f, chunk.faceEnd, color, chunk.lines);
+		chunk.maxArc = getMaxArcLength(chunk.lines, 0, chunk.lines.size());
+		offset += chunk.lines.size();
+		if (!queue.push(std::move(chunk))) {
+			return;
+		}
 	}
 }
 
 ///	<summary>
-///		Load the texture from a file.
+///		Decoded texture image.
+///	</summary>
+struct TextureImage {
+	int width;
+	int height;
+	std::vector<unsigned char> pixels;
+};
+
+///	<summary>
+///		Decode the texture from a file (safe to call off the GL thread).
 ///	</summary>
-GLuint loadTexture(const char* filename) {
-	int width, height, channels;
-	unsigned char* image = stbi_load(filename, &width, &height, &channels, STBI_rgb);
+bool decodeTexture(const char* filename, TextureImage & tex) {
+	int channels;
+	unsigned char* image = stbi_load(filename, &tex.width, &tex.height, &channels, STBI_rgb);
 
 	if (!image) {
 		std::cerr << "Failed to load image: " << filename << std::endl;
-		return 0;
+		return false;
 	}
 
+	tex.pixels.assign(image, image + 3 * (size_t)tex.width * (size_t)tex.height);
+
+	stbi_image_free(image);
+	return true;
+}
+
+///	<summary>
+///		Upload a decoded texture to the GPU (GL thread only).
+///	</summary>
+GLuint uploadTexture(const TextureImage & tex) {
 	GLuint textureID;
 	glGenTextures(1, &textureID);
 	glBindTexture(GL_TEXTURE_2D, textureID);
-	
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, tex.width, tex.height, 0, GL_RGB, GL_UNSIGNED_BYTE, tex.pixels.data());
 	glGenerateMipmap(GL_TEXTURE_2D);
 
 	// Texture parameters
@@ -119,10 +521,18 @@ GLuint loadTexture(const char* filename) {
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);	
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	stbi_image_free(image);
 	return textureID;
 }
 
+///	<summary>
+///		Check if an asynchronous result is ready without blocking.
+///	</summary>
+template<typename T>
+bool isReady(const std::future<T> & fut) {
+	return fut.valid() &&
+		(fut.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+}
+
 ///	<summary>
 ///		Vertex shader.
 ///	</summary>
@@ -147,13 +557,109 @@ const char* fragmentShaderSrc = R"(
 #version 120
 varying vec2 TexCoord;
 uniform sampler2D texture1;
-uniform bool useTexture;
-uniform vec4 lineColor;
 void main() {
-	if (useTexture)
-		gl_FragColor = texture2D(texture1, TexCoord);
-	else
-		gl_FragColor = lineColor;
+	gl_FragColor = texture2D(texture1, TexCoord);
+}
+)";
+
+///	<summary>
+///		Line vertex shader.  Each instance is one edge, drawn as a strip
+///		of segments along its true path (a great circle arc, or a line of
+///		constant latitude if aType is 1) and expanded in screen space to
+///		the line width plus a one pixel margin for anti-aliasing.  aCorner
+///		gives the vertex index along the strip and the side (-1 or 1) of
+///		the edge.  All edges share one instanced draw whose strip has
+///		segmentCount segments, enough for the longest arc; each edge uses
+///		only as many as keep them within segmentAngle, and its remaining
+///		vertices collapse onto its end point as zero-area triangles.
+///	</summary>
+const char* lineVertexShaderSrc = R"(
+#version 120
+attribute vec2 aCorner;
+attribute vec3 aStart;
+attribute vec3 aEnd;
+attribute vec4 aColor;
+attribute float aType;
+varying vec4 Color;
+varying float Distance;
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec2 viewport;
+uniform float lineWidth;
+uniform float segmentAngle;
+uniform float segmentCount;
+
+float dLon;
+
+vec3 arcPoint(float t) {
+	if (aType > 0.5) {
+		float c = cos(t * dLon);
+		float s = sin(t * dLon);
+		return vec3(c * aStart.x - s * aStart.z, aStart.y, s * aStart.x + c * aStart.z);
+	}
+	return normalize(mix(aStart, aEnd, t));
+}
+
+vec2 toScreen(vec4 clip) {
+	return 0.5 * viewport * clip.xy / clip.w;
+}
+
+void main() {
+	mat4 mvp = projection * view * model;
+
+	float arc;
+	if (aType > 0.5) {
+		dLon = atan(aStart.x * aEnd.z - aStart.z * aEnd.x, aStart.x * aEnd.x + aStart.z * aEnd.z);
+		arc = abs(dLon) * length(aStart.xz);
+	} else {
+		dLon = 0.0;
+		arc = 2.0 * asin(clamp(0.5 * length(aEnd - aStart), 0.0, 1.0));
+	}
+
+	float n = clamp(ceil(arc / segmentAngle), 1.0, segmentCount);
+	float t = min(aCorner.x, n) / n;
+
+	vec4 clip = mvp * vec4(arcPoint(t), 1.0);
+	vec2 screenPrev = toScreen(mvp * vec4(arcPoint(max(t - 1.0 / n, 0.0)), 1.0));
+	vec2 screenNext = toScreen(mvp * vec4(arcPoint(min(t + 1.0 / n, 1.0)), 1.0));
+
+	vec2 dir = screenNext - screenPrev;
+	float len = length(dir);
+	dir = (len > 1.0e-6) ? (dir / len) : vec2(1.0, 0.0);
+	vec2 normal = vec2(-dir.y, dir.x);
+
+	float halfWidth = 0.5 * max(lineWidth, 1.0) + 1.0;
+	vec2 offset = halfWidth * aCorner.y * normal;
+	if (t == 0.0) {
+		offset -= halfWidth * dir;
+	} else if (t == 1.0) {
+		offset += halfWidth * dir;
+	}
+
+	clip.xy += offset * 2.0 / viewport * clip.w;
+	gl_Position = clip;
+
+	Color = aColor;
+	Distance = aCorner.y * halfWidth;
+}
+)";
+
+///	<summary>
+///		Line fragment shader.  Coverage falls off linearly over one pixel
+///		at the edges of the line; lines thinner than one pixel are drawn
+///		one pixel wide with reduced opacity.
+///	</summary>
+const char* lineFragmentShaderSrc = R"(
+#version 120
+varying vec4 Color;
+varying float Distance;
+uniform float lineWidth;
+void main() {
+	float halfWidth = 0.5 * max(lineWidth, 1.0);
+	float coverage = clamp(halfWidth + 0.5 - abs(Distance), 0.0, 1.0);
+	coverage *= min(lineWidth, 1.0);
+	gl_FragColor = vec4(Color.rgb, Color.a * coverage);
 }
 )";
 
@@ -182,6 +688,89 @@ GLuint createShaderProgram() {
 	return program;
 }
 
+///	<summary>
+///		Create the line shader program.
+///	</summary>
+GLuint createLineShaderProgram() {
+	GLuint vertexShader = compileShader(GL_VERTEX_SHADER, lineVertexShaderSrc);
+	GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, lineFragmentShaderSrc);
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glBindAttribLocation(program, 0, "aCorner");
+	glBindAttribLocation(program, 1, "aStart");
+	glBindAttribLocation(program, 2, "aEnd");
+	glBindAttribLocation(program, 3, "aColor");
+	glBindAttribLocation(program, 4, "aType");
+	glLinkProgram(program);
+	return program;
+}
+
+///	<summary>
+///		Get the buffer of strip corners for lines of nSegments segments,
+///		creating it on first use.  Buffers are cached per level of detail.
+///	</summary>
+GLuint getLineCornerBuffer(
+	std::map<int, GLuint> & mapCornerBuffers,
+	int nSegments
+) {
+	std::map<int, GLuint>::iterator iter = mapCornerBuffers.find(nSegments);
+	if (iter != mapCornerBuffers.end()) {
+		return iter->second;
+	}
+
+	std::vector<float> corners(4 * (nSegments + 1));
+	for (int i = 0; i <= nSegments; i++) {
+		corners[4*i+0] = (float)i;
+		corners[4*i+1] = -1.0f;
+		corners[4*i+2] = (float)i;
+		corners[4*i+3] = 1.0f;
+	}
+
+	GLuint vboCorner;
+	glGenBuffers(1, &vboCorner);
+	glBindBuffer(GL_ARRAY_BUFFER, vboCorner);
+	glBufferData(GL_ARRAY_BUFFER, corners.size() * sizeof(float), corners.data(), GL_STATIC_DRAW);
+
+	mapCornerBuffers[nSegments] = vboCorner;
+	return vboCorner;
+}
+
+///	<summary>
+///		Draw lines [begin, end) of an instance buffer, each as a strip of
+///		nSegments segments, with the line shader in a single instanced
+///		draw call.
+///	</summary>
+void drawLines(
+	GLuint vboCorner,
+	int nSegments,
+	GLuint vboLines,
+	size_t begin,
+	size_t end
+) {
+	glBindBuffer(GL_ARRAY_BUFFER, vboCorner);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0); // Corner
+	glVertexAttribDivisor(0, 0);
+
+	const size_t base = begin * sizeof(LineInstance);
+	glBindBuffer(GL_ARRAY_BUFFER, vboLines);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(LineInstance), (void*)(base + offsetof(LineInstance, start)));
+	glEnableVertexAttribArray(1); // Start
+	glVertexAttribDivisor(1, 1);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(LineInstance), (void*)(base + offsetof(LineInstance, end)));
+	glEnableVertexAttribArray(2); // End
+	glVertexAttribDivisor(2, 1);
+	glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(LineInstance), (void*)(base + offsetof(LineInstance, color)));
+	glEnableVertexAttribArray(3); // Color
+	glVertexAttribDivisor(3, 1);
+	glVertexAttribPointer(4, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(LineInstance), (void*)(base + offsetof(LineInstance, type)));
+	glEnableVertexAttribArray(4); // Type
+	glVertexAttribDivisor(4, 1);
+
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 2 * (nSegments + 1), static_cast<GLsizei>(end - begin));
+}
+
 ///	<summary>
 ///		Camera rotation handling.
 ///	</summary>
@@ -195,6 +784,7 @@ void cursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
 		float deltaY = (float)(ypos - lastY);
 		angleX += deltaY * 0.02f / sqrt(zoomLevel);
 		angleY += deltaX * 0.02f / sqrt(zoomLevel);
+		viewDirty = true;
 	}
 	lastX = xpos;
 	lastY = ypos;
@@ -209,6 +799,7 @@ void mouseScrollCallback(GLFWwindow* window, double xpos, double ypos) {
 	} else { 
 		zoomLevel /= (1.0 + atan(-ypos) * 2.0 / M_PI);
 	}
+	viewDirty = true;
 }
 
 ///	<summary>
@@ -224,6 +815,7 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
 
 			if (elapsed.count() < DOUBLE_CLICK_THRESHOLD) {
 				zoomLevel *= 1.0 + ZOOM_STEP;
+				viewDirty = true;
 			}
 
 			lastClickTime = now;
@@ -241,6 +833,7 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
 
 			if (elapsed.count() < DOUBLE_CLICK_THRESHOLD) {
 				zoomLevel /= 1.0 + ZOOM_STEP;
+				viewDirty = true;
 			}
 
 			lastClickTime = now;
@@ -251,6 +844,47 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
 	}
 }
 
+///	<summary>
+///		Redraw when the window contents are damaged or resized.
+///	</summary>
+void windowRefreshCallback(GLFWwindow* window) {
+	viewDirty = true;
+}
+
+///	<summary>
+///		Print header metadata for each mesh file without loading it.
+///	</summary>
+int probeMeshes(
+	const std::vector<std::string> & vecMeshFiles
+) {
+	int iResult = 0;
+	for (size_t f = 0; f < vecMeshFiles.size(); f++) {
+		try {
+			MeshFileInfo info = Mesh::Probe(vecMeshFiles[f]);
+
+			printf("%s: format %s, nodes %li, faces %li, max nodes/face %li, blocks %lu",
+				vecMeshFiles[f].c_str(),
+				MeshFileInfo::FormatName(info.eFormat),
+				info.lNodeCount,
+				info.lFaceCount,
+				info.lMaxNodesPerFace,
+				info.vecBlockFaceCount.size());
+
+			if (info.fHasCoordinateRange) {
+				printf(", lon [%g, %g], lat [%g, %g]",
+					info.dLonRange[0], info.dLonRange[1],
+					info.dLatRange[0], info.dLatRange[1]);
+			}
+			printf("\n");
+
+		} catch(Exception & e) {
+			printf("%s: ERROR %s\n", vecMeshFiles[f].c_str(), e.ToString().c_str());
+			iResult = -1;
+		}
+	}
+	return iResult;
+}
+
 ///	<summary>
 ///		Entry point to executable.
 ///	</summary>
@@ -264,12 +898,22 @@ int main(int argc, char** argv) {
 	float dLineWidth = 1.0f;
 	float dLineColor[4] = {1.0f, 1.0f, 1.0f, 1.0f};
 
+	bool fProbe = false;
+	bool fContinuous = false;
+	std::vector<std::string> vecMeshFiles;
+
 	bool fPrintUsage = false;
 	if (argc < 2) {
 		fPrintUsage = true;
 	} else {
 		for (int c = 1; c < argc; c++) {
-			if (argv[c][0] == '-') {
+			if (strcmp(argv[c],"-probe") == 0) {
+				fProbe = true;
+
+			} else if (strcmp(argv[c],"-continuous") == 0) {
+				fContinuous = true;
+
+			} else if (argv[c][0] == '-') {
 				if (c == argc-1) {
 					printf("ERROR: Missing parameter for argument %s\n", argv[c]);
 					fPrintUsage = true;
@@ -285,14 +929,19 @@ int main(int argc, char** argv) {
 				c++;
 
 			} else {
-				if (c != argc-1) {
-					fPrintUsage = true;
-					break;
-				}
-				strMesh = argv[c];
+				vecMeshFiles.push_back(argv[c]);
 			}
 		}
 	}
+	if (fProbe) {
+		if (vecMeshFiles.size() == 0) {
+			fPrintUsage = true;
+		}
+	} else if (vecMeshFiles.size() != 1) {
+		fPrintUsage = true;
+	} else {
+		strMesh = vecMeshFiles[0];
+	}
 	if (strLineWidth.length() == 0) {
 	} else if (!STLStringHelper::IsFloat(strLineWidth)) {
 		printf("ERROR: -lw must be of type float\n");
@@ -338,13 +987,55 @@ int main(int argc, char** argv) {
 	}
 
 	if (fPrintUsage) {
-		printf("meshrender [-b img] [-lc lcol] [-lw lwidth] <mesh file>\n");
+		printf("meshrender [-b img] [-lc lcol] [-lw lwidth] [-continuous] <mesh file>\n");
+		printf("meshrender -probe <mesh file> [<mesh file> ...]\n");
 		printf("  [-b img]           Globe image file\n");
 		printf("  [-lc lcol]         Line color spec (name or R,G,B[,A])\n");
-		printf("  [-lw lwidth]       Line width (default 1.0)\n");
+		printf("  [-lw lwidth]       Line width in pixels (default 1.0)\n");
+		printf("  [-continuous]      Redraw continuously instead of on input\n");
+		printf("  [-probe]           Print mesh file metadata and exit\n");
 		return (-1);
 	}
 
+	// Print metadata only
+	if (fProbe) {
+		return probeMeshes(vecMeshFiles);
+	}
+
+	// Decode the texture and load the mesh on worker threads while the
+	// window, shaders and sphere are set up; results are uploaded to the
+	// GPU on this thread as they arrive
+	TextureImage textureImage;
+	std::future<bool> futTexture =
+		std::async(std::launch::async, [&]() {
+			return decodeTexture(strTexture.c_str(), textureImage);
+		});
+
+	// Line color of every edge
+	unsigned char lineColor[4];
+	for (int c = 0; c < 4; c++) {
+		lineColor[c] = static_cast<unsigned char>(dLineColor[c] * 255.0f + 0.5f);
+	}
+
+	MeshChunkQueue queueMesh;
+	std::future<void> futMesh =
+		std::async(std::launch::async, [&]() {
+			streamMesh(strMesh, INTERACTIVE_FACE_BUDGET, lineColor, queueMesh);
+		});
+
+	// Release the loader on any return before futMesh waits for it
+	struct MeshQueueCloser {
+		MeshChunkQueue & queue;
+		~MeshQueueCloser() { queue.close(); }
+	} closeMeshQueue = { queueMesh };
+
+	std::vector<float> verticesSphere;
+	std::vector<unsigned int> indicesSphere;
+	std::future<void> futSphere =
+		std::async(std::launch::async, [&]() {
+			createSphere(verticesSphere, indicesSphere, 40, 40);
+		});
+
 	// Initialize window
 	if (!glfwInit()) return -1;
 	GLFWwindow* window = glfwCreateWindow(800, 800, "meshrender", NULL, NULL);
@@ -357,129 +1048,287 @@ int main(int argc, char** argv) {
 	if (glewInit() != GLEW_OK) return -1;
 
 	// Generate vertex arrays and buffers
-	GLuint vao[2], vbo[2], ebo[2];
+	GLuint vao[2], vbo[2], ebo;
 	glGenVertexArrays(2, vao);
 	glGenBuffers(2, vbo);
-	glGenBuffers(2, ebo);
+	glGenBuffers(1, &ebo);
 
-	// Generate the sphere and corresponding buffers
-	std::vector<float> verticesSphere;
-	std::vector<unsigned int> indicesSphere;
-	createSphere(verticesSphere, indicesSphere, 40, 40);
+	GLuint vboPreview;
+	glGenBuffers(1, &vboPreview);
+
+	// Line strip corners for each level of detail
+	std::map<int, GLuint> mapCornerBuffers;
+
+	// Upload the sphere
+	futSphere.get();
 
 	glBindBuffer(GL_ARRAY_BUFFER, vbo[0]);
 	glBufferData(GL_ARRAY_BUFFER, verticesSphere.size() * sizeof(float), verticesSphere.data(), GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo[0]);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSphere.size() * sizeof(unsigned int), indicesSphere.data(), GL_STATIC_DRAW);
 
-	GLuint texture = loadTexture(strTexture.c_str());
-
-	// Generate the mesh and corresponding buffers
-	std::vector<float> verticesMesh;
-	std::vector<unsigned int> indicesMesh;
-	getMesh(strMesh, verticesMesh, indicesMesh);
-
-	glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
-	glBufferData(GL_ARRAY_BUFFER, verticesMesh.size() * sizeof(float), verticesMesh.data(), GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo[1]);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesMesh.size() * sizeof(unsigned int), indicesMesh.data(), GL_STATIC_DRAW);
-
-	// Initialize the shader and load the texture
+	// Texture and mesh are uploaded from the render loop once ready
+	GLuint texture = 0;
+	bool fMeshAllocated = false;
+	size_t sMeshTotalLines = 0;
+	size_t sMeshLineCount = 0;
+	size_t sMeshFaceCount = 0;
+	size_t sMeshPreviewStride = 1;
+	std::vector<size_t> vecMeshPreviewFaceBegin;
+	float dMeshMaxArc = 0.0f;
+
+	// Initialize the shaders
 	GLuint shaderProgram = createShaderProgram();
+	GLuint lineShaderProgram = createLineShaderProgram();
 
 	glEnable(GL_DEPTH_TEST);
 
 	// Mesh drawing settings
-	glLineWidth(dLineWidth);
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glEnable(GL_LINE_SMOOTH);
-	glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
 
 	glfwSetCursorPosCallback(window, cursorPosCallback);
 	glfwSetMouseButtonCallback(window, mouseButtonCallback);
 	glfwSetScrollCallback(window, mouseScrollCallback);
+	glfwSetWindowRefreshCallback(window, windowRefreshCallback);
 
-	glUseProgram(shaderProgram);
-
-	// Set line color
-	GLuint lineColorLoc = glGetUniformLocation(shaderProgram, "lineColor");
-	//glUniform4fv(lineColorLoc, 4, dLineColor);
-	glUniform4f(lineColorLoc, dLineColor[0], dLineColor[1], dLineColor[2], dLineColor[3]);
+	// Time of the last view change and whether full detail has been
+	// drawn since
+	auto lastChangeTime = std::chrono::steady_clock::now();
+	bool fRefined = false;
 
 	while (!glfwWindowShouldClose(window)) {
-		glClearColor(0.1f, 0.1f, 0.2f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// Rotation matrix based on user input
-		float identity[16] = {
-			1.0f, 0.0f, 0.0f, 0.0f,
-			0.0f, 1.0f, 0.0f, 0.0f,
-			0.0f, 0.0f, 1.0f, 0.0f,
-			0.0f, 0.0f, 0.0f, 1.0f
-		};
-
-		float zoommatrix[16] = {
-			zoomLevel, 0.0f, 0.0f, 0.0f,
-			0.0f, zoomLevel, 0.0f, 0.0f,
-			0.0f, 0.0f, 0.5f, 0.0f,
-			0.0f, 0.0f, 0.0f, 1.0f
-		};
-
-		float model[16] = {
-			cos(angleY), sin(angleY) * sin(angleX), sin(angleY) * cos(angleX), 0.0f,
-			0.0f, cos(angleX), -sin(angleX), 0.0f,
-			-sin(angleY), cos(angleY) * sin(angleX), cos(angleY) * cos(angleX), 0.0f,
-			0.0f, 0.0f, 0.0f, 1.0f
-		};
-
-		GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
-		GLint viewLoc = glGetUniformLocation(shaderProgram, "view");
-		GLint projLoc = glGetUniformLocation(shaderProgram, "projection");
-
-		glUniformMatrix4fv(modelLoc, 1, GL_FALSE, model);
-		glUniformMatrix4fv(viewLoc, 1, GL_FALSE, zoommatrix); // Identity view (no camera movement)
-		glUniformMatrix4fv(projLoc, 1, GL_FALSE, identity); // Identity projection (no perspective)
-
-		// Texture flag
-		GLuint useTextureLoc = glGetUniformLocation(shaderProgram, "useTexture");
-
-		// Create the globe
-		glUniform1i(useTextureLoc, GL_TRUE);
-		glBindVertexArray(vao[0]);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo[0]);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo[0]);
-		glBindTexture(GL_TEXTURE_2D, texture);
-
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-		glEnableVertexAttribArray(0); // Position
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-		glEnableVertexAttribArray(1); // TexCoord
-
-		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-		glDrawElements(GL_TRIANGLES, indicesSphere.size(), GL_UNSIGNED_INT, 0);
-
-		// Draw the mesh
-		glUniform1i(useTextureLoc, GL_FALSE);
-		glBindVertexArray(vao[1]);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo[1]);
-
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-		glEnableVertexAttribArray(0); // Position
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-		glEnableVertexAttribArray(1); // TexCoord
-
-		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		glDrawElements(GL_QUADS, indicesMesh.size(), GL_UNSIGNED_INT, 0);
-
-		glfwSwapBuffers(window);
-		glfwPollEvents();
+		// Upload results from the worker threads as they arrive
+		if (isReady(futTexture)) {
+			if (futTexture.get()) {
+				texture = uploadTexture(textureImage);
+			}
+			std::vector<unsigned char>().swap(textureImage.pixels);
+			viewDirty = true;
+		}
+		// Upload mesh chunks, for at most a few milliseconds per iteration
+		bool fMeshPreviewArrived = false;
+		bool fMeshChunkArrived = false;
+
+		MeshChunk chunk;
+		auto uploadStart = std::chrono::steady_clock::now();
+		while (queueMesh.pop(chunk)) {
+			if (!fMeshAllocated && (chunk.type == MeshChunk::Type_Lines)) {
+				sMeshTotalLines = chunk.totalLines;
+
+				glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
+				glBufferData(GL_ARRAY_BUFFER, sMeshTotalLines * sizeof(LineInstance), NULL, GL_STATIC_DRAW);
+
+				fMeshAllocated = true;
+			}
+
+			if (chunk.type == MeshChunk::Type_Preview) {
+				glBindBuffer(GL_ARRAY_BUFFER, vboPreview);
+				glBufferData(GL_ARRAY_BUFFER, chunk.lines.size() * sizeof(LineInstance), chunk.lines.data(), GL_STATIC_DRAW);
+
+				sMeshPreviewStride = chunk.stride;
+				vecMeshPreviewFaceBegin.swap(chunk.previewFaceBegin);
+				dMeshMaxArc = std::max(dMeshMaxArc, chunk.maxArc);
+				fMeshPreviewArrived = true;
+
+			} else {
+				glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
+				glBufferSubData(GL_ARRAY_BUFFER, chunk.offset * sizeof(LineInstance), chunk.lines.size() * sizeof(LineInstance), chunk.lines.data());
+
+				sMeshLineCount = chunk.offset + chunk.lines.size();
+				sMeshFaceCount = chunk.faceEnd;
+				dMeshMaxArc = std::max(dMeshMaxArc, chunk.maxArc);
+				fMeshChunkArrived = true;
+			}
+
+			std::chrono::duration<double> elapsed =
+				std::chrono::steady_clock::now() - uploadStart;
+			if (elapsed.count() > MAX_UPLOAD_TIME) {
+				break;
+			}
+		}
+		if (isReady(futMesh)) {
+			futMesh.get();
+		}
+
+		// The preview is shown at once; streamed chunks are shown when the
+		// view is next refined
+		if (fMeshPreviewArrived) {
+			viewDirty = true;
+		}
+		if (fMeshChunkArrived && fRefined) {
+			fRefined = false;
+			lastChangeTime = std::chrono::steady_clock::now();
+		}
+		bool fMeshCompleted = fMeshChunkArrived && (sMeshLineCount == sMeshTotalLines);
+
+		// Decide whether to draw, and at what level of detail
+		bool fDraw = true;
+		bool fFullDetail = true;
+		if (!fContinuous) {
+			auto now = std::chrono::steady_clock::now();
+			if (viewDirty) {
+				viewDirty = false;
+				lastChangeTime = now;
+				fFullDetail = vecMeshPreviewFaceBegin.empty();
+				fRefined = fFullDetail;
+
+			} else if (!fRefined) {
+				std::chrono::duration<double> idle = now - lastChangeTime;
+				fDraw = (idle.count() >= REFINE_DELAY) || fMeshCompleted;
+				fRefined = fDraw;
+
+			} else {
+				fDraw = false;
+			}
+		}
+
+		if (fDraw) {
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+			glViewport(0, 0, width, height);
+
+			glClearColor(0.1f, 0.1f, 0.2f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			// Rotation matrix based on user input
+			float identity[16] = {
+				1.0f, 0.0f, 0.0f, 0.0f,
+				0.0f, 1.0f, 0.0f, 0.0f,
+				0.0f, 0.0f, 1.0f, 0.0f,
+				0.0f, 0.0f, 0.0f, 1.0f
+			};
+
+			float zoommatrix[16] = {
+				zoomLevel, 0.0f, 0.0f, 0.0f,
+				0.0f, zoomLevel, 0.0f, 0.0f,
+				0.0f, 0.0f, 0.5f, 0.0f,
+				0.0f, 0.0f, 0.0f, 1.0f
+			};
+
+			float model[16] = {
+				cos(angleY), sin(angleY) * sin(angleX), sin(angleY) * cos(angleX), 0.0f,
+				0.0f, cos(angleX), -sin(angleX), 0.0f,
+				-sin(angleY), cos(angleY) * sin(angleX), cos(angleY) * cos(angleX), 0.0f,
+				0.0f, 0.0f, 0.0f, 1.0f
+			};
+
+			glUseProgram(shaderProgram);
+
+			GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
+			GLint viewLoc = glGetUniformLocation(shaderProgram, "view");
+			GLint projLoc = glGetUniformLocation(shaderProgram, "projection");
+
+			glUniformMatrix4fv(modelLoc, 1, GL_FALSE, model);
+			glUniformMatrix4fv(viewLoc, 1, GL_FALSE, zoommatrix); // Identity view (no camera movement)
+			glUniformMatrix4fv(projLoc, 1, GL_FALSE, identity); // Identity projection (no perspective)
+
+			// Create the globe
+			glBindVertexArray(vao[0]);
+			glBindBuffer(GL_ARRAY_BUFFER, vbo[0]);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+			glBindTexture(GL_TEXTURE_2D, texture);
+
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+			glEnableVertexAttribArray(0); // Position
+			glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+			glEnableVertexAttribArray(1); // TexCoord
+
+			glDrawElements(GL_TRIANGLES, indicesSphere.size(), GL_UNSIGNED_INT, 0);
+
+			// Draw the mesh: the full mesh for faces that have been streamed
+			// and the preview for the rest, or only the preview during
+			// interaction
+			const size_t sPreviewFaces = (vecMeshPreviewFaceBegin.empty()) ? 0 : (vecMeshPreviewFaceBegin.size() - 1);
+			const size_t sPreviewLines = (vecMeshPreviewFaceBegin.empty()) ? 0 : vecMeshPreviewFaceBegin.back();
+
+			bool fPreviewOnly = !fFullDetail && (sPreviewLines != 0);
+
+			size_t sFullLineCount = 0;
+			size_t sPreviewLineBegin = 0;
+			if (!fPreviewOnly) {
+				sFullLineCount = sMeshLineCount;
+				if (sPreviewFaces != 0) {
+					size_t sPreviewFaceBegin = std::min(sPreviewFaces,
+						(sMeshFaceCount + sMeshPreviewStride - 1) / sMeshPreviewStride);
+					sPreviewLineBegin = vecMeshPreviewFaceBegin[sPreviewFaceBegin];
+				}
+			}
+
+			// Level of detail from the radius of the globe in pixels,
+			// rounded up to a power of two
+			const double dPixelRadius = 0.5 * zoomLevel * std::max(width, height);
+			const int nLevel = std::max(0, (int)ceil(log2(std::max(dPixelRadius, 1.0))));
+			const double dSegmentAngle = std::min(MAX_SEGMENT_ANGLE,
+				sqrt(8.0 * SAG_TOLERANCE / ldexp(1.0, nLevel)));
+			const int nSegments = std::max(1, std::min(MAX_SEGMENTS,
+				(int)ceil(dMeshMaxArc / dSegmentAngle)));
+
+			GLuint vboCorner = getLineCornerBuffer(mapCornerBuffers, nSegments);
+
+			glUseProgram(lineShaderProgram);
+
+			modelLoc = glGetUniformLocation(lineShaderProgram, "model");
+			viewLoc = glGetUniformLocation(lineShaderProgram, "view");
+			projLoc = glGetUniformLocation(lineShaderProgram, "projection");
+			GLint viewportLoc = glGetUniformLocation(lineShaderProgram, "viewport");
+			GLint lineWidthLoc = glGetUniformLocation(lineShaderProgram, "lineWidth");
+			GLint segmentAngleLoc = glGetUniformLocation(lineShaderProgram, "segmentAngle");
+			GLint segmentCountLoc = glGetUniformLocation(lineShaderProgram, "segmentCount");
+
+			glUniformMatrix4fv(modelLoc, 1, GL_FALSE, model);
+			glUniformMatrix4fv(viewLoc, 1, GL_FALSE, zoommatrix);
+			glUniformMatrix4fv(projLoc, 1, GL_FALSE, identity);
+			glUniform2f(viewportLoc, (float)width, (float)height);
+			glUniform1f(lineWidthLoc, dLineWidth);
+			glUniform1f(segmentAngleLoc, (float)dSegmentAngle);
+			glUniform1f(segmentCountLoc, (float)nSegments);
+
+			// Lines are blended over the globe without writing depth, so
+			// that overlapping anti-aliased edges do not clip each other
+			glBindVertexArray(vao[1]);
+			glDepthMask(GL_FALSE);
+
+			if (sFullLineCount != 0) {
+				drawLines(vboCorner, nSegments, vbo[1], 0, sFullLineCount);
+			}
+			if (sPreviewLineBegin < sPreviewLines) {
+				drawLines(vboCorner, nSegments, vboPreview, sPreviewLineBegin, sPreviewLines);
+			}
+
+			glDepthMask(GL_TRUE);
+
+			glfwSwapBuffers(window);
+		}
+
+		// Wait for input, polling while results are outstanding and
+		// waking up to refine the view once it is idle
+		if (fContinuous) {
+			glfwPollEvents();
+
+		} else if (!queueMesh.empty()) {
+			glfwPollEvents();
+
+		} else if (futTexture.valid() || futMesh.valid()) {
+			glfwWaitEventsTimeout(0.02);
+
+		} else if (!fRefined && !viewDirty) {
+			std::chrono::duration<double> idle =
+				std::chrono::steady_clock::now() - lastChangeTime;
+			glfwWaitEventsTimeout(std::max(0.0, REFINE_DELAY - idle.count()));
+
+		} else if (!viewDirty) {
+			glfwWaitEvents();
+		}
 	}
 
 	glDeleteVertexArrays(2, vao);
 	glDeleteBuffers(2, vbo);
-	glDeleteBuffers(2, ebo);
+	glDeleteBuffers(1, &ebo);
+	glDeleteBuffers(1, &vboPreview);
+	for (auto iter = mapCornerBuffers.begin(); iter != mapCornerBuffers.end(); iter++) {
+		glDeleteBuffers(1, &(iter->second));
+	}
 
 	glfwTerminate();
 	return 0;